@@ -0,0 +1,612 @@
+/*******************************************************************************
+  Cycle-count Benchmark Source File
+
+  File Name:
+    benchmark.c
+
+  Summary:
+    Start-up micro benchmarks for the peripheral libraries and services.
+
+  Description:
+    See benchmark.h. Every case runs its body BENCHMARK_ITERATIONS times
+    between two SYS_TIME_Now samples. Bodies must stay below 2^32 cycles
+    (~89 s).
+ *******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "benchmark.h"
+
+#ifdef APP_BENCHMARK_ENABLE
+
+#include <stdio.h>
+#include <string.h>
+#include "definitions.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define BENCHMARK_ITERATIONS        (256U)
+
+#define BENCHMARK_NVM_WORDS         (64U)
+
+#define BENCHMARK_NVM_PASSES        (8U)
+
+#define BENCHMARK_RAMFUNC_CALLS     (16U)
+
+/* Characters per timed USART call: as many as DATA and the shift register
+ * (or the receive FIFO) hold, so the call never waits on the line */
+#define BENCHMARK_USART_BURST       (2U)
+
+#define BENCHMARK_USART_BURSTS      (32U)
+
+typedef void (*BENCHMARK_FUNCTION)( uint32_t count );
+
+/* A function compiled twice from one body: in flash and as RAMFUNC */
+typedef struct
+{
+    const char          *name;
+    BENCHMARK_FUNCTION  flash;
+    BENCHMARK_FUNCTION  ram;
+    uint32_t            count;
+} BENCHMARK_RAMFUNC_CASE;
+
+/* Cycles taken by an empty start/stop pair */
+static uint32_t benchmarkOverhead;
+
+/* Keeps the measured loads from being optimized away */
+static volatile uint32_t benchmarkSink;
+
+static uint8_t benchmarkData[BENCHMARK_ITERATIONS];
+
+#ifndef SERCOM0_USART_RING_BUFFER_ENABLE
+static uint8_t benchmarkRx[BENCHMARK_USART_BURST];
+#endif
+
+static uint32_t benchmarkWords[BENCHMARK_NVM_WORDS];
+
+static uint32_t benchmarkRingOut;
+
+static uint32_t benchmarkPageAddress;
+
+/* Flash region reserved by the linker script: read source and page buffer
+ * target */
+extern uint32_t __nvm_data_start[];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static inline uint32_t BENCHMARK_Start( void )
+{
+    return (uint32_t)SYS_TIME_Now();
+}
+
+/* The low word is enough for a case below 2^32 cycles */
+static inline uint32_t BENCHMARK_Stop( uint32_t start )
+{
+    return ((uint32_t)SYS_TIME_Now() - start);
+}
+
+static void BENCHMARK_Report( const char *name, uint32_t cycles, uint32_t iterations )
+{
+    cycles = (cycles > benchmarkOverhead) ? (cycles - benchmarkOverhead) : 0U;
+
+    printf("%-28s %8lu cycles %6lu.%02lu /iter\r\n", name, (unsigned long)cycles,
+           (unsigned long)(cycles / iterations), (unsigned long)(((cycles % iterations) * 100U) / iterations));
+}
+
+#ifndef SERCOM0_USART_RING_BUFFER_ENABLE
+typedef bool (*BENCHMARK_USART_FUNCTION)( void *buffer, const size_t size );
+
+/* SERCOM0_USART_Write before the loops were specialized per character size:
+ * CTRLB.CHSIZE is decoded for every character */
+static void BENCHMARK_UsartErrorClearDecode( void )
+{
+    uint8_t  u8dummyData = 0U;
+    USART_ERROR errorStatus = (USART_ERROR) (SERCOM0_REGS->USART_INT.SERCOM_STATUS & (uint16_t)(SERCOM_USART_INT_STATUS_PERR_Msk | SERCOM_USART_INT_STATUS_FERR_Msk | SERCOM_USART_INT_STATUS_BUFOVF_Msk ));
+
+    if(errorStatus != USART_ERROR_NONE)
+    {
+        SERCOM0_REGS->USART_INT.SERCOM_INTFLAG = (uint8_t)SERCOM_USART_INT_INTFLAG_ERROR_Msk;
+        SERCOM0_REGS->USART_INT.SERCOM_STATUS = (uint16_t)(SERCOM_USART_INT_STATUS_PERR_Msk | SERCOM_USART_INT_STATUS_FERR_Msk | SERCOM_USART_INT_STATUS_BUFOVF_Msk);
+
+        while((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & (uint8_t)SERCOM_USART_INT_INTFLAG_RXC_Msk) == (uint8_t)SERCOM_USART_INT_INTFLAG_RXC_Msk)
+        {
+            u8dummyData = (uint8_t)SERCOM0_REGS->USART_INT.SERCOM_DATA;
+        }
+    }
+
+    (void)u8dummyData;
+}
+
+static bool __attribute__((noinline)) BENCHMARK_UsartWriteDecode( void *buffer, const size_t size )
+{
+    bool writeStatus      = false;
+    uint8_t *pu8Data      = (uint8_t*)buffer;
+    uint16_t *pu16Data    = (uint16_t*)buffer;
+    uint32_t u32Index     = 0U;
+
+    if(buffer != NULL)
+    {
+        while(u32Index < size)
+        {
+            while((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & (uint8_t)SERCOM_USART_INT_INTFLAG_DRE_Msk) == 0U)
+            {
+                /* Do nothing */
+            }
+
+            if (((SERCOM0_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) != 0x01U)
+            {
+                SERCOM0_REGS->USART_INT.SERCOM_DATA = pu8Data[u32Index];
+            }
+            else
+            {
+                SERCOM0_REGS->USART_INT.SERCOM_DATA = pu16Data[u32Index];
+            }
+
+            u32Index++;
+        }
+        writeStatus = true;
+    }
+
+    return writeStatus;
+}
+
+/* SERCOM0_USART_Read before the loops were specialized */
+static bool __attribute__((noinline)) BENCHMARK_UsartReadDecode( void *buffer, const size_t size )
+{
+    bool readStatus         = false;
+    uint8_t* pu8Data        = (uint8_t*)buffer;
+    uint16_t *pu16Data      = (uint16_t*)buffer;
+    uint32_t u32Index       = 0U;
+    USART_ERROR errorStatus = USART_ERROR_NONE;
+
+    if(buffer != NULL)
+    {
+        BENCHMARK_UsartErrorClearDecode();
+
+        while(u32Index < size)
+        {
+            while((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_RXC_Msk) == 0U)
+            {
+                /* Do nothing */
+            }
+
+            errorStatus = (USART_ERROR) (SERCOM0_REGS->USART_INT.SERCOM_STATUS & (uint16_t)(SERCOM_USART_INT_STATUS_PERR_Msk | SERCOM_USART_INT_STATUS_FERR_Msk | SERCOM_USART_INT_STATUS_BUFOVF_Msk));
+
+            if(errorStatus != USART_ERROR_NONE)
+            {
+                break;
+            }
+
+            if (((SERCOM0_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) != 0x01U)
+            {
+                pu8Data[u32Index] = (uint8_t)SERCOM0_REGS->USART_INT.SERCOM_DATA;
+            }
+            else
+            {
+                pu16Data[u32Index] = (uint16_t)SERCOM0_REGS->USART_INT.SERCOM_DATA;
+            }
+
+            u32Index++;
+        }
+
+        if(size == u32Index)
+        {
+            readStatus = true;
+        }
+    }
+
+    return readStatus;
+}
+
+/* Cycles of BENCHMARK_USART_BURSTS writes of BENCHMARK_USART_BURST characters.
+ * Each starts with the transmitter idle, so DATA and the shift register take
+ * the burst without waiting on the line. */
+static uint32_t BENCHMARK_UsartWriteTime( BENCHMARK_USART_FUNCTION write )
+{
+    uint32_t start;
+    uint32_t cycles = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < BENCHMARK_USART_BURSTS; i++)
+    {
+        while (SERCOM0_USART_TransmitComplete() == false)
+        {
+            /* Do nothing */
+        }
+
+        start = BENCHMARK_Start();
+        (void)write(benchmarkData, BENCHMARK_USART_BURST);
+        cycles += BENCHMARK_Stop(start) - benchmarkOverhead;
+    }
+
+    while (SERCOM0_USART_TransmitComplete() == false)
+    {
+        /* Do nothing */
+    }
+
+    return cycles;
+}
+
+/* Same for reads of characters already in the receive FIFO. RXPO and TXPO
+ * both select PAD[0], so the receiver sees what was sent unless the pin is
+ * driven from outside; returns false when nothing is echoed. */
+static bool BENCHMARK_UsartReadTime( BENCHMARK_USART_FUNCTION read, uint32_t *cycles )
+{
+    uint32_t start;
+    uint32_t i;
+
+    *cycles = 0U;
+
+    for (i = 0U; i < BENCHMARK_USART_BURSTS; i++)
+    {
+        while (SERCOM0_USART_ReceiverIsReady() == true)
+        {
+            (void)SERCOM0_USART_ReadByte();
+        }
+
+        (void)SERCOM0_USART_Write(benchmarkData, BENCHMARK_USART_BURST);
+        while (SERCOM0_USART_TransmitComplete() == false)
+        {
+            /* Do nothing */
+        }
+
+        if (SERCOM0_USART_ReceiverIsReady() == false)
+        {
+            return false;
+        }
+
+        start = BENCHMARK_Start();
+        (void)read(benchmarkRx, BENCHMARK_USART_BURST);
+        *cycles += BENCHMARK_Stop(start) - benchmarkOverhead;
+    }
+
+    return true;
+}
+#endif
+
+/* Per-character cost of the blocking loops that decoded CTRLB.CHSIZE for
+ * every character, against the specialized SERCOM0_USART_Write/Read. Those
+ * are only built in blocking mode. */
+static void BENCHMARK_UsartLoops( void )
+{
+#ifndef SERCOM0_USART_RING_BUFFER_ENABLE
+    const uint32_t chars = BENCHMARK_USART_BURSTS * BENCHMARK_USART_BURST;
+    uint32_t decodeCycles;
+    uint32_t specialCycles;
+
+    printf("%-28s %8s %8s %8s\r\n", "usart cycles/char", "ctrlb", "special", "saved");
+
+    decodeCycles = BENCHMARK_UsartWriteTime(BENCHMARK_UsartWriteDecode) / chars;
+    specialCycles = BENCHMARK_UsartWriteTime(SERCOM0_USART_Write) / chars;
+    printf("%-28s %8lu %8lu %8ld\r\n", "usart write 2 (cpu bound)",
+           (unsigned long)decodeCycles, (unsigned long)specialCycles, (long)decodeCycles - (long)specialCycles);
+
+    if ((BENCHMARK_UsartReadTime(BENCHMARK_UsartReadDecode, &decodeCycles) == true) &&
+        (BENCHMARK_UsartReadTime(SERCOM0_USART_Read, &specialCycles) == true))
+    {
+        decodeCycles /= chars;
+        specialCycles /= chars;
+        printf("%-28s %8lu %8lu %8ld\r\n", "usart read 2 (cpu bound)",
+               (unsigned long)decodeCycles, (unsigned long)specialCycles, (long)decodeCycles - (long)specialCycles);
+    }
+    else
+    {
+        printf("%-28s no echo on RxD, skipped\r\n", "usart read 2 (cpu bound)");
+    }
+    printf("\r\n");
+#else
+    printf("%-28s blocking mode only, undefine SERCOM0_USART_RING_BUFFER_ENABLE\r\n", "usart cycles/char");
+#endif
+}
+
+/* Whole-call cost per character. The blocking write is line bound; the
+ * ring buffer enqueue is what the CPU pays in interrupt mode. */
+static void BENCHMARK_UsartWrite( void )
+{
+    uint32_t start;
+    uint32_t cycles;
+
+    while (SERCOM0_USART_TransmitComplete() == false)
+    {
+        /* Let the console output drain first */
+    }
+
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+    start = BENCHMARK_Start();
+    (void)SERCOM0_USART_WriteAsync(benchmarkData, 64U);
+    cycles = BENCHMARK_Stop(start);
+    BENCHMARK_Report("usart ring enqueue 64", cycles, 64U);
+
+    while (SERCOM0_USART_TransmitComplete() == false)
+    {
+        /* Do nothing */
+    }
+#endif
+
+    start = BENCHMARK_Start();
+    (void)SERCOM0_USART_Write(benchmarkData, 64U);
+    cycles = BENCHMARK_Stop(start);
+    BENCHMARK_Report("usart write 64 (line bound)", cycles, 64U);
+
+    while (SERCOM0_USART_TransmitComplete() == false)
+    {
+        /* Do nothing */
+    }
+    printf("\r\n");
+}
+
+/* The page buffer fill that NVMCTRL_PageWrite used before the LDM/STM copy */
+static void BENCHMARK_PageBufferWordLoop( uint32_t *data, const uint32_t address )
+{
+    uint32_t i;
+    uint32_t * paddress = (uint32_t *)address;
+
+    for (i = 0U; i < (NVMCTRL_FLASH_PAGESIZE/4U); i++)
+    {
+        *paddress = *(data + i);
+        paddress++;
+    }
+}
+
+/* Bodies of the RAMFUNC cases, inlined into a flash and an SRAM copy: a
+ * count-down delay loop, the ring pull of the USART transmit interrupt and a
+ * page buffer fill */
+static inline __attribute__((always_inline)) void BENCHMARK_DelayBody( uint32_t count )
+{
+    __asm volatile (
+        "1: subs %[count], %[count], #1\n"
+        "   bne 1b\n"
+        : [count] "+l" (count)
+        :
+        : "cc");
+}
+
+static inline __attribute__((always_inline)) void BENCHMARK_RingPullBody( uint32_t count )
+{
+    uint32_t outIndex = benchmarkRingOut;
+
+    while (count > 0U)
+    {
+        benchmarkSink = benchmarkData[outIndex];
+        outIndex++;
+        if (outIndex >= BENCHMARK_ITERATIONS)
+        {
+            outIndex = 0U;
+        }
+        count--;
+    }
+
+    benchmarkRingOut = outIndex;
+}
+
+static inline __attribute__((always_inline)) void BENCHMARK_PageFillBody( uint32_t count )
+{
+    uint32_t *pageBuffer = (uint32_t *)benchmarkPageAddress;
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        pageBuffer[i] = benchmarkWords[i];
+    }
+}
+
+static void __attribute__((noinline)) BENCHMARK_DelayFlash( uint32_t count )
+{
+    BENCHMARK_DelayBody(count);
+}
+
+static RAMFUNC void BENCHMARK_DelayRam( uint32_t count )
+{
+    BENCHMARK_DelayBody(count);
+}
+
+static void __attribute__((noinline)) BENCHMARK_RingPullFlash( uint32_t count )
+{
+    BENCHMARK_RingPullBody(count);
+}
+
+static RAMFUNC void BENCHMARK_RingPullRam( uint32_t count )
+{
+    BENCHMARK_RingPullBody(count);
+}
+
+static void __attribute__((noinline)) BENCHMARK_PageFillFlash( uint32_t count )
+{
+    BENCHMARK_PageFillBody(count);
+}
+
+static RAMFUNC void BENCHMARK_PageFillRam( uint32_t count )
+{
+    BENCHMARK_PageFillBody(count);
+}
+
+static const BENCHMARK_RAMFUNC_CASE benchmarkRamfuncCases[] =
+{
+    { "delay loop 64",          BENCHMARK_DelayFlash,    BENCHMARK_DelayRam,    64U },
+    { "usart ring pull 16",     BENCHMARK_RingPullFlash, BENCHMARK_RingPullRam, 16U },
+    { "page buffer fill",       BENCHMARK_PageFillFlash, BENCHMARK_PageFillRam, NVMCTRL_FLASH_PAGESIZE/4U },
+};
+
+/* Cycles per call. A cold call starts with the NVMCTRL cache invalidated, as
+ * an interrupt handler that has not run for a while does. */
+static uint32_t BENCHMARK_RamfuncTime( BENCHMARK_FUNCTION function, uint32_t count, bool isCold )
+{
+    uint32_t start;
+    uint32_t cycles = 0U;
+    uint32_t i;
+
+    /* Warm up the cache and the branch targets */
+    function(count);
+
+    for (i = 0U; i < BENCHMARK_RAMFUNC_CALLS; i++)
+    {
+        if (isCold)
+        {
+            NVMCTRL_CacheInvalidate();
+            while (NVMCTRL_IsBusy())
+            {
+                /* Wait */
+            }
+        }
+
+        start = BENCHMARK_Start();
+        function(count);
+        cycles += BENCHMARK_Stop(start) - benchmarkOverhead;
+    }
+
+    return (cycles / BENCHMARK_RAMFUNC_CALLS);
+}
+
+/* Flash against SRAM execution of the same code at NVMCTRL_CTRLB_RWS(1) */
+static void BENCHMARK_Ramfunc( void )
+{
+    const BENCHMARK_RAMFUNC_CASE *bench;
+    uint32_t flashCycles;
+    uint32_t ramCycles;
+    uint32_t i;
+    uint32_t pass;
+
+    benchmarkPageAddress = (uint32_t)__nvm_data_start;
+    benchmarkRingOut = 0U;
+
+    /* The page buffer must not be touched while a job programs it */
+    while (SYS_FLASH_IsBusy())
+    {
+        /* Wait */
+    }
+
+    printf("%-28s %8s %8s %8s\r\n", "cycles/call", "flash", "sram", "saved");
+
+    for (pass = 0U; pass < 2U; pass++)
+    {
+        for (i = 0U; i < (sizeof(benchmarkRamfuncCases) / sizeof(benchmarkRamfuncCases[0])); i++)
+        {
+            bench = &benchmarkRamfuncCases[i];
+
+            flashCycles = BENCHMARK_RamfuncTime(bench->flash, bench->count, (pass != 0U));
+            ramCycles = BENCHMARK_RamfuncTime(bench->ram, bench->count, (pass != 0U));
+
+            printf("%-22s %-5s %8lu %8lu %8ld\r\n", bench->name, (pass != 0U) ? "cold" : "warm",
+                   (unsigned long)flashCycles, (unsigned long)ramCycles, (long)flashCycles - (long)ramCycles);
+        }
+    }
+
+    /* Nothing is committed: drop the loaded page buffer */
+    NVMCTRL_REGS->NVMCTRL_CTRLA = (uint16_t)(NVMCTRL_CTRLA_CMD_PBC_Val | NVMCTRL_CTRLA_CMDEX_KEY);
+    while (NVMCTRL_IsBusy())
+    {
+        /* Wait */
+    }
+    printf("\r\n");
+}
+
+/* Flash to RAM reads and page buffer fills, memcpy/word loop against the
+ * LDM/STM paths in plib_nvmctrl.c. Costs are per 32-bit word. */
+static void BENCHMARK_NvmctrlCopy( void )
+{
+    uint32_t pageAddress = (uint32_t)__nvm_data_start;
+    uint32_t start;
+    uint32_t cycles;
+    uint32_t i;
+
+    start = BENCHMARK_Start();
+    for (i = 0U; i < BENCHMARK_NVM_PASSES; i++)
+    {
+        (void)memcpy(benchmarkWords, (const void *)pageAddress, sizeof(benchmarkWords));
+    }
+    cycles = BENCHMARK_Stop(start);
+    BENCHMARK_Report("nvm read memcpy", cycles, BENCHMARK_NVM_PASSES * BENCHMARK_NVM_WORDS);
+
+    start = BENCHMARK_Start();
+    for (i = 0U; i < BENCHMARK_NVM_PASSES; i++)
+    {
+        (void)NVMCTRL_Read(benchmarkWords, sizeof(benchmarkWords), pageAddress);
+    }
+    cycles = BENCHMARK_Stop(start);
+    BENCHMARK_Report("nvm read ldm/stm", cycles, BENCHMARK_NVM_PASSES * BENCHMARK_NVM_WORDS);
+
+    start = BENCHMARK_Start();
+    for (i = 0U; i < BENCHMARK_NVM_PASSES; i++)
+    {
+        (void)NVMCTRL_Read((uint32_t *)&benchmarkData[1], sizeof(benchmarkWords) - 4U, pageAddress);
+    }
+    cycles = BENCHMARK_Stop(start);
+    BENCHMARK_Report("nvm read unaligned", cycles, BENCHMARK_NVM_PASSES * (BENCHMARK_NVM_WORDS - 1U));
+
+    /* The page buffer must not be touched while a job programs it */
+    while (SYS_FLASH_IsBusy())
+    {
+        /* Wait */
+    }
+
+    start = BENCHMARK_Start();
+    for (i = 0U; i < BENCHMARK_NVM_PASSES; i++)
+    {
+        BENCHMARK_PageBufferWordLoop(benchmarkWords, pageAddress);
+    }
+    cycles = BENCHMARK_Stop(start);
+    BENCHMARK_Report("page buffer word loop", cycles, BENCHMARK_NVM_PASSES * (NVMCTRL_FLASH_PAGESIZE/4U));
+
+    start = BENCHMARK_Start();
+    for (i = 0U; i < BENCHMARK_NVM_PASSES; i++)
+    {
+        (void)NVMCTRL_PageBufferWrite(benchmarkWords, pageAddress);
+    }
+    cycles = BENCHMARK_Stop(start);
+    BENCHMARK_Report("page buffer ldm/stm", cycles, BENCHMARK_NVM_PASSES * (NVMCTRL_FLASH_PAGESIZE/4U));
+
+    /* Nothing is committed: drop the loaded page buffer */
+    NVMCTRL_REGS->NVMCTRL_CTRLA = (uint16_t)(NVMCTRL_CTRLA_CMD_PBC_Val | NVMCTRL_CTRLA_CMDEX_KEY);
+    while (NVMCTRL_IsBusy())
+    {
+        /* Wait */
+    }
+    printf("\r\n");
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void BENCHMARK_Run ( void )
+{
+    uint32_t start;
+    uint32_t i;
+
+    for (i = 0U; i < BENCHMARK_ITERATIONS; i++)
+    {
+        /* Printable filler, 8-bit mode */
+        benchmarkData[i] = (uint8_t)('0' + (i % 10U));
+    }
+
+    benchmarkOverhead = 0U;
+    start = BENCHMARK_Start();
+    benchmarkOverhead = BENCHMARK_Stop(start);
+
+    printf("\r\nbenchmark: %lu Hz, overhead %lu cycles\r\n", (unsigned long)SYS_TIME_FrequencyGet(), (unsigned long)benchmarkOverhead);
+
+    BENCHMARK_UsartLoops();
+    BENCHMARK_UsartWrite();
+    BENCHMARK_NvmctrlCopy();
+    BENCHMARK_Ramfunc();
+}
+
+#endif /* APP_BENCHMARK_ENABLE */
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,79 @@
+/*******************************************************************************
+  Cycle-count Benchmark Header File
+
+  File Name:
+    benchmark.h
+
+  Summary:
+    Start-up micro benchmarks for the peripheral libraries and services.
+
+  Description:
+    The benchmarks time short code sequences with SYS_TIME_Now, which counts
+    48 MHz CPU cycles, and print the result on the console. They are built
+    only when APP_BENCHMARK_ENABLE is defined in configuration.h.
+*******************************************************************************/
+
+#ifndef _BENCHMARK_H
+#define _BENCHMARK_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+#ifdef APP_BENCHMARK_ENABLE
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void BENCHMARK_Run ( void )
+
+  Summary:
+    Runs all benchmarks and prints one line per case.
+
+  Description:
+    Each line gives the case name, the total cycle count and the cycles per
+    iteration, with the measurement overhead removed. A case that spans a
+    SysTick period also includes the few cycles of the SYS_TIME interrupt.
+
+  Precondition:
+    SYS_Initialize must have completed (console and interrupts are up).
+
+  Remarks:
+    Blocking. Intended to be called once from the application.
+*/
+
+void BENCHMARK_Run ( void );
+
+#endif
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _BENCHMARK_H */
+
+/*******************************************************************************
+ End of File
+ */
@@ -72,6 +72,47 @@ extern "C" {
 // *****************************************************************************
 // *****************************************************************************
 
+/* Clock manager. With CLOCK_DFLL_CLOSED_LOOP the DFLL locks to the 32.768 kHz
+ * crystal (XOSC32K), or to OSC32K with CLOCK_DFLL_REFERENCE_OSC32K, once the
+ * reference runs; until then, or without a crystal, it stays open loop.
+ * CLOCK_FrequencySet divides GCLK0 at run time and notifies up to
+ * CLOCK_CALLBACK_MAX modules (SYS_TIME, SERCOM0 and TC3 here).
+ */
+#define CLOCK_DFLL_CLOSED_LOOP
+//#define CLOCK_DFLL_REFERENCE_OSC32K
+#define CLOCK_CALLBACK_MAX                      (4U)
+#define SYSCTRL_INT_PRIORITY                    (3U)
+
+/* SERCOM0 USART ring buffer mode.
+ * When defined, SERCOM0_Handler fills the receive ring and drains the transmit
+ * ring so the blocking calls only wait when a ring is full or empty. Sizes
+ * are in bytes; in 9-bit mode each character occupies two bytes.
+ */
+#define SERCOM0_USART_RING_BUFFER_ENABLE
+#define SERCOM0_USART_READ_BUFFER_SIZE          (128U)
+#define SERCOM0_USART_WRITE_BUFFER_SIZE         (256U)
+#define SERCOM0_USART_INT_PRIORITY              (3U)
+
+/* SERCOM0 USART DMA transmit. SERCOM0_USART_WriteDMA streams a caller-owned
+ * buffer through this DMAC channel without copying it.
+ */
+#define SERCOM0_USART_TX_DMA_CHANNEL            (DMAC_CHANNEL_0)
+
+/* SERCOM0 USART DMA receive with idle-line framing. Needs the ring buffer mode:
+ * the DMAC writes straight into the read ring and TC3 samples its position
+ * every 500 us. A frame is reported once a full period passes without new
+ * characters. The ring must be drained before the DMAC wraps onto unread data.
+ */
+#define SERCOM0_USART_RX_DMA_CHANNEL            (DMAC_CHANNEL_1)
+#define TC3_INT_PRIORITY                        (3U)
+#define DMAC_INT_PRIORITY                       (3U)
+#define NVMCTRL_INT_PRIORITY                    (3U)
+
+/* SysTick drives the SYS_TIME timebase. It keeps the highest priority so no
+ * reader of SYS_TIME_Now can interrupt the tick update. */
+#define SYSTICK_INT_PRIORITY                    (0U)
+#define TC4_INT_PRIORITY                        (3U)
+
 
 
 // *****************************************************************************
@@ -79,6 +120,99 @@ extern "C" {
 // Section: System Service Configuration
 // *****************************************************************************
 // *****************************************************************************
+/* Debug System Service Configuration Options */
+#define SYS_DEBUG_ENABLE
+#define SYS_DEBUG_GLOBAL_ERROR_LEVEL            SYS_ERROR_DEBUG
+#define SYS_DEBUG_USE_LOG
+
+/* Console stdio buffering. STDIO_OUTPUT_BUFFER_MODE is _IONBF, _IOLBF (flush
+ * on newline) or _IOFBF (flush when full) from <stdio.h>.
+ */
+#define STDIO_OUTPUT_BUFFER_MODE                _IOLBF
+#define STDIO_OUTPUT_BUFFER_SIZE                (128U)
+#define STDIO_INPUT_BUFFER_SIZE                 (32U)
+
+/* Deferred binary log. SYS_LOG_BUFFER_SIZE is in bytes and must be a power of
+ * two. Records are streamed through the SERCOM0 transmit ring and decoded on
+ * the host with tools/log_decoder.py.
+ */
+#define SYS_LOG_BUFFER_SIZE                     (1024U)
+#define SYS_LOG_WRITE(buffer, size)             SERCOM0_USART_WriteAsync((buffer), (size))
+#define SYS_LOG_WRITE_FREE_GET()                SERCOM0_USART_WriteFreeBufferCountGet()
+#define SYS_LOG_TIMESTAMP_GET()                 ((uint32_t)SYS_TIME_Now())
+
+/* Flash job queue. Jobs run from the NVMCTRL READY interrupt. */
+#define SYS_FLASH_QUEUE_SIZE                    (4U)
+
+/* Key/value store in the flash region reserved by NVM_DATA_LENGTH in the
+ * linker script. Keys are 0 to SYS_KV_KEY_COUNT - 1; every key costs two
+ * bytes of RAM index.
+ */
+#define SYS_KV_KEY_COUNT                        (32U)
+#define SYS_KV_VALUE_MAX_SIZE                   (24U)
+
+/* Fixed-block memory pools behind OSAL_Malloc. Block sizes are powers of two
+ * in ascending order; a request takes the smallest class that has a free
+ * block. SYS_MEMPOOL_INTERRUPT_SAFE allows allocation from interrupts.
+ */
+#define SYS_MEMPOOL_CLASS_COUNT                 (3U)
+#define SYS_MEMPOOL_CLASS0_BLOCK_SIZE           (16U)
+#define SYS_MEMPOOL_CLASS0_BLOCK_COUNT          (16U)
+#define SYS_MEMPOOL_CLASS1_BLOCK_SIZE           (64U)
+#define SYS_MEMPOOL_CLASS1_BLOCK_COUNT          (8U)
+#define SYS_MEMPOOL_CLASS2_BLOCK_SIZE           (256U)
+#define SYS_MEMPOOL_CLASS2_BLOCK_COUNT          (2U)
+#define SYS_MEMPOOL_INTERRUPT_SAFE
+
+/* Cooperative scheduler. SYS_SCHED_Tasks runs at most SYS_SCHED_DISPATCH_MAX
+ * ready tasks per SYS_Tasks pass before the polled services get a turn.
+ */
+#define SYS_SCHED_DISPATCH_MAX                  (8U)
+
+/* Run-time profiling of the SYS_Tasks passes, the polled services and the
+ * SYS_SCHED tasks; SYS_PROF_Print dumps it on the console. Durations are
+ * sorted into SYS_PROF_BUCKET_COUNT power-of-two buckets of SYS_TIME
+ * cycles, the first below 2^SYS_PROF_BUCKET_SHIFT cycles. Costs two
+ * SYS_TIME_Now calls per measured call, so it is off by default.
+ */
+//#define SYS_PROF_ENABLE
+#define SYS_PROF_BUCKET_COUNT                   (16U)
+#define SYS_PROF_BUCKET_SHIFT                   (6U)
+
+/* Interrupt latency and duration statistics of the handlers in
+ * interrupts.c, printed by SYS_INT_StatsPrint. Costs about 60 cycles per
+ * interrupt, so it is off by default.
+ */
+//#define SYS_INT_STATS_ENABLE
+
+/* Boot. SYS_BOOT_PROFILE_ENABLE records the time of every SYS_Initialize
+ * phase for SYS_BOOT_Print. SYS_BOOT_FAST runs the start-up code at 8 MHz
+ * and initializes the modules that do not need GCLK0 while the DFLL starts.
+ * Buffers defined with SYS_BOOT_NO_INIT skip the .bss zero fill; define it
+ * empty to zero them again.
+ */
+#define SYS_BOOT_PROFILE_ENABLE
+#define SYS_BOOT_FAST
+#define SYS_BOOT_NO_INIT                        NO_INIT
+
+/* Fault capture. SYS_FAULT_STACK_WORDS words above the exception frame are
+ * kept with the registers across the reset that follows a fault.
+ */
+#define SYS_FAULT_STACK_WORDS                   (32U)
+
+/* Vector table copied to RAM at reset. Vector fetches then skip the flash
+ * wait states, and SYS_INT_HandlerSet can attach handlers at run time.
+ */
+#define SYS_INT_VECTOR_TABLE_RAM
+
+/* Tickless idle sleep at the end of SYS_Tasks. SYS_PM_IDLE_ALLOWED() vetoes
+ * the sleep while a polled service still has work that no interrupt will
+ * signal. IDLE0 keeps the AHB clock that the DMAC needs.
+ */
+#define SYS_PM_IDLE_MODE                        PM_IDLE_MODE_IDLE0
+#define SYS_PM_IDLE_ALLOWED()                   ((SYS_KV_IsBusy() == false) && SYS_SCHED_IsIdle() && \
+                                                 (SYS_LOG_IsPending() == false))
+#define SYS_PM_SLEEP_MIN_CYCLES                 (2400U)
 
 
 // *****************************************************************************
@@ -101,6 +235,14 @@ extern "C" {
 // *****************************************************************************
 // *****************************************************************************
 
+/* Define to run the cycle-count benchmarks (benchmark.c) once at start-up.
+ * The USART loop case needs the blocking mode: also comment out
+ * SERCOM0_USART_RING_BUFFER_ENABLE and SERCOM0_USART_RX_DMA_CHANNEL. */
+//#define APP_BENCHMARK_ENABLE
+
+/* Scheduler priority of CORE_APP_Tasks, 0 (highest) to 31 */
+#define CORE_APP_TASK_PRIORITY                  (16U)
+
 
 //DOM-IGNORE-BEGIN
 #ifdef __cplusplus
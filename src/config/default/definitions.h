@@ -50,14 +50,30 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include "peripheral/nvmctrl/plib_nvmctrl.h"
+#include "peripheral/dmac/plib_dmac.h"
+#include "peripheral/tc/plib_tc3.h"
+#include "peripheral/tc/plib_tc4.h"
 #include "peripheral/evsys/plib_evsys.h"
 #include "peripheral/sercom/usart/plib_sercom0_usart.h"
 #include "peripheral/port/plib_port.h"
 #include "peripheral/clock/plib_clock.h"
 #include "peripheral/nvic/plib_nvic.h"
+#include "peripheral/pm/plib_pm.h"
 #include "peripheral/systick/plib_systick.h"
 #include "system/int/sys_int.h"
+#include "system/fault/sys_fault.h"
+#include "system/boot/sys_boot.h"
 #include "osal/osal.h"
+#include "system/time/sys_time.h"
+#include "system/tmr/sys_tmr.h"
+#include "system/pm/sys_pm.h"
+#include "system/prof/sys_prof.h"
+#include "system/sched/sys_sched.h"
+#include "system/queue/sys_queue.h"
+#include "system/mempool/sys_mempool.h"
+#include "system/log/sys_log.h"
+#include "system/flash/sys_flash.h"
+#include "system/kv/sys_kv.h"
 #include "system/debug/sys_debug.h"
 #include "core_app.h"
 
@@ -190,7 +206,8 @@ Remarks:
 
 typedef struct
 {
-    char reserved;
+    SYS_MODULE_OBJ  sysDebug;
+
 } SYSTEM_OBJECTS;
 
 // *****************************************************************************
@@ -10,8 +10,9 @@
 
   Description:
     This file redefines the default _weak_  exception handler with a more debug
-    friendly one. If an unexpected exception occurs the code will stop in a
-    while(1) loop.
+    friendly one. If an unexpected exception occurs the fault capture service
+    records the CPU state and resets the device; debug builds stop at a
+    breakpoint first.
  *******************************************************************************/
 
 // DOM-IGNORE-BEGIN
@@ -56,28 +57,36 @@
 // *****************************************************************************
 // *****************************************************************************
 
+/* Passes the stack that holds the exception frame, the process stack of an
+   RTOS task or the main stack as EXC_RETURN bit 2 tells, to
+   SYS_FAULT_Capture. Written in assembly so that no C prologue moves the
+   stack pointer first. */
+#define EXCEPTIONS_FAULT_CAPTURE(reason)                                    \
+    __asm volatile (                                                        \
+        "movs   r0, #4          \n"                                         \
+        "mov    r1, lr          \n"                                         \
+        "tst    r0, r1          \n"                                         \
+        "mrs    r0, msp         \n"                                         \
+        "beq    1f              \n"                                         \
+        "mrs    r0, psp         \n"                                         \
+        "1:                     \n"                                         \
+        "movs   r2, %[code]     \n"                                         \
+        "bl     SYS_FAULT_Capture \n"                                       \
+        :                                                                   \
+        : [code] "I" (reason))
+
 /* Brief default interrupt handlers for core IRQs.*/
-void __attribute__((noreturn, weak)) NonMaskableInt_Handler(void)
+void __attribute__((naked, noreturn, weak)) NonMaskableInt_Handler(void)
 {
-#if defined(__DEBUG) || defined(__DEBUG_D) && defined(__XC32)
-    __builtin_software_breakpoint();
-#endif
-    while (true)
-    {
-    }
+    EXCEPTIONS_FAULT_CAPTURE(SYS_FAULT_REASON_NMI);
 }
- 
-void __attribute__((noreturn, weak)) HardFault_Handler(void)
+
+void __attribute__((naked, noreturn, weak)) HardFault_Handler(void)
 {
-#if defined(__DEBUG) || defined(__DEBUG_D) && defined(__XC32)
-   __builtin_software_breakpoint();
-#endif
-   while (true)
-   {
-   }
+    EXCEPTIONS_FAULT_CAPTURE(SYS_FAULT_REASON_HARDFAULT);
 }
 
- 
+
 /*******************************************************************************
  End of File
  */
@@ -106,6 +106,12 @@ SYSTEM_OBJECTS sysObj;
 // Section: System Initialization
 // *****************************************************************************
 // *****************************************************************************
+const SYS_DEBUG_INIT debugInit =
+{
+    .moduleInit = {0},
+    .errorLevel = SYS_DEBUG_GLOBAL_ERROR_LEVEL,
+    .consoleIndex = 0,
+};
 
 
 
@@ -123,17 +129,22 @@ SYSTEM_OBJECTS sysObj;
     Sets the buffering mode for stdin and stdout
 
   Remarks:
+    The mode and sizes come from configuration.h. With _IOLBF, stdout is
+    flushed on '\n', when full, or by fflush(stdout).
  ********************************************************************************/
+static char stdinBuffer[STDIO_INPUT_BUFFER_SIZE] SYS_BOOT_NO_INIT;
+static char stdoutBuffer[STDIO_OUTPUT_BUFFER_SIZE] SYS_BOOT_NO_INIT;
+
 static void STDIO_BufferModeSet(void)
 {
     /* MISRAC 2012 deviation block start */
     /* MISRA C-2012 Rule 21.6 deviated 2 times in this file.  Deviation record ID -  H3_MISRAC_2012_R_21_6_DR_3 */
 
-    /* Make stdin unbuffered */
-    setbuf(stdin, NULL);
+    /* Line buffered stdin: read() hands over everything received so far */
+    (void)setvbuf(stdin, stdinBuffer, _IOLBF, sizeof(stdinBuffer));
 
-    /* Make stdout unbuffered */
-    setbuf(stdout, NULL);
+    /* Batch stdout so printf issues one write() per line or buffer */
+    (void)setvbuf(stdout, stdoutBuffer, STDIO_OUTPUT_BUFFER_MODE, sizeof(stdoutBuffer));
 }
 
 
@@ -155,25 +166,74 @@ void SYS_Initialize ( void* data )
     /* MISRAC 2012 deviation block start */
     /* MISRA C-2012 Rule 2.2 deviated in this file.  Deviation record ID -  H3_MISRAC_2012_R_2_2_DR_1 */
 
+    SYS_BOOT_MARK("start-up", SYS_BOOT_RESET_CPU_FREQUENCY);
+
     NVMCTRL_REGS->NVMCTRL_CTRLB = NVMCTRL_CTRLB_RWS(3UL);
 
     STDIO_BufferModeSet();
 
 
   
-
+#if defined(SYS_BOOT_FAST)
+    /* The DFLL starts up while the modules that do not need GCLK0 run */
+    CLOCK_InitializeStart();
+#else
     CLOCK_Initialize();
 
+    SYS_BOOT_MARK("clock", SYS_BOOT_RESET_CPU_FREQUENCY);
+#endif
+
+    PM_Initialize();
+
 
 
 
     NVMCTRL_Initialize( );
 
+    DMAC_Initialize();
+
+    SYS_FAULT_Initialize();
+
+    SYS_MEMPOOL_Initialize();
+
+#if defined(SYS_BOOT_FAST)
+    CLOCK_InitializeComplete();
+
+    SYS_BOOT_MARK("clock, pm to mempool", SYS_BOOT_RESET_CPU_FREQUENCY);
+#else
+    SYS_BOOT_MARK("pm to mempool", CPU_CLOCK_FREQUENCY);
+#endif
+
+    TC3_TimerInitialize();
+
+    TC4_TimerInitialize();
 
     SERCOM0_USART_Initialize();
 
+    SYS_BOOT_MARK("tc3, tc4, sercom0", CPU_CLOCK_FREQUENCY);
+
 	SYSTICK_TimerInitialize();
 
+    SYS_TIME_Initialize();
+
+    SYS_TMR_Initialize();
+
+    SYS_PM_Initialize();
+
+    SYS_SCHED_Initialize();
+
+    SYS_LOG_Initialize();
+
+    sysObj.sysDebug = SYS_DEBUG_Initialize(SYS_DEBUG_INDEX_0, (SYS_MODULE_INIT*)&debugInit);
+
+    SYS_BOOT_MARK("systick to debug", CPU_CLOCK_FREQUENCY);
+
+    SYS_FLASH_Initialize();
+
+    SYS_KV_Initialize();
+
+    SYS_BOOT_MARK("flash, kv", CPU_CLOCK_FREQUENCY);
+
 
     /* MISRAC 2012 deviation block start */
     /* Following MISRA-C rules deviated in this block  */
@@ -189,6 +249,10 @@ void SYS_Initialize ( void* data )
 
     NVIC_Initialize();
 
+    SYS_BOOT_MARK("app, nvic", CPU_CLOCK_FREQUENCY);
+
+    SYS_FAULT_Report();
+
 
     /* MISRAC 2012 deviation block end */
 }
@@ -76,21 +76,22 @@ void __attribute__((optimize("-O1"), long_call, noreturn, used))Dummy_Handler(vo
 }
 
 /* MISRAC 2012 deviation block start */
-/* MISRA C-2012 Rule 8.6 deviated 31 times.  Deviation record ID -  H3_MISRAC_2012_R_8_6_DR_1 */
+/* MISRA C-2012 Rule 8.6 deviated 26 times.  Deviation record ID -  H3_MISRAC_2012_R_8_6_DR_1 */
 /* Device vectors list dummy definition*/
 extern void SVCall_Handler             ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void PendSV_Handler             ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void SysTick_Handler            ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void PM_Handler                 ( void ) __attribute__((weak, alias("Dummy_Handler")));
+#if !defined(CLOCK_DFLL_CLOSED_LOOP)
 extern void SYSCTRL_Handler            ( void ) __attribute__((weak, alias("Dummy_Handler")));
+#endif
 extern void WDT_Handler                ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void RTC_Handler                ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void EIC_Handler                ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void NVMCTRL_Handler            ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void DMAC_Handler               ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void USB_Handler                ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void EVSYS_Handler              ( void ) __attribute__((weak, alias("Dummy_Handler")));
+#ifndef SERCOM0_USART_RING_BUFFER_ENABLE
 extern void SERCOM0_Handler            ( void ) __attribute__((weak, alias("Dummy_Handler")));
+#endif
 extern void SERCOM1_Handler            ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void SERCOM2_Handler            ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void SERCOM3_Handler            ( void ) __attribute__((weak, alias("Dummy_Handler")));
@@ -99,8 +100,6 @@ extern void SERCOM5_Handler            ( void ) __attribute__((weak, alias("Dumm
 extern void TCC0_Handler               ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void TCC1_Handler               ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void TCC2_Handler               ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void TC3_Handler                ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void TC4_Handler                ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void TC5_Handler                ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void TC6_Handler                ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void TC7_Handler                ( void ) __attribute__((weak, alias("Dummy_Handler")));
@@ -115,6 +114,55 @@ extern void I2S_Handler                ( void ) __attribute__((weak, alias("Dumm
 
 /* Multiple handlers for vector */
 
+/* The handler bodies run in SYS_INT_STATS_MEASURE, which records their
+ * latency and duration when SYS_INT_STATS_ENABLE is defined */
+
+void __attribute__((used)) SysTick_Handler( void )
+{
+    SYS_INT_STATS_MEASURE(SysTick, SYS_INT_STATS_LATENCY_SYSTICK,
+                          SYSTICK_TimerInterruptHandler());
+}
+
+#if defined(CLOCK_DFLL_CLOSED_LOOP)
+void __attribute__((used)) SYSCTRL_Handler( void )
+{
+    SYS_INT_STATS_MEASURE(SYSCTRL, SYS_INT_STATS_LATENCY_NONE,
+                          SYSCTRL_InterruptHandler());
+}
+#endif
+
+void __attribute__((used)) NVMCTRL_Handler( void )
+{
+    SYS_INT_STATS_MEASURE(NVMCTRL, SYS_INT_STATS_LATENCY_NONE,
+                          NVMCTRL_InterruptHandler());
+}
+
+void __attribute__((used)) DMAC_Handler( void )
+{
+    SYS_INT_STATS_MEASURE(DMAC, SYS_INT_STATS_LATENCY_NONE,
+                          DMAC_InterruptHandler());
+}
+
+void __attribute__((used)) TC3_Handler( void )
+{
+    /* TC3 restarts from 0 at the period match and counts GCLK0 / 16 */
+    SYS_INT_STATS_MEASURE(TC3, (uint32_t)TC3_Timer16bitCounterGet() * 16U,
+                          TC3_TimerInterruptHandler());
+}
+
+void __attribute__((used)) TC4_Handler( void )
+{
+    SYS_INT_STATS_MEASURE(TC4, SYS_INT_STATS_LATENCY_NONE,
+                          TC4_TimerInterruptHandler());
+}
+
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+void __attribute__((used)) SERCOM0_Handler( void )
+{
+    SYS_INT_STATS_MEASURE(SERCOM0, SYS_INT_STATS_LATENCY_NONE,
+                          SERCOM0_USART_InterruptHandler());
+}
+#endif
 
 
 __attribute__ ((section(".vectors"), used))
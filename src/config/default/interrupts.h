@@ -60,6 +60,13 @@
 void Reset_Handler (void);
 void NonMaskableInt_Handler (void);
 void HardFault_Handler (void);
+void SysTick_Handler (void);
+void SYSCTRL_Handler (void);
+void NVMCTRL_Handler (void);
+void DMAC_Handler (void);
+void SERCOM0_Handler (void);
+void TC3_Handler (void);
+void TC4_Handler (void);
 
 
 
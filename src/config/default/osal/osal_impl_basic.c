@@ -0,0 +1,355 @@
+/*******************************************************************************
+  Operating System Abstraction Layer Basic Implementation
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    osal_impl_basic.c
+
+  Summary:
+    Semaphores and mutexes of the OSAL Basic implementation.
+
+  Description:
+    Without an RTOS there is no thread to block. OSAL_SEM_Pend and
+    OSAL_MUTEX_Lock therefore sleep the CPU between interrupts until an
+    interrupt releases the object or the timeout, measured on SYS_TIME,
+    runs out. Cooperative tasks wait through OSAL_SEM_PendAsync and
+    OSAL_MUTEX_LockAsync instead: the task goes on the wait queue of the
+    object and is signaled by the post, the unlock or its SYS_SCHED timer.
+    Called from a SYS_SCHED task with a wait, OSAL_SEM_Pend and
+    OSAL_MUTEX_Lock stop the firmware through SYS_FAULT_Raise, since the
+    task that would release the object cannot run.
+ *******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "device.h"
+#include "osal/osal.h"
+#include "system/fault/sys_fault.h"
+#include "system/time/sys_time.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Called with interrupts masked */
+static bool OSAL_SEM_Take(OSAL_SEM_HANDLE_TYPE* semID)
+{
+  if (semID->count > 0U)
+  {
+    semID->count--;
+    return true;
+  }
+  return false;
+}
+
+/* Called with interrupts masked */
+static bool OSAL_MUTEX_Take(OSAL_MUTEX_HANDLE_TYPE* mutexID)
+{
+  if (mutexID->isLocked == false)
+  {
+    mutexID->isLocked = true;
+    return true;
+  }
+  return false;
+}
+
+/* Sleeps between interrupts until take succeeds or waitMS runs out. The check
+   and the WFI run with interrupts masked, so an interrupt that releases the
+   object after the check still ends the WFI and its handler runs before the
+   next check. Must not be called with interrupts disabled. A SYS_SCHED task
+   may only try once: no other task runs until this one returns, so a wait
+   could only end on the timeout, or never with OSAL_WAIT_FOREVER. */
+static OSAL_RESULT OSAL_Wait(bool (*take)(void* object), void* object, uint16_t waitMS)
+{
+  uint64_t start = SYS_TIME_Now();
+  uint64_t timeout = SYS_TIME_USToCycles((uint32_t)waitMS * 1000U);
+  OSAL_RESULT result = OSAL_RESULT_FAIL;
+  uint32_t processorStatus;
+  bool isWaiting = true;
+
+  if ((waitMS != 0U) && (SYS_SCHED_TaskRunningGet() != NULL))
+  {
+    /* Fails even when the object is free, so the misuse shows up at once */
+    SYS_FAULT_Raise(SYS_FAULT_REASON_TASK_BLOCK);
+  }
+
+  while (isWaiting)
+  {
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    if (take(object))
+    {
+      result = OSAL_RESULT_SUCCESS;
+      isWaiting = false;
+    }
+    else if ((waitMS != OSAL_WAIT_FOREVER) && ((SYS_TIME_Now() - start) >= timeout))
+    {
+      isWaiting = false;
+    }
+    else
+    {
+      /* The SysTick interrupt ends the sleep at least once per tick */
+      __WFI();
+    }
+
+    __set_PRIMASK(processorStatus);
+  }
+
+  return result;
+}
+
+static bool OSAL_SEM_TakeObject(void* object)
+{
+  return OSAL_SEM_Take((OSAL_SEM_HANDLE_TYPE*)object);
+}
+
+static bool OSAL_MUTEX_TakeObject(void* object)
+{
+  return OSAL_MUTEX_Take((OSAL_MUTEX_HANDLE_TYPE*)object);
+}
+
+/* Tries take for a task, putting it on the wait queue and starting its timeout
+   on the first miss. Returns false while the task has to keep waiting. */
+static bool OSAL_WaitAsync(bool (*take)(void* object), void* object, SYS_SCHED_WAIT_QUEUE* waiters,
+                           SYS_SCHED_TASK* task, uint16_t waitMS, OSAL_RESULT* result)
+{
+  uint32_t processorStatus;
+  bool isDone = true;
+
+  processorStatus = __get_PRIMASK();
+  __disable_irq();
+
+  if (take(object))
+  {
+    *result = OSAL_RESULT_SUCCESS;
+  }
+  else if (waitMS == 0U)
+  {
+    *result = OSAL_RESULT_FAIL;
+  }
+  else if (task->waitQueue != waiters)
+  {
+    SYS_SCHED_WaitQueueAdd(waiters, task);
+    if (waitMS != OSAL_WAIT_FOREVER)
+    {
+      (void)SYS_SCHED_TimerStart(task, waitMS, 0U);
+    }
+    isDone = false;
+  }
+  else if ((waitMS != OSAL_WAIT_FOREVER) && !SYS_TMR_IsActive(&task->timer))
+  {
+    /* Timed out */
+    *result = OSAL_RESULT_FAIL;
+  }
+  else
+  {
+    isDone = false;
+  }
+
+  if (isDone)
+  {
+    SYS_SCHED_WaitQueueRemove(task);
+    if ((waitMS != 0U) && (waitMS != OSAL_WAIT_FOREVER))
+    {
+      (void)SYS_SCHED_TimerStop(task);
+    }
+  }
+
+  __set_PRIMASK(processorStatus);
+
+  return isDone;
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Semaphore Group
+// *****************************************************************************
+// *****************************************************************************
+
+OSAL_RESULT OSAL_SEM_Create(OSAL_SEM_HANDLE_TYPE* semID, OSAL_SEM_TYPE type, uint8_t maxCount, uint8_t initialCount)
+{
+  if (type == OSAL_SEM_TYPE_COUNTING)
+  {
+    if ((maxCount == 0U) || (initialCount > maxCount))
+    {
+      return OSAL_RESULT_FAIL;
+    }
+    semID->maxCount = maxCount;
+    semID->count = initialCount;
+  }
+  else
+  {
+    semID->maxCount = 1U;
+    semID->count = (initialCount != 0U) ? 1U : 0U;
+  }
+
+  SYS_SCHED_WaitQueueInitialize(&semID->waiters);
+
+  return OSAL_RESULT_SUCCESS;
+}
+
+OSAL_RESULT OSAL_SEM_Delete(OSAL_SEM_HANDLE_TYPE* semID)
+{
+  uint32_t processorStatus;
+
+  processorStatus = __get_PRIMASK();
+  __disable_irq();
+
+  while (semID->waiters.head != NULL)
+  {
+    SYS_SCHED_WaitQueueRemove(semID->waiters.head);
+  }
+  semID->count = 0U;
+
+  __set_PRIMASK(processorStatus);
+
+  return OSAL_RESULT_SUCCESS;
+}
+
+OSAL_RESULT OSAL_SEM_Pend(OSAL_SEM_HANDLE_TYPE* semID, uint16_t waitMS)
+{
+  return OSAL_Wait(OSAL_SEM_TakeObject, semID, waitMS);
+}
+
+bool OSAL_SEM_PendAsync(OSAL_SEM_HANDLE_TYPE* semID, SYS_SCHED_TASK* task, uint16_t waitMS, OSAL_RESULT* result)
+{
+  return OSAL_WaitAsync(OSAL_SEM_TakeObject, semID, &semID->waiters, task, waitMS, result);
+}
+
+OSAL_RESULT OSAL_SEM_Post(OSAL_SEM_HANDLE_TYPE* semID)
+{
+  OSAL_RESULT result = OSAL_RESULT_FAIL;
+  uint32_t processorStatus;
+
+  processorStatus = __get_PRIMASK();
+  __disable_irq();
+
+  if (semID->count < semID->maxCount)
+  {
+    semID->count++;
+    SYS_SCHED_WaitQueueWake(&semID->waiters);
+    result = OSAL_RESULT_SUCCESS;
+  }
+
+  __set_PRIMASK(processorStatus);
+
+  return result;
+}
+
+OSAL_RESULT OSAL_SEM_PostISR(OSAL_SEM_HANDLE_TYPE* semID)
+{
+  return OSAL_SEM_Post(semID);
+}
+
+uint8_t OSAL_SEM_GetCount(OSAL_SEM_HANDLE_TYPE* semID)
+{
+  return semID->count;
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Mutex Group
+// *****************************************************************************
+// *****************************************************************************
+
+OSAL_RESULT OSAL_MUTEX_Create(OSAL_MUTEX_HANDLE_TYPE* mutexID)
+{
+  mutexID->isLocked = false;
+  SYS_SCHED_WaitQueueInitialize(&mutexID->waiters);
+
+  return OSAL_RESULT_SUCCESS;
+}
+
+OSAL_RESULT OSAL_MUTEX_Delete(OSAL_MUTEX_HANDLE_TYPE* mutexID)
+{
+  uint32_t processorStatus;
+
+  processorStatus = __get_PRIMASK();
+  __disable_irq();
+
+  while (mutexID->waiters.head != NULL)
+  {
+    SYS_SCHED_WaitQueueRemove(mutexID->waiters.head);
+  }
+
+  __set_PRIMASK(processorStatus);
+
+  return OSAL_RESULT_SUCCESS;
+}
+
+OSAL_RESULT OSAL_MUTEX_Lock(OSAL_MUTEX_HANDLE_TYPE* mutexID, uint16_t waitMS)
+{
+  return OSAL_Wait(OSAL_MUTEX_TakeObject, mutexID, waitMS);
+}
+
+bool OSAL_MUTEX_LockAsync(OSAL_MUTEX_HANDLE_TYPE* mutexID, SYS_SCHED_TASK* task, uint16_t waitMS, OSAL_RESULT* result)
+{
+  return OSAL_WaitAsync(OSAL_MUTEX_TakeObject, mutexID, &mutexID->waiters, task, waitMS, result);
+}
+
+OSAL_RESULT OSAL_MUTEX_Unlock(OSAL_MUTEX_HANDLE_TYPE* mutexID)
+{
+  uint32_t processorStatus;
+
+  processorStatus = __get_PRIMASK();
+  __disable_irq();
+
+  mutexID->isLocked = false;
+  SYS_SCHED_WaitQueueWake(&mutexID->waiters);
+
+  __set_PRIMASK(processorStatus);
+
+  return OSAL_RESULT_SUCCESS;
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Initialization
+// *****************************************************************************
+// *****************************************************************************
+
+OSAL_RESULT OSAL_Initialize(void)
+{
+  return OSAL_RESULT_SUCCESS;
+}
+
+/*******************************************************************************
+ End of File
+ */
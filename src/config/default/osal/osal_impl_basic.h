@@ -15,7 +15,7 @@
  Where it is logical or possible to implement an OSAL function in a simple form
  without an RTOS being present then the function has been defined here and
  implemented either here as an inline or #define. Longer functions that are part
- of the basic implementation may also be found in the file osal.c
+ of the basic implementation may also be found in the file osal_impl_basic.c
  The best way to consider this file is detailing any deviations from the osal.h
  definitions OR as the complete implementation of those functions when pretending
  to support BASIC operations.
@@ -62,16 +62,32 @@ extern "C" {
 #include <stdbool.h>
 #include <stdlib.h>
 #include "system/int/sys_int.h"
+#include "system/mempool/sys_mempool.h"
+#include "system/sched/sys_sched.h"
+#include "system/coro/sys_coro.h"
 #include "device.h"
 
 
-typedef uint8_t                     OSAL_SEM_HANDLE_TYPE;
-typedef uint8_t                     OSAL_MUTEX_HANDLE_TYPE;
+/* Semaphores and mutexes keep the SYS_SCHED tasks waiting for them, so a
+   post wakes the waiting tasks instead of them polling */
+typedef struct
+{
+    volatile uint8_t                count;
+    uint8_t                         maxCount;
+    SYS_SCHED_WAIT_QUEUE            waiters;
+} OSAL_SEM_HANDLE_TYPE;
+
+typedef struct
+{
+    volatile bool                   isLocked;
+    SYS_SCHED_WAIT_QUEUE            waiters;
+} OSAL_MUTEX_HANDLE_TYPE;
+
 typedef uint32_t                    OSAL_CRITSECT_DATA_TYPE;
 #define OSAL_WAIT_FOREVER           (uint16_t) 0xFFFF
 
-#define OSAL_SEM_DECLARE(semID)         uint8_t    semID
-#define OSAL_MUTEX_DECLARE(mutexID)     uint8_t    mutexID
+#define OSAL_SEM_DECLARE(semID)         OSAL_SEM_HANDLE_TYPE    semID
+#define OSAL_MUTEX_DECLARE(mutexID)     OSAL_MUTEX_HANDLE_TYPE  mutexID
 
 // *****************************************************************************
 /* Macro: OSAL_ASSERT
@@ -120,20 +136,27 @@ typedef enum OSAL_RESULT
 // Section: Section: Interface Routines Group Declarations
 // *****************************************************************************
 // *****************************************************************************
-__STATIC_INLINE OSAL_RESULT OSAL_SEM_Create(OSAL_SEM_HANDLE_TYPE* semID, OSAL_SEM_TYPE type, uint8_t maxCount, uint8_t initialCount);
-__STATIC_INLINE OSAL_RESULT OSAL_SEM_Delete(OSAL_SEM_HANDLE_TYPE* semID);
-__STATIC_INLINE OSAL_RESULT OSAL_SEM_Pend(OSAL_SEM_HANDLE_TYPE* semID, uint16_t waitMS);
-__STATIC_INLINE OSAL_RESULT OSAL_SEM_Post(OSAL_SEM_HANDLE_TYPE* semID);
-__STATIC_INLINE OSAL_RESULT OSAL_SEM_PostISR(OSAL_SEM_HANDLE_TYPE* semID);
-__STATIC_INLINE uint8_t OSAL_SEM_GetCount(OSAL_SEM_HANDLE_TYPE* semID);
+OSAL_RESULT OSAL_SEM_Create(OSAL_SEM_HANDLE_TYPE* semID, OSAL_SEM_TYPE type, uint8_t maxCount, uint8_t initialCount);
+OSAL_RESULT OSAL_SEM_Delete(OSAL_SEM_HANDLE_TYPE* semID);
+/* OSAL_SEM_Pend and OSAL_MUTEX_Lock block the CPU, not a task. From a
+   SYS_SCHED task, a waitMS other than 0 calls
+   SYS_FAULT_Raise(SYS_FAULT_REASON_TASK_BLOCK), even when the object is
+   free: the task that would release it could never run. Tasks wait with
+   OSAL_SEM_PEND_AWAIT and OSAL_MUTEX_LOCK_AWAIT below. */
+OSAL_RESULT OSAL_SEM_Pend(OSAL_SEM_HANDLE_TYPE* semID, uint16_t waitMS);
+OSAL_RESULT OSAL_SEM_Post(OSAL_SEM_HANDLE_TYPE* semID);
+OSAL_RESULT OSAL_SEM_PostISR(OSAL_SEM_HANDLE_TYPE* semID);
+uint8_t OSAL_SEM_GetCount(OSAL_SEM_HANDLE_TYPE* semID);
+bool OSAL_SEM_PendAsync(OSAL_SEM_HANDLE_TYPE* semID, SYS_SCHED_TASK* task, uint16_t waitMS, OSAL_RESULT* result);
 
 __STATIC_INLINE OSAL_CRITSECT_DATA_TYPE OSAL_CRIT_Enter(OSAL_CRIT_TYPE severity);
 __STATIC_INLINE void OSAL_CRIT_Leave(OSAL_CRIT_TYPE severity, OSAL_CRITSECT_DATA_TYPE status);
 
-__STATIC_INLINE OSAL_RESULT OSAL_MUTEX_Create(OSAL_MUTEX_HANDLE_TYPE* mutexID);
-__STATIC_INLINE OSAL_RESULT OSAL_MUTEX_Delete(OSAL_MUTEX_HANDLE_TYPE* mutexID);
-__STATIC_INLINE OSAL_RESULT OSAL_MUTEX_Lock(OSAL_MUTEX_HANDLE_TYPE* mutexID, uint16_t waitMS);
-__STATIC_INLINE OSAL_RESULT OSAL_MUTEX_Unlock(OSAL_MUTEX_HANDLE_TYPE* mutexID);
+OSAL_RESULT OSAL_MUTEX_Create(OSAL_MUTEX_HANDLE_TYPE* mutexID);
+OSAL_RESULT OSAL_MUTEX_Delete(OSAL_MUTEX_HANDLE_TYPE* mutexID);
+OSAL_RESULT OSAL_MUTEX_Lock(OSAL_MUTEX_HANDLE_TYPE* mutexID, uint16_t waitMS);
+OSAL_RESULT OSAL_MUTEX_Unlock(OSAL_MUTEX_HANDLE_TYPE* mutexID);
+bool OSAL_MUTEX_LockAsync(OSAL_MUTEX_HANDLE_TYPE* mutexID, SYS_SCHED_TASK* task, uint16_t waitMS, OSAL_RESULT* result);
 
 __STATIC_INLINE void* OSAL_Malloc(size_t size);
 __STATIC_INLINE void OSAL_Free(void* pData);
@@ -142,6 +165,34 @@ OSAL_RESULT OSAL_Initialize(void);
 
 __STATIC_INLINE const char* OSAL_Name(void);
 
+// *****************************************************************************
+/* Macros: OSAL_SEM_PEND_AWAIT(coro, task, semID, waitMS, result)
+           OSAL_MUTEX_LOCK_AWAIT(coro, task, mutexID, waitMS, result)
+
+  Summary:
+    Pend on a semaphore or lock a mutex from a SYS_CORO coroutine.
+
+  Description:
+    OSAL_SEM_Pend and OSAL_MUTEX_Lock sleep the CPU until an interrupt gives
+    them the resource, so other tasks do not run meanwhile. A SYS_SCHED task
+    may only call them with waitMS 0; any other waitMS raises a
+    SYS_FAULT_REASON_TASK_BLOCK fault. Tasks must use these macros, which
+    wait without blocking: the coroutine's task is put on the wait queue of
+    the object and returns to the scheduler, and a post, an unlock or the
+    end of waitMS wakes it. result receives OSAL_RESULT_SUCCESS, or
+    OSAL_RESULT_FAIL on timeout.
+
+  Remarks:
+    The timeout runs on the task timer of SYS_SCHED, which must not be used
+    for anything else during the wait.
+*/
+
+#define OSAL_SEM_PEND_AWAIT(coro, task, semID, waitMS, result)          \
+    SYS_CORO_WAIT_UNTIL((coro), OSAL_SEM_PendAsync((semID), (task), (waitMS), &(result)))
+
+#define OSAL_MUTEX_LOCK_AWAIT(coro, task, mutexID, waitMS, result)      \
+    SYS_CORO_WAIT_UNTIL((coro), OSAL_MUTEX_LockAsync((mutexID), (task), (waitMS), &(result)))
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Interface Routines Group Defintions
@@ -179,140 +230,15 @@ static void OSAL_CRIT_Leave(OSAL_CRIT_TYPE severity, OSAL_CRITSECT_DATA_TYPE sta
 }
 
 // *****************************************************************************
-/* MISRA C-2012 Rule 10.3 False positive:11 Deviation record ID -  H3_MISRAC_2012_R_10_3_DR_1 */
-/* Function: OSAL_RESULT OSAL_SEM_Create(OSAL_SEM_HANDLE_TYPE semID, OSAL_SEM_TYPE type,
-                                uint8_t maxCount, uint8_t initialCount)
- */
-static OSAL_RESULT __attribute__((always_inline)) OSAL_SEM_Create(OSAL_SEM_HANDLE_TYPE* semID, OSAL_SEM_TYPE type,
-                                uint8_t maxCount, uint8_t initialCount)
-{
-  OSAL_CRITSECT_DATA_TYPE IntState;
-
-  IntState = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_HIGH);
-
-  if (type == OSAL_SEM_TYPE_COUNTING)
-  {
-    *semID = initialCount;
-  }
-  else
-  {
-    *semID = 1;
-  }
-
-  OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH,IntState);
-
-  return OSAL_RESULT_SUCCESS;
-}
-
-// *****************************************************************************
-/* Function: OSAL_RESULT OSAL_SEM_Delete(OSAL_SEM_HANDLE_TYPE semID)
- */
-static OSAL_RESULT __attribute__((always_inline)) OSAL_SEM_Delete(OSAL_SEM_HANDLE_TYPE* semID)
-{
-   return (OSAL_RESULT_SUCCESS);
-}
-
-// *****************************************************************************
-/* Function: OSAL_RESULT OSAL_SEM_Pend(OSAL_SEM_HANDLE_TYPE semID, uint16_t waitMS)
- */
-static  OSAL_RESULT __attribute__((always_inline)) OSAL_SEM_Pend(OSAL_SEM_HANDLE_TYPE* semID, uint16_t waitMS)
-{
-  OSAL_CRITSECT_DATA_TYPE IntState;
-
-  IntState = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_HIGH);
-
-  if (*semID > 0U)
-  {
-    (*semID)--;
-    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH,IntState);
-
-    return OSAL_RESULT_SUCCESS;
-  }
-
-  OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH,IntState);
-
-  return OSAL_RESULT_FAIL;
-}
-
-// *****************************************************************************
-/* Function: OSAL_RESULT OSAL_SEM_Post(OSAL_SEM_HANDLE_TYPE semID)
- */
-static OSAL_RESULT __attribute__((always_inline)) OSAL_SEM_Post(OSAL_SEM_HANDLE_TYPE* semID)
-{
-  OSAL_CRITSECT_DATA_TYPE IntState;
-
-  IntState = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_HIGH);
-  (*semID)++;
-  OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH,IntState);
-
-  return OSAL_RESULT_SUCCESS;
-}
+/* Semaphore and mutex group: see osal_impl_basic.c */
 
 // *****************************************************************************
-/* Function: OSAL_RESULT OSAL_SEM_PostISR(OSAL_SEM_HANDLE_TYPE semID)
- */
-static OSAL_RESULT __attribute__((always_inline)) OSAL_SEM_PostISR(OSAL_SEM_HANDLE_TYPE* semID)
-{
-  (*semID)++;
-  return OSAL_RESULT_SUCCESS;
-}
-
-// *****************************************************************************
-/* Function: uint8_t OSAL_SEM_GetCount(OSAL_SEM_HANDLE_TYPE semID)
- */
-static uint8_t __attribute__((always_inline)) OSAL_SEM_GetCount(OSAL_SEM_HANDLE_TYPE* semID)
-{
-  return *semID;
-}
-
-// *****************************************************************************
-/* Function: OSAL_RESULT OSAL_MUTEX_Create(OSAL_MUTEX_HANDLE_TYPE mutexID)
- */
-static OSAL_RESULT __attribute__((always_inline)) OSAL_MUTEX_Create(OSAL_MUTEX_HANDLE_TYPE* mutexID)
-{
-  *mutexID = 1;
-  return OSAL_RESULT_SUCCESS;
-}
-
-// *****************************************************************************
-/* Function: OSAL_RESULT OSAL_MUTEX_Delete(OSAL_MUTEX_HANDLE_TYPE mutexID)
- */
-static OSAL_RESULT __attribute__((always_inline)) OSAL_MUTEX_Delete(OSAL_MUTEX_HANDLE_TYPE* mutexID)
-{
-  return (OSAL_RESULT_SUCCESS);
-}
-// *****************************************************************************
-/* Function: OSAL_RESULT OSAL_MUTEX_Lock(OSAL_MUTEX_HANDLE_TYPE mutexID, uint16_t waitMS)
- */
-static OSAL_RESULT __attribute__((always_inline)) OSAL_MUTEX_Lock(OSAL_MUTEX_HANDLE_TYPE* mutexID, uint16_t waitMS)
-{
-  if (*mutexID == 1U)
-  {
-    *mutexID = 0;
-    return OSAL_RESULT_SUCCESS;
-  }
-  return OSAL_RESULT_FAIL;
-}
-
-// *****************************************************************************
-/* Function: OSAL_RESULT OSAL_MUTEX_Unlock(OSAL_MUTEX_HANDLE_TYPE mutexID)
- */
-static OSAL_RESULT __attribute__((always_inline)) OSAL_MUTEX_Unlock(OSAL_MUTEX_HANDLE_TYPE* mutexID)
-{
-  *mutexID = 1;
-  return OSAL_RESULT_SUCCESS;
-}
-
-/* MISRAC 2012 deviation block end */
-// *****************************************************************************
-/* MISRA C-2012 Rule 4.12 devaited:1, 21.3 deviated:2 Deviation record ID -
-   H3_MISRAC_2012_R_4_12_DR_1 & H3_MISRAC_2012_R_21_3_DR_1*/
-
 /* Function: void* OSAL_Malloc(size_t size)
  */
 static void* __attribute__((always_inline)) OSAL_Malloc(size_t size)
 {
-    return malloc(size);
+    /* Fixed-size pool blocks instead of the libc heap */
+    return SYS_MEMPOOL_Alloc(size);
 }
 
 // *****************************************************************************
@@ -320,10 +246,9 @@ static void* __attribute__((always_inline)) OSAL_Malloc(size_t size)
  */
 static void __attribute__((always_inline)) OSAL_Free(void* pData)
 {
-    free(pData);
+    SYS_MEMPOOL_Free(pData);
 }
 
-/* MISRAC 2012 deviation block end */
 // Initialization and Diagnostics
 // *****************************************************************************
 
@@ -42,9 +42,66 @@
 #include "device.h"
 #include "interrupts.h"
 
+typedef struct
+{
+    CLOCK_CALLBACK  callback;
+
+    uintptr_t       context;
+
+} CLOCK_CALLBACK_OBJ;
+
+typedef struct
+{
+    /* GCLK0 frequency and the divider that gives it */
+    uint32_t            frequency;
+
+    uint32_t            divider;
+
+    uint32_t            callbackCount;
+
+    CLOCK_CALLBACK_OBJ  callbacks[CLOCK_CALLBACK_MAX];
+
+} CLOCK_OBJECT;
+
+static CLOCK_OBJECT clockObj;
+
+#if defined(CLOCK_DFLL_CLOSED_LOOP)
+
+#if defined(CLOCK_DFLL_REFERENCE_OSC32K)
+#define CLOCK_REFERENCE_READY_Msk   SYSCTRL_INTFLAG_OSC32KRDY_Msk
+#define CLOCK_REFERENCE_SOURCE      (4U)
+#else
+#define CLOCK_REFERENCE_READY_Msk   SYSCTRL_INTFLAG_XOSC32KRDY_Msk
+#define CLOCK_REFERENCE_SOURCE      (5U)
+#endif
+
+/* DFLL48M_REF cycles per reference cycle, rounded: 48005120 Hz */
+#define CLOCK_DFLL_MUL              ((CLOCK_DFLL_FREQUENCY + 16384UL) / 32768UL)
+
+#endif
+
 static void SYSCTRL_Initialize(void)
 {
+#if defined(CLOCK_DFLL_CLOSED_LOOP) && defined(CLOCK_DFLL_REFERENCE_OSC32K)
+    /*Load Calibration Value*/
+    uint32_t calibOsc32k = (((*((uint32_t*)0x00806020U + 1U)) >> 6U ) & 0x7FU);
+
+    SYSCTRL_REGS->SYSCTRL_OSC32K = SYSCTRL_OSC32K_CALIB(calibOsc32k) | SYSCTRL_OSC32K_STARTUP(2U) | SYSCTRL_OSC32K_EN32K_Msk | SYSCTRL_OSC32K_ENABLE_Msk;
+#else
     SYSCTRL_REGS->SYSCTRL_OSC32K = 0x0U;
+#endif
+
+#if defined(CLOCK_DFLL_CLOSED_LOOP)
+#if !defined(CLOCK_DFLL_REFERENCE_OSC32K)
+    /* About 1 s for the crystal to settle */
+    SYSCTRL_REGS->SYSCTRL_XOSC32K = SYSCTRL_XOSC32K_STARTUP(5U) | SYSCTRL_XOSC32K_XTALEN_Msk | SYSCTRL_XOSC32K_EN32K_Msk | SYSCTRL_XOSC32K_ENABLE_Msk;
+#endif
+
+    /* The DFLL starts open loop; SYSCTRL_InterruptHandler closes the loop
+     * once the reference runs, so start-up never waits for it */
+    SYSCTRL_REGS->SYSCTRL_INTFLAG = CLOCK_REFERENCE_READY_Msk;
+    SYSCTRL_REGS->SYSCTRL_INTENSET = CLOCK_REFERENCE_READY_Msk;
+#endif
 }
 
 
@@ -71,12 +128,14 @@ static void DFLL_Initialize(void)
 
     /* Configure DFLL    */
     SYSCTRL_REGS->SYSCTRL_DFLLCTRL = SYSCTRL_DFLLCTRL_ENABLE_Msk ;
+}
 
+static void DFLL_WaitReady(void)
+{
     while((SYSCTRL_REGS->SYSCTRL_PCLKSR & SYSCTRL_PCLKSR_DFLLRDY_Msk) != SYSCTRL_PCLKSR_DFLLRDY_Msk)
     {
         /* Waiting for DFLL to be ready */
     }
-
 }
 
 
@@ -95,20 +154,32 @@ static void GCLK0_Initialize(void)
 
 
 
-void CLOCK_Initialize (void)
+void CLOCK_InitializeStart (void)
 {
     /* Function to Initialize the Oscillators */
     SYSCTRL_Initialize();
 
     DFLL_Initialize();
+}
+
+void CLOCK_InitializeComplete (void)
+{
+    DFLL_WaitReady();
     GCLK0_Initialize();
 
+    clockObj.frequency = CLOCK_DFLL_FREQUENCY;
+    clockObj.divider = 1U;
+
 
     /* Selection of the Generator and write Lock for SERCOM0_CORE */
     GCLK_REGS->GCLK_CLKCTRL = GCLK_CLKCTRL_ID(20U) | GCLK_CLKCTRL_GEN(0x0U)  | GCLK_CLKCTRL_CLKEN_Msk;
+    /* Selection of the Generator and write Lock for TCC2 TC3 */
+    GCLK_REGS->GCLK_CLKCTRL = GCLK_CLKCTRL_ID(27U) | GCLK_CLKCTRL_GEN(0x0U)  | GCLK_CLKCTRL_CLKEN_Msk;
+    /* Selection of the Generator and write Lock for TC4 TC5 */
+    GCLK_REGS->GCLK_CLKCTRL = GCLK_CLKCTRL_ID(28U) | GCLK_CLKCTRL_GEN(0x0U)  | GCLK_CLKCTRL_CLKEN_Msk;
 
     /* Configure the APBC Bridge Clocks */
-    PM_REGS->PM_APBCMASK = 0x10004U;
+    PM_REGS->PM_APBCMASK = 0x13804U;
 
 
     /*Disable RC oscillator*/
@@ -116,3 +187,126 @@ void CLOCK_Initialize (void)
 
 
 }
+
+void CLOCK_Initialize (void)
+{
+    CLOCK_InitializeStart();
+    CLOCK_InitializeComplete();
+}
+
+uint32_t CLOCK_FrequencyGet (void)
+{
+    return clockObj.frequency;
+}
+
+bool CLOCK_FrequencySet (uint32_t frequency)
+{
+    uint32_t divider;
+    uint32_t newFrequency;
+    uint32_t index;
+    uint32_t processorStatus;
+    bool isAccepted = true;
+
+    if (frequency == 0U)
+    {
+        return false;
+    }
+
+    divider = (CLOCK_DFLL_FREQUENCY + frequency - 1U) / frequency;
+    if (divider > CLOCK_GCLK0_DIVIDER_MAX)
+    {
+        divider = CLOCK_GCLK0_DIVIDER_MAX;
+    }
+    newFrequency = CLOCK_DFLL_FREQUENCY / divider;
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    if (divider != clockObj.divider)
+    {
+        for (index = 0U; (index < clockObj.callbackCount) && isAccepted; index++)
+        {
+            isAccepted = clockObj.callbacks[index].callback(CLOCK_EVENT_CHANGE_PENDING, newFrequency, clockObj.callbacks[index].context);
+        }
+
+        if (isAccepted)
+        {
+            GCLK_REGS->GCLK_GENDIV = GCLK_GENDIV_ID(0U) | GCLK_GENDIV_DIV(divider);
+
+            while((GCLK_REGS->GCLK_STATUS & GCLK_STATUS_SYNCBUSY_Msk) == GCLK_STATUS_SYNCBUSY_Msk)
+            {
+                /* wait for the Generator 0 synchronization */
+            }
+
+            clockObj.divider = divider;
+            clockObj.frequency = newFrequency;
+
+            for (index = 0U; index < clockObj.callbackCount; index++)
+            {
+                (void)clockObj.callbacks[index].callback(CLOCK_EVENT_CHANGED, newFrequency, clockObj.callbacks[index].context);
+            }
+        }
+    }
+
+    __set_PRIMASK(processorStatus);
+
+    return isAccepted;
+}
+
+bool CLOCK_CallbackRegister (CLOCK_CALLBACK callback, uintptr_t context)
+{
+    if ((callback == NULL) || (clockObj.callbackCount >= CLOCK_CALLBACK_MAX))
+    {
+        return false;
+    }
+
+    clockObj.callbacks[clockObj.callbackCount].callback = callback;
+    clockObj.callbacks[clockObj.callbackCount].context = context;
+    clockObj.callbackCount++;
+
+    return true;
+}
+
+bool CLOCK_DFLLIsLocked (void)
+{
+    uint32_t lockMask = SYSCTRL_PCLKSR_DFLLLCKC_Msk | SYSCTRL_PCLKSR_DFLLLCKF_Msk;
+
+    return (((SYSCTRL_REGS->SYSCTRL_DFLLCTRL & SYSCTRL_DFLLCTRL_MODE_Msk) != 0U) &&
+            ((SYSCTRL_REGS->SYSCTRL_PCLKSR & lockMask) == lockMask));
+}
+
+#if defined(CLOCK_DFLL_CLOSED_LOOP)
+void SYSCTRL_InterruptHandler (void)
+{
+    if ((SYSCTRL_REGS->SYSCTRL_INTFLAG & CLOCK_REFERENCE_READY_Msk) == 0U)
+    {
+        return;
+    }
+
+    SYSCTRL_REGS->SYSCTRL_INTENCLR = CLOCK_REFERENCE_READY_Msk;
+    SYSCTRL_REGS->SYSCTRL_INTFLAG = CLOCK_REFERENCE_READY_Msk;
+
+    /* Generator 1 passes the 32 kHz reference to DFLL48M_REF */
+    GCLK_REGS->GCLK_GENDIV = GCLK_GENDIV_ID(1U) | GCLK_GENDIV_DIV(1U);
+    GCLK_REGS->GCLK_GENCTRL = GCLK_GENCTRL_SRC(CLOCK_REFERENCE_SOURCE) | GCLK_GENCTRL_GENEN_Msk | GCLK_GENCTRL_ID(1U);
+
+    while((GCLK_REGS->GCLK_STATUS & GCLK_STATUS_SYNCBUSY_Msk) == GCLK_STATUS_SYNCBUSY_Msk)
+    {
+        /* wait for the Generator 1 synchronization */
+    }
+
+    /* Selection of the Generator and write Lock for DFLL48M_REF */
+    GCLK_REGS->GCLK_CLKCTRL = GCLK_CLKCTRL_ID(0U) | GCLK_CLKCTRL_GEN(0x1U)  | GCLK_CLKCTRL_CLKEN_Msk;
+
+    /* The loop starts from the calibrated open-loop value. Small steps keep
+     * GCLK0, and the baud rates derived from it, within a fraction of a
+     * percent while it locks. */
+    DFLL_WaitReady();
+    SYSCTRL_REGS->SYSCTRL_DFLLMUL = SYSCTRL_DFLLMUL_CSTEP(1U) | SYSCTRL_DFLLMUL_FSTEP(16U) | SYSCTRL_DFLLMUL_MUL(CLOCK_DFLL_MUL);
+
+    DFLL_WaitReady();
+    SYSCTRL_REGS->SYSCTRL_DFLLCTRL = SYSCTRL_DFLLCTRL_MODE_Msk | SYSCTRL_DFLLCTRL_ENABLE_Msk;
+
+    DFLL_WaitReady();
+}
+#endif
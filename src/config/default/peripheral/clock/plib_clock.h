@@ -52,6 +52,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include "configuration.h"
 
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus // Provide C++ Compatibility
@@ -66,6 +67,30 @@ extern "C" {
 // *****************************************************************************
 // *****************************************************************************
 
+/* DFLL48M output that GCLK0 divides. Closed loop it runs at the nearest
+   multiple of the 32.768 kHz reference, 48005120 Hz, which is within the
+   open-loop accuracy of this nominal value. */
+#define CLOCK_DFLL_FREQUENCY        (48000000UL)
+
+/* GENDIV.DIV of generator 0 is 8 bits wide */
+#define CLOCK_GCLK0_DIVIDER_MAX     (255UL)
+
+#ifndef CLOCK_CALLBACK_MAX
+#define CLOCK_CALLBACK_MAX          (4U)
+#endif
+
+typedef enum
+{
+    /* GCLK0 is about to change; the callback returns false to refuse it */
+    CLOCK_EVENT_CHANGE_PENDING,
+
+    /* GCLK0 runs at the new frequency; the return value is ignored */
+    CLOCK_EVENT_CHANGED
+
+} CLOCK_EVENT;
+
+typedef bool (*CLOCK_CALLBACK)( CLOCK_EVENT event, uint32_t frequency, uintptr_t context );
+
 
 // *****************************************************************************
 // *****************************************************************************
@@ -75,6 +100,34 @@ extern "C" {
 
 void CLOCK_Initialize (void);
 
+/* CLOCK_Initialize in two halves: Start enables the DFLL without waiting for
+   it, Complete waits for it and switches GCLK0 and the peripheral clocks.
+   Code in between runs from the reset clock and must not use GCLK0. */
+void CLOCK_InitializeStart (void);
+
+void CLOCK_InitializeComplete (void);
+
+/* GCLK0 frequency, which clocks the CPU, SysTick, SERCOM0, TC3 and TC4 */
+uint32_t CLOCK_FrequencyGet (void);
+
+/* Divides the DFLL for GCLK0 by the smallest divider that gives at most
+   frequency. Every registered callback first gets CLOCK_EVENT_CHANGE_PENDING
+   and may refuse; then the divider changes and they get CLOCK_EVENT_CHANGED.
+   Interrupts are masked throughout. Returns false when refused. */
+bool CLOCK_FrequencySet (uint32_t frequency);
+
+/* Adds a callback for GCLK0 changes, called in the order of registration.
+   Returns false when CLOCK_CALLBACK_MAX callbacks are registered. */
+bool CLOCK_CallbackRegister (CLOCK_CALLBACK callback, uintptr_t context);
+
+/* True once the DFLL runs closed loop and has locked to the reference */
+bool CLOCK_DFLLIsLocked (void);
+
+#if defined(CLOCK_DFLL_CLOSED_LOOP)
+/* Switches the DFLL to closed loop when the 32 kHz reference is ready */
+void SYSCTRL_InterruptHandler (void);
+#endif
+
 #ifdef __cplusplus // Provide C++ Compatibility
 }
 #endif
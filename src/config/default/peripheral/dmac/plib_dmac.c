@@ -0,0 +1,423 @@
+/*******************************************************************************
+  Direct Memory Access Controller (DMAC) PLIB
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_dmac.c
+
+  Summary
+    Source for DMAC peripheral library interface Implementation.
+
+  Description
+    This file defines the interface to the DMAC peripheral library. This
+    library provides access to and control of the DMAC controller.
+
+  Remarks:
+    None.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "interrupts.h"
+#include "plib_dmac.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* DMAC channels object configuration structure */
+typedef struct
+{
+    uint8_t                inUse;
+
+    DMAC_CHANNEL_CALLBACK  callback;
+
+    uintptr_t              context;
+
+    bool                   busyStatus;
+
+} DMAC_CH_OBJECT ;
+
+/* Initial write back memory section for DMAC */
+static dmac_descriptor_registers_t write_back_section[DMAC_CHANNELS_NUMBER] __ALIGNED(16);
+
+/* Descriptor section for DMAC */
+static dmac_descriptor_registers_t descriptor_section[DMAC_CHANNELS_NUMBER] __ALIGNED(16);
+
+/* DMAC Channels object information structure */
+volatile static DMAC_CH_OBJECT dmacChannelObj[DMAC_CHANNELS_NUMBER];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: DMAC PLib Interface Implementations
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+This function initializes the DMAC controller of the device.
+********************************************************************************/
+
+void DMAC_Initialize( void )
+{
+    uint32_t channel = 0U;
+
+    /* Initialize DMAC Channel objects */
+    for(channel = 0U; channel < DMAC_CHANNELS_NUMBER; channel++)
+    {
+        dmacChannelObj[channel].inUse = 0U;
+        dmacChannelObj[channel].callback = NULL;
+        dmacChannelObj[channel].context = 0U;
+        dmacChannelObj[channel].busyStatus = false;
+    }
+
+    /* Update the Base address and Write Back address register */
+    DMAC_REGS->DMAC_BASEADDR = (uint32_t) descriptor_section;
+    DMAC_REGS->DMAC_WRBADDR  = (uint32_t) write_back_section;
+
+    /* Update the Priority Control register */
+    DMAC_REGS->DMAC_PRICTRL0 = DMAC_PRICTRL0_LVLPRI0(0UL) | DMAC_PRICTRL0_RRLVLEN0_Msk | DMAC_PRICTRL0_LVLPRI1(0UL) | DMAC_PRICTRL0_LVLPRI2(0UL) | DMAC_PRICTRL0_LVLPRI3(0UL);
+
+    /***************** Configure DMA channel 0 ********************/
+
+    /* SERCOM0 TX: memory to SERCOM_DATA, one beat per DRE trigger */
+    DMAC_REGS->DMAC_CHID = 0U;
+
+    DMAC_REGS->DMAC_CHCTRLB = DMAC_CHCTRLB_TRIGACT_BEAT | DMAC_CHCTRLB_TRIGSRC((uint32_t)SERCOM0_DMAC_ID_TX) | DMAC_CHCTRLB_LVL(0UL);
+
+    descriptor_section[0].DMAC_BTCTRL = (uint16_t)(DMAC_BTCTRL_BLOCKACT_INT | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_SRCINC_Msk);
+
+    dmacChannelObj[0].inUse = 1U;
+
+    DMAC_REGS->DMAC_CHINTENSET = (uint8_t)(DMAC_CHINTENSET_TERR_Msk | DMAC_CHINTENSET_TCMPL_Msk);
+
+    /***************** Configure DMA channel 1 ********************/
+
+    /* SERCOM0 RX: SERCOM_DATA to memory, one beat per RXC trigger. Runs at a
+     * higher level than TX so a long transmit burst cannot delay reception. */
+    DMAC_REGS->DMAC_CHID = 1U;
+
+    DMAC_REGS->DMAC_CHCTRLB = DMAC_CHCTRLB_TRIGACT_BEAT | DMAC_CHCTRLB_TRIGSRC((uint32_t)SERCOM0_DMAC_ID_RX) | DMAC_CHCTRLB_LVL(1UL);
+
+    descriptor_section[1].DMAC_BTCTRL = (uint16_t)(DMAC_BTCTRL_BLOCKACT_NOACT | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_DSTINC_Msk);
+
+    dmacChannelObj[1].inUse = 1U;
+
+    DMAC_REGS->DMAC_CHINTENSET = (uint8_t)(DMAC_CHINTENSET_TERR_Msk | DMAC_CHINTENSET_TCMPL_Msk);
+
+    /* Enable the DMAC module & Priority Level x Enable */
+    DMAC_REGS->DMAC_CTRL = (uint16_t)(DMAC_CTRL_DMAENABLE_Msk | DMAC_CTRL_LVLEN0_Msk | DMAC_CTRL_LVLEN1_Msk | DMAC_CTRL_LVLEN2_Msk | DMAC_CTRL_LVLEN3_Msk);
+}
+
+/*******************************************************************************
+    This function schedules a DMA transfer on the specified DMA channel.
+    srcAddr/destAddr are the start addresses; the descriptor holds the end
+    address of any incrementing side, as required by the DMAC.
+********************************************************************************/
+
+bool DMAC_ChannelTransfer( DMAC_CHANNEL channel, const void *srcAddr, const void *destAddr, size_t blockSize )
+{
+    uint8_t beatSize = 0U;
+    uint16_t btctrl = 0U;
+    bool returnStatus = false;
+    uint32_t processorStatus;
+
+    if (dmacChannelObj[channel].busyStatus == false)
+    {
+        btctrl = descriptor_section[channel].DMAC_BTCTRL;
+
+        /* Get a copy of the beat size */
+        beatSize = (uint8_t)((btctrl & DMAC_BTCTRL_BEATSIZE_Msk) >> DMAC_BTCTRL_BEATSIZE_Pos);
+
+        /* Block size must be a multiple of the beat size and fit in BTCNT */
+        if (((blockSize & ((1UL << beatSize) - 1UL)) == 0U) && ((blockSize >> beatSize) > 0U) && ((blockSize >> beatSize) <= 0xFFFFU))
+        {
+            dmacChannelObj[channel].busyStatus = true;
+
+            /* Set source address */
+            if ((btctrl & DMAC_BTCTRL_SRCINC_Msk) == DMAC_BTCTRL_SRCINC_Msk)
+            {
+                descriptor_section[channel].DMAC_SRCADDR = ((uint32_t)srcAddr + blockSize);
+            }
+            else
+            {
+                descriptor_section[channel].DMAC_SRCADDR = (uint32_t)srcAddr;
+            }
+
+            /* Set destination address */
+            if ((btctrl & DMAC_BTCTRL_DSTINC_Msk) == DMAC_BTCTRL_DSTINC_Msk)
+            {
+                descriptor_section[channel].DMAC_DSTADDR = ((uint32_t)destAddr + blockSize);
+            }
+            else
+            {
+                descriptor_section[channel].DMAC_DSTADDR = (uint32_t)destAddr;
+            }
+
+            /* Single block transfer */
+            descriptor_section[channel].DMAC_DESCADDR = 0U;
+
+            /* Set block size. The write back copy is only refreshed once the
+             * channel is granted, so preset it for DMAC_ChannelGetTransferredCount. */
+            descriptor_section[channel].DMAC_BTCNT = (uint16_t)(blockSize >> beatSize);
+            write_back_section[channel].DMAC_BTCNT = descriptor_section[channel].DMAC_BTCNT;
+
+            /* CHID is shared with the interrupt handler */
+            processorStatus = __get_PRIMASK();
+            __disable_irq();
+
+            DMAC_REGS->DMAC_CHID = (uint8_t)channel;
+
+            DMAC_REGS->DMAC_CHCTRLA |= (uint8_t)DMAC_CHCTRLA_ENABLE_Msk;
+
+            /* Verify if Trigger source is Software Trigger */
+            if (((DMAC_REGS->DMAC_CHCTRLB & DMAC_CHCTRLB_TRIGSRC_Msk) >> DMAC_CHCTRLB_TRIGSRC_Pos) == 0x00U)
+            {
+                /* Trigger the DMA transfer */
+                DMAC_REGS->DMAC_SWTRIGCTRL |= (1UL << (uint32_t)channel);
+            }
+
+            __set_PRIMASK(processorStatus);
+
+            returnStatus = true;
+        }
+    }
+
+    return returnStatus;
+}
+
+/*******************************************************************************
+    This function submits a list of DMA transfers. The first descriptor is
+    copied into the channel descriptor; the following ones are fetched from
+    channelDesc->DMAC_DESCADDR and must be 16-byte aligned. A descriptor that
+    links back to itself gives a circular transfer.
+********************************************************************************/
+
+bool DMAC_ChannelLinkedListTransfer( DMAC_CHANNEL channel, dmac_descriptor_registers_t *channelDesc )
+{
+    bool returnStatus = false;
+    uint32_t processorStatus;
+
+    if ((channelDesc != NULL) && (dmacChannelObj[channel].busyStatus == false))
+    {
+        dmacChannelObj[channel].busyStatus = true;
+
+        descriptor_section[channel].DMAC_BTCTRL   = channelDesc->DMAC_BTCTRL;
+        descriptor_section[channel].DMAC_BTCNT    = channelDesc->DMAC_BTCNT;
+        descriptor_section[channel].DMAC_SRCADDR  = channelDesc->DMAC_SRCADDR;
+        descriptor_section[channel].DMAC_DSTADDR  = channelDesc->DMAC_DSTADDR;
+        descriptor_section[channel].DMAC_DESCADDR = channelDesc->DMAC_DESCADDR;
+
+        write_back_section[channel].DMAC_BTCNT = channelDesc->DMAC_BTCNT;
+
+        processorStatus = __get_PRIMASK();
+        __disable_irq();
+
+        DMAC_REGS->DMAC_CHID = (uint8_t)channel;
+
+        DMAC_REGS->DMAC_CHCTRLA |= (uint8_t)DMAC_CHCTRLA_ENABLE_Msk;
+
+        /* Verify if Trigger source is Software Trigger */
+        if (((DMAC_REGS->DMAC_CHCTRLB & DMAC_CHCTRLB_TRIGSRC_Msk) >> DMAC_CHCTRLB_TRIGSRC_Pos) == 0x00U)
+        {
+            /* Trigger the DMA transfer */
+            DMAC_REGS->DMAC_SWTRIGCTRL |= (1UL << (uint32_t)channel);
+        }
+
+        __set_PRIMASK(processorStatus);
+
+        returnStatus = true;
+    }
+
+    return returnStatus;
+}
+
+/*******************************************************************************
+    This function disables the specified DMAC channel.
+********************************************************************************/
+
+void DMAC_ChannelDisable( DMAC_CHANNEL channel )
+{
+    uint32_t processorStatus = __get_PRIMASK();
+
+    __disable_irq();
+
+    /* Set the DMA Channel ID */
+    DMAC_REGS->DMAC_CHID = (uint8_t)channel;
+
+    /* Disable the DMA channel */
+    DMAC_REGS->DMAC_CHCTRLA &= (uint8_t)(~DMAC_CHCTRLA_ENABLE_Msk);
+
+    while((DMAC_REGS->DMAC_CHCTRLA & DMAC_CHCTRLA_ENABLE_Msk) != 0U)
+    {
+        /* Wait till the channel is disabled */
+    }
+
+    /* Drop any completion that raced with the disable */
+    DMAC_REGS->DMAC_CHINTFLAG = (uint8_t)(DMAC_CHINTFLAG_TERR_Msk | DMAC_CHINTFLAG_TCMPL_Msk | DMAC_CHINTFLAG_SUSP_Msk);
+
+    dmacChannelObj[channel].busyStatus = false;
+
+    __set_PRIMASK(processorStatus);
+}
+
+/*******************************************************************************
+    This function returns the number of beats already transferred by the
+    current (or last) transfer of the channel.
+********************************************************************************/
+
+uint16_t DMAC_ChannelGetTransferredCount( DMAC_CHANNEL channel )
+{
+    uint32_t active = DMAC_REGS->DMAC_ACTIVE;
+    uint16_t remaining = write_back_section[channel].DMAC_BTCNT;
+
+    /* The write back section holds the remaining beats of a channel that is
+     * waiting for its trigger; the executing channel reports through ACTIVE. */
+    if (((active & DMAC_ACTIVE_ABUSY_Msk) != 0U) && (((active & DMAC_ACTIVE_ID_Msk) >> DMAC_ACTIVE_ID_Pos) == (uint32_t)channel))
+    {
+        remaining = (uint16_t)((active & DMAC_ACTIVE_BTCNT_Msk) >> DMAC_ACTIVE_BTCNT_Pos);
+    }
+
+    return (uint16_t)(descriptor_section[channel].DMAC_BTCNT - remaining);
+}
+
+/*******************************************************************************
+    This function function allows a DMAC PLIB client to set an event handler.
+********************************************************************************/
+
+void DMAC_ChannelCallbackRegister( DMAC_CHANNEL channel, const DMAC_CHANNEL_CALLBACK eventHandler, const uintptr_t contextHandle )
+{
+    dmacChannelObj[channel].callback = eventHandler;
+
+    dmacChannelObj[channel].context  = contextHandle;
+}
+
+/*******************************************************************************
+    This function returns the status of the channel.
+********************************************************************************/
+
+bool DMAC_ChannelIsBusy( DMAC_CHANNEL channel )
+{
+    return (dmacChannelObj[channel].busyStatus);
+}
+
+/*******************************************************************************
+    This function returns the channel settings (descriptor BTCTRL).
+********************************************************************************/
+
+DMAC_CHANNEL_CONFIG DMAC_ChannelSettingsGet( DMAC_CHANNEL channel )
+{
+    return (DMAC_CHANNEL_CONFIG)descriptor_section[channel].DMAC_BTCTRL;
+}
+
+/*******************************************************************************
+    This function changes the channel settings. The descriptor stays valid and
+    keeps raising the block interrupt; the channel must be idle.
+********************************************************************************/
+
+bool DMAC_ChannelSettingsSet( DMAC_CHANNEL channel, DMAC_CHANNEL_CONFIG setting )
+{
+    bool settingsStatus = false;
+
+    if (dmacChannelObj[channel].busyStatus == false)
+    {
+        descriptor_section[channel].DMAC_BTCTRL = (uint16_t)(setting | DMAC_BTCTRL_VALID_Msk);
+
+        settingsStatus = true;
+    }
+
+    return settingsStatus;
+}
+
+/*******************************************************************************
+    This function handles the DMA interrupt events.
+*/
+void DMAC_InterruptHandler( void )
+{
+    volatile DMAC_CH_OBJECT  *dmacChObj = NULL;
+    uint8_t channel = 0U;
+    uint8_t channelId = 0U;
+    uint8_t chanIntFlagStatus = 0U;
+    DMAC_TRANSFER_EVENT event = DMAC_TRANSFER_EVENT_ERROR;
+
+    /* Get active channel number */
+    channel = (uint8_t)(DMAC_REGS->DMAC_INTPEND & DMAC_INTPEND_ID_Msk);
+
+    dmacChObj = &dmacChannelObj[channel];
+
+    /* Save channel ID */
+    channelId = DMAC_REGS->DMAC_CHID;
+
+    /* Update the DMAC channel ID */
+    DMAC_REGS->DMAC_CHID = channel;
+
+    /* Read the interrupt flag status */
+    chanIntFlagStatus = DMAC_REGS->DMAC_CHINTFLAG & DMAC_REGS->DMAC_CHINTENSET;
+
+    /* Clear the interrupt flags before the callback can start a new transfer */
+    DMAC_REGS->DMAC_CHINTFLAG = chanIntFlagStatus;
+
+    /* Restore channel ID */
+    DMAC_REGS->DMAC_CHID = channelId;
+
+    if ((chanIntFlagStatus & DMAC_CHINTFLAG_TERR_Msk) != 0U)
+    {
+        /* DMA channel transfer error */
+        event = DMAC_TRANSFER_EVENT_ERROR;
+
+        dmacChObj->busyStatus = false;
+    }
+    else if ((chanIntFlagStatus & DMAC_CHINTFLAG_TCMPL_Msk) != 0U)
+    {
+        /* DMA channel transfer complete. A linked descriptor keeps the channel running. */
+        event = DMAC_TRANSFER_EVENT_COMPLETE;
+
+        if (write_back_section[channel].DMAC_DESCADDR == 0U)
+        {
+            dmacChObj->busyStatus = false;
+        }
+    }
+    else
+    {
+        /* Suspend is not used */
+    }
+
+    /* Execute the callback function */
+    if ((chanIntFlagStatus != 0U) && (dmacChObj->callback != NULL))
+    {
+        dmacChObj->callback (event, dmacChObj->context);
+    }
+}
@@ -39,6 +39,7 @@
 *******************************************************************************/
 
 #include "device.h"
+#include "configuration.h"
 #include "plib_nvic.h"
 
 
@@ -57,6 +58,23 @@ void NVIC_Initialize( void )
 
     /* Enable the interrupt sources and configure the priorities as configured
      * from within the "Interrupt Manager" of MHC. */
+    NVIC_SetPriority(SysTick_IRQn, SYSTICK_INT_PRIORITY);
+#if defined(CLOCK_DFLL_CLOSED_LOOP)
+    NVIC_SetPriority(SYSCTRL_IRQn, SYSCTRL_INT_PRIORITY);
+    NVIC_EnableIRQ(SYSCTRL_IRQn);
+#endif
+    NVIC_SetPriority(NVMCTRL_IRQn, NVMCTRL_INT_PRIORITY);
+    NVIC_EnableIRQ(NVMCTRL_IRQn);
+    NVIC_SetPriority(DMAC_IRQn, DMAC_INT_PRIORITY);
+    NVIC_EnableIRQ(DMAC_IRQn);
+    NVIC_SetPriority(TC3_IRQn, TC3_INT_PRIORITY);
+    NVIC_EnableIRQ(TC3_IRQn);
+    NVIC_SetPriority(TC4_IRQn, TC4_INT_PRIORITY);
+    NVIC_EnableIRQ(TC4_IRQn);
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+    NVIC_SetPriority(SERCOM0_IRQn, SERCOM0_USART_INT_PRIORITY);
+    NVIC_EnableIRQ(SERCOM0_IRQn);
+#endif
 
 
 
@@ -58,6 +58,66 @@
 // *****************************************************************************
 // *****************************************************************************
 
+volatile static NVMCTRL_CALLBACK_OBJECT nvmctrlCallbackObj;
+
+/* Copies whole words with LDM/STM, eight words per pass. Both pointers must
+ * be word aligned; the page buffer only accepts 16 or 32-bit writes. Forced
+ * inline so the RAMFUNC page buffer fill never calls back into flash. */
+__STATIC_FORCEINLINE void NVMCTRL_WordCopy( uint32_t *destination, const uint32_t *source, uint32_t words )
+{
+    while (words >= 8U)
+    {
+        __asm volatile (
+            "ldmia %[src]!, {r3, r4, r5, r6}\n"
+            "stmia %[dst]!, {r3, r4, r5, r6}\n"
+            "ldmia %[src]!, {r3, r4, r5, r6}\n"
+            "stmia %[dst]!, {r3, r4, r5, r6}\n"
+            : [dst] "+l" (destination), [src] "+l" (source)
+            :
+            : "r3", "r4", "r5", "r6", "memory");
+        words -= 8U;
+    }
+
+    if (words >= 4U)
+    {
+        __asm volatile (
+            "ldmia %[src]!, {r3, r4, r5, r6}\n"
+            "stmia %[dst]!, {r3, r4, r5, r6}\n"
+            : [dst] "+l" (destination), [src] "+l" (source)
+            :
+            : "r3", "r4", "r5", "r6", "memory");
+        words -= 4U;
+    }
+
+    while (words > 0U)
+    {
+        *destination = *source;
+        destination++;
+        source++;
+        words--;
+    }
+}
+
+/* Fills the page buffer from data that may not be word aligned. Runs from
+ * SRAM, so the copy loops are not slowed by flash wait states. */
+static RAMFUNC void NVMCTRL_PageBufferFill( uint32_t *pageBuffer, const uint32_t *data, uint32_t words )
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint32_t i;
+
+    if (((uint32_t)data & 3U) == 0U)
+    {
+        NVMCTRL_WordCopy(pageBuffer, data, words);
+    }
+    else
+    {
+        for (i = 0U; i < words; i++)
+        {
+            pageBuffer[i] = (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+            bytes = &bytes[4];
+        }
+    }
+}
 
 void NVMCTRL_Initialize(void)
 {
@@ -71,21 +131,27 @@ void NVMCTRL_CacheInvalidate(void)
 bool NVMCTRL_Read( uint32_t *data, uint32_t length, const uint32_t address )
 {
     uint32_t *paddress = (uint32_t*)address;
-    (void)memcpy(data, paddress, length);
+    uint32_t words = length / 4U;
+
+    if ((((uint32_t)data | address) & 3U) == 0U)
+    {
+        NVMCTRL_WordCopy(data, paddress, words);
+        (void)memcpy(&data[words], &paddress[words], length & 3U);
+    }
+    else
+    {
+        (void)memcpy(data, paddress, length);
+    }
+
     return true;
 }
 
 bool NVMCTRL_PageBufferWrite( uint32_t *data, const uint32_t address)
 {
-    uint32_t i;
     uint32_t * paddress = (uint32_t *)address;
 
     /* writing 32-bit data into the given address */
-    for (i = 0U; i < (NVMCTRL_FLASH_PAGESIZE/4U); i++)
-    {
-        *paddress = *(data + i);
-        paddress++;
-    }
+    NVMCTRL_PageBufferFill(paddress, data, NVMCTRL_FLASH_PAGESIZE/4U);
 
     return true;
 }
@@ -100,27 +166,25 @@ bool NVMCTRL_PageBufferCommit( const uint32_t address)
 
     NVMCTRL_REGS->NVMCTRL_CTRLA = (uint16_t)(command | NVMCTRL_CTRLA_CMDEX_KEY);
 
+    NVMCTRL_REGS->NVMCTRL_INTENSET = NVMCTRL_INTENSET_READY_Msk;
 
     return true;
 }
 
 bool NVMCTRL_PageWrite( uint32_t *data, const uint32_t address )
 {
-    uint32_t i;
     uint32_t * paddress = (uint32_t *)address;
 
     /* writing 32-bit data into the given address */
-    for (i = 0U; i < (NVMCTRL_FLASH_PAGESIZE/4U); i++)
-    {
-        *paddress = *(data + i);
-        paddress++;
-    }
+    NVMCTRL_PageBufferFill(paddress, data, NVMCTRL_FLASH_PAGESIZE/4U);
 
      /* Set address and command */
     NVMCTRL_REGS->NVMCTRL_ADDR = address >> 1U;
 
     NVMCTRL_REGS->NVMCTRL_CTRLA = (uint16_t)(NVMCTRL_CTRLA_CMD_WP_Val | NVMCTRL_CTRLA_CMDEX_KEY);
 
+    NVMCTRL_REGS->NVMCTRL_INTENSET = NVMCTRL_INTENSET_READY_Msk;
+
     return true;
 }
 
@@ -131,29 +195,27 @@ bool NVMCTRL_RowErase( uint32_t address )
 
     NVMCTRL_REGS->NVMCTRL_CTRLA = (uint16_t)(NVMCTRL_CTRLA_CMD_ER_Val | NVMCTRL_CTRLA_CMDEX_KEY);
 
+    NVMCTRL_REGS->NVMCTRL_INTENSET = NVMCTRL_INTENSET_READY_Msk;
+
     return true;
 }
 
 bool NVMCTRL_USER_ROW_PageWrite( uint32_t *data, const uint32_t address )
 {
-    uint32_t i;
     uint32_t * paddress = (uint32_t *)address;
     bool pagewrite_val = false;
 
     if ((address >= NVMCTRL_USERROW_START_ADDRESS) && (address <= ((NVMCTRL_USERROW_START_ADDRESS + NVMCTRL_USERROW_SIZE) - NVMCTRL_USERROW_PAGESIZE)))
     {
         /* writing 32-bit data into the given address */
-        for (i = 0U; i < (NVMCTRL_USERROW_PAGESIZE/4U); i++)
-        {
-            *paddress = data[i];
-                      paddress++;
-        }
+        NVMCTRL_PageBufferFill(paddress, data, NVMCTRL_USERROW_PAGESIZE/4U);
 
         /* Set address and command */
         NVMCTRL_REGS->NVMCTRL_ADDR = address >> 1U;
 
         NVMCTRL_REGS->NVMCTRL_CTRLA = NVMCTRL_CTRLA_CMD_WAP_Val | NVMCTRL_CTRLA_CMDEX_KEY;
 
+        NVMCTRL_REGS->NVMCTRL_INTENSET = NVMCTRL_INTENSET_READY_Msk;
 
         pagewrite_val = true;
     }
@@ -171,6 +233,7 @@ bool NVMCTRL_USER_ROW_RowErase( uint32_t address )
 
         NVMCTRL_REGS->NVMCTRL_CTRLA = NVMCTRL_CTRLA_CMD_EAR_Val | NVMCTRL_CTRLA_CMDEX_KEY;
 
+        NVMCTRL_REGS->NVMCTRL_INTENSET = NVMCTRL_INTENSET_READY_Msk;
 
         rowerase = true;
     }
@@ -218,3 +281,23 @@ void NVMCTRL_SecurityBitSet(void)
 {
     NVMCTRL_REGS->NVMCTRL_CTRLA = (uint16_t)(NVMCTRL_CTRLA_CMD_SSB_Val | NVMCTRL_CTRLA_CMDEX_KEY);
 }
+
+void NVMCTRL_CallbackRegister( NVMCTRL_CALLBACK callback, uintptr_t context )
+{
+    /* Register callback function */
+    nvmctrlCallbackObj.callback_fn = callback;
+    nvmctrlCallbackObj.context = context;
+}
+
+void NVMCTRL_InterruptHandler( void )
+{
+    /* READY stays set while idle, so the interrupt is armed per command */
+    NVMCTRL_REGS->NVMCTRL_INTENCLR = NVMCTRL_INTENCLR_READY_Msk;
+
+    if(nvmctrlCallbackObj.callback_fn != NULL)
+    {
+        uintptr_t context = nvmctrlCallbackObj.context;
+
+        nvmctrlCallbackObj.callback_fn(context);
+    }
+}
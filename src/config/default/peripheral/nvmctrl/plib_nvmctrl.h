@@ -83,6 +83,14 @@
 
 typedef uint16_t NVMCTRL_ERROR;
 
+typedef void (*NVMCTRL_CALLBACK)(uintptr_t context);
+
+typedef struct
+{
+    NVMCTRL_CALLBACK callback_fn;
+    uintptr_t context;
+}NVMCTRL_CALLBACK_OBJECT;
+
 
 void NVMCTRL_Initialize(void);
 
@@ -114,6 +122,10 @@ bool NVMCTRL_USER_ROW_RowErase( uint32_t address );
 
 void NVMCTRL_CacheInvalidate ( void );
 
+void NVMCTRL_CallbackRegister( NVMCTRL_CALLBACK callback, uintptr_t context );
+
+void NVMCTRL_InterruptHandler( void );
+
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus // Provide C++ Compatibility
 }
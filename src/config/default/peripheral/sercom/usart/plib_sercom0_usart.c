@@ -50,6 +50,13 @@
 
 #include "interrupts.h"
 #include "plib_sercom0_usart.h"
+#include "peripheral/clock/plib_clock.h"
+#if defined(SERCOM0_USART_TX_DMA_CHANNEL) || defined(SERCOM0_USART_RX_DMA_CHANNEL)
+#include "peripheral/dmac/plib_dmac.h"
+#endif
+#ifdef SERCOM0_USART_RX_DMA_CHANNEL
+#include "peripheral/tc/plib_tc3.h"
+#endif
 
 // *****************************************************************************
 // *****************************************************************************
@@ -61,6 +68,46 @@
 /* SERCOM0 USART baud value for 115200 Hz baud rate */
 #define SERCOM0_USART_INT_BAUD_VALUE            (63019UL)
 
+/* Baud rate, kept to recompute BAUD when GCLK0 changes */
+static uint32_t sercom0USARTBaudRate;
+
+/* BAUD and CTRLA.SAMPR for the GCLK0 frequency being switched to */
+static uint32_t sercom0USARTPendingBaudValue;
+static uint32_t sercom0USARTPendingSampleRate;
+
+/* CTRLB.CHSIZE decoded once by Initialize/SerialSetup so the per-character
+ * paths do not read CTRLB */
+volatile static bool sercom0USARTIs9BitMode = false;
+
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+
+#define SERCOM0_USART_READ_BUFFER_9BIT_SIZE     (SERCOM0_USART_READ_BUFFER_SIZE >> 1U)
+#define SERCOM0_USART_WRITE_BUFFER_9BIT_SIZE    (SERCOM0_USART_WRITE_BUFFER_SIZE >> 1U)
+
+volatile static SERCOM_USART_RING_BUFFER_OBJECT sercom0USARTObj;
+
+/* Ring storage. In 9-bit mode the same storage is accessed as uint16_t. */
+volatile static uint8_t __ALIGNED(4) SERCOM0_USART_ReadBuffer[SERCOM0_USART_READ_BUFFER_SIZE] SYS_BOOT_NO_INIT;
+volatile static uint8_t __ALIGNED(4) SERCOM0_USART_WriteBuffer[SERCOM0_USART_WRITE_BUFFER_SIZE] SYS_BOOT_NO_INIT;
+
+#endif
+
+#ifdef SERCOM0_USART_TX_DMA_CHANNEL
+
+/* DMA transmit request. Only the tx members are used. */
+volatile static SERCOM_USART_OBJECT sercom0USARTDmaObj;
+
+#endif
+
+#ifdef SERCOM0_USART_RX_DMA_CHANNEL
+
+/* Self-linked descriptor: the DMAC refills the read ring forever */
+static dmac_descriptor_registers_t __ALIGNED(16) sercom0USARTRxDmaDescriptor;
+
+volatile static SERCOM_USART_FRAME_OBJECT sercom0USARTFrameObj;
+
+#endif
+
 
 // *****************************************************************************
 // *****************************************************************************
@@ -68,7 +115,7 @@
 // *****************************************************************************
 // *****************************************************************************
 
-void static SERCOM0_USART_ErrorClear( void )
+__STATIC_FORCEINLINE void SERCOM0_USART_ErrorClear( void )
 {
     uint8_t  u8dummyData = 0U;
     USART_ERROR errorStatus = (USART_ERROR) (SERCOM0_REGS->USART_INT.SERCOM_STATUS & (uint16_t)(SERCOM_USART_INT_STATUS_PERR_Msk | SERCOM_USART_INT_STATUS_FERR_Msk | SERCOM_USART_INT_STATUS_BUFOVF_Msk ));
@@ -91,297 +138,918 @@ void static SERCOM0_USART_ErrorClear( void )
     (void)u8dummyData;
 }
 
-void SERCOM0_USART_Initialize( void )
+__STATIC_FORCEINLINE bool SERCOM0_USART_Is9BitModeEnabled( void )
 {
-    /*
-     * Configures USART Clock Mode
-     * Configures TXPO and RXPO
-     * Configures Data Order
-     * Configures Standby Mode
-     * Configures Sampling rate
-     * Configures IBON
-     */
-    SERCOM0_REGS->USART_INT.SERCOM_CTRLA = SERCOM_USART_INT_CTRLA_MODE_USART_INT_CLK | SERCOM_USART_INT_CTRLA_RXPO(0x0UL) | SERCOM_USART_INT_CTRLA_TXPO(0x0UL) | SERCOM_USART_INT_CTRLA_DORD_Msk | SERCOM_USART_INT_CTRLA_IBON_Msk | SERCOM_USART_INT_CTRLA_FORM(0x0UL) | SERCOM_USART_INT_CTRLA_SAMPR(0UL) ;
-
-    /* Configure Baud Rate */
-    SERCOM0_REGS->USART_INT.SERCOM_BAUD = (uint16_t)SERCOM_USART_INT_BAUD_BAUD(SERCOM0_USART_INT_BAUD_VALUE);
-
-    /*
-     * Configures RXEN
-     * Configures TXEN
-     * Configures CHSIZE
-     * Configures Parity
-     * Configures Stop bits
-     */
-    SERCOM0_REGS->USART_INT.SERCOM_CTRLB = SERCOM_USART_INT_CTRLB_CHSIZE_8_BIT | SERCOM_USART_INT_CTRLB_SBMODE_1_BIT | SERCOM_USART_INT_CTRLB_RXEN_Msk | SERCOM_USART_INT_CTRLB_TXEN_Msk;
+    return sercom0USARTIs9BitMode;
+}
 
-    /* Wait for sync */
-    while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
-    {
-        /* Do nothing */
-    }
+static void SERCOM0_USART_DataWidthUpdate( void )
+{
+    sercom0USARTIs9BitMode = (((SERCOM0_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) == 0x01U);
+}
 
+#ifndef SERCOM0_USART_RING_BUFFER_ENABLE
 
-    /* Enable the UART after the configurations */
-    SERCOM0_REGS->USART_INT.SERCOM_CTRLA |= SERCOM_USART_INT_CTRLA_ENABLE_Msk;
+/* Width-specialized blocking loops: poll the flag, move one character */
+static void SERCOM0_USART_Write8( const uint8_t *pu8Data, size_t size )
+{
+    size_t u32Index;
 
-    /* Wait for sync */
-    while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+    for (u32Index = 0U; u32Index < size; u32Index++)
     {
-        /* Do nothing */
+        while((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & (uint8_t)SERCOM_USART_INT_INTFLAG_DRE_Msk) == 0U)
+        {
+            /* Do nothing */
+        }
+
+        SERCOM0_REGS->USART_INT.SERCOM_DATA = pu8Data[u32Index];
     }
 }
 
-uint32_t SERCOM0_USART_FrequencyGet( void )
+static void SERCOM0_USART_Write16( const uint16_t *pu16Data, size_t size )
 {
-    return 48000000UL;
+    size_t u32Index;
+
+    for (u32Index = 0U; u32Index < size; u32Index++)
+    {
+        while((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & (uint8_t)SERCOM_USART_INT_INTFLAG_DRE_Msk) == 0U)
+        {
+            /* Do nothing */
+        }
+
+        SERCOM0_REGS->USART_INT.SERCOM_DATA = pu16Data[u32Index];
+    }
 }
 
-bool SERCOM0_USART_SerialSetup( USART_SERIAL_SETUP * serialSetup, uint32_t clkFrequency )
+/* The read loops stop at the first character received with an error and
+ * return the number of good characters stored */
+static size_t SERCOM0_USART_Read8( uint8_t *pu8Data, size_t size )
 {
-    bool setupStatus       = false;
-    uint32_t baudValue     = 0U;
-    uint32_t sampleRate    = 0U;
+    size_t u32Index;
 
-    if((serialSetup != NULL) && (serialSetup->baudRate != 0U))
+    for (u32Index = 0U; u32Index < size; u32Index++)
     {
-        if(clkFrequency == 0U)
+        while((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & (uint8_t)SERCOM_USART_INT_INTFLAG_RXC_Msk) == 0U)
         {
-            clkFrequency = SERCOM0_USART_FrequencyGet();
+            /* Do nothing */
         }
 
-        if(clkFrequency >= (16U * serialSetup->baudRate))
-        {
-            baudValue = 65536U - (uint32_t)(((uint64_t)65536U * 16U * serialSetup->baudRate) / clkFrequency);
-            sampleRate = 0U;
-        }
-        else if(clkFrequency >= (8U * serialSetup->baudRate))
-        {
-            baudValue = 65536U - (uint32_t)(((uint64_t)65536U * 8U * serialSetup->baudRate) / clkFrequency);
-            sampleRate = 2U;
-        }
-        else if(clkFrequency >= (3U * serialSetup->baudRate))
-        {
-            baudValue = 65536U - (uint32_t)(((uint64_t)65536U * 3U * serialSetup->baudRate) / clkFrequency);
-            sampleRate = 4U;
-        }
-        else
+        if ((SERCOM0_REGS->USART_INT.SERCOM_STATUS & (uint16_t)(SERCOM_USART_INT_STATUS_PERR_Msk | SERCOM_USART_INT_STATUS_FERR_Msk | SERCOM_USART_INT_STATUS_BUFOVF_Msk)) != 0U)
         {
-            /* Do nothing */
+            break;
         }
 
-        /* Disable the USART before configurations */
-        SERCOM0_REGS->USART_INT.SERCOM_CTRLA &= ~SERCOM_USART_INT_CTRLA_ENABLE_Msk;
+        pu8Data[u32Index] = (uint8_t)SERCOM0_REGS->USART_INT.SERCOM_DATA;
+    }
 
-        /* Wait for sync */
-        while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
-        {
-            /* Do nothing */
-        }
+    return u32Index;
+}
 
-        /* Configure Baud Rate */
-        SERCOM0_REGS->USART_INT.SERCOM_BAUD = (uint16_t)SERCOM_USART_INT_BAUD_BAUD(baudValue);
+static size_t SERCOM0_USART_Read16( uint16_t *pu16Data, size_t size )
+{
+    size_t u32Index;
 
-        /* Configure Parity Options */
-        if(serialSetup->parity == USART_PARITY_NONE)
-        {
-            SERCOM0_REGS->USART_INT.SERCOM_CTRLA =  (SERCOM0_REGS->USART_INT.SERCOM_CTRLA & ~(SERCOM_USART_INT_CTRLA_SAMPR_Msk | SERCOM_USART_INT_CTRLA_FORM_Msk)) | SERCOM_USART_INT_CTRLA_FORM(0x0UL) | SERCOM_USART_INT_CTRLA_SAMPR((uint32_t)sampleRate); 
-            SERCOM0_REGS->USART_INT.SERCOM_CTRLB = (SERCOM0_REGS->USART_INT.SERCOM_CTRLB & ~(SERCOM_USART_INT_CTRLB_CHSIZE_Msk | SERCOM_USART_INT_CTRLB_SBMODE_Msk)) | ((uint32_t) serialSetup->dataWidth | (uint32_t) serialSetup->stopBits);
-        }
-        else
+    for (u32Index = 0U; u32Index < size; u32Index++)
+    {
+        while((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & (uint8_t)SERCOM_USART_INT_INTFLAG_RXC_Msk) == 0U)
         {
-            SERCOM0_REGS->USART_INT.SERCOM_CTRLA =  (SERCOM0_REGS->USART_INT.SERCOM_CTRLA & ~(SERCOM_USART_INT_CTRLA_SAMPR_Msk | SERCOM_USART_INT_CTRLA_FORM_Msk)) | SERCOM_USART_INT_CTRLA_FORM(0x1UL) | SERCOM_USART_INT_CTRLA_SAMPR((uint32_t)sampleRate); 
-            SERCOM0_REGS->USART_INT.SERCOM_CTRLB = (SERCOM0_REGS->USART_INT.SERCOM_CTRLB & ~(SERCOM_USART_INT_CTRLB_CHSIZE_Msk | SERCOM_USART_INT_CTRLB_SBMODE_Msk | SERCOM_USART_INT_CTRLB_PMODE_Msk)) | (uint32_t) serialSetup->dataWidth | (uint32_t) serialSetup->stopBits | (uint32_t) serialSetup->parity ;
+            /* Do nothing */
         }
 
-        /* Wait for sync */
-        while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+        if ((SERCOM0_REGS->USART_INT.SERCOM_STATUS & (uint16_t)(SERCOM_USART_INT_STATUS_PERR_Msk | SERCOM_USART_INT_STATUS_FERR_Msk | SERCOM_USART_INT_STATUS_BUFOVF_Msk)) != 0U)
         {
-            /* Do nothing */
+            break;
         }
 
-        /* Enable the USART after the configurations */
-        SERCOM0_REGS->USART_INT.SERCOM_CTRLA |= SERCOM_USART_INT_CTRLA_ENABLE_Msk;
+        pu16Data[u32Index] = (uint16_t)SERCOM0_REGS->USART_INT.SERCOM_DATA;
+    }
 
-        /* Wait for sync */
-        while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
-        {
-            /* Do nothing */
-        }
+    return u32Index;
+}
 
-        setupStatus = true;
+#endif
+
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+
+#ifdef SERCOM0_USART_RX_DMA_CHANNEL
+/* (Re)starts the circular DMA into the read ring. The read indices must be zero. */
+static void SERCOM0_USART_RxDmaStart( void )
+{
+    uint16_t beatSize = (SERCOM0_USART_Is9BitModeEnabled() == true) ? (uint16_t)DMAC_BTCTRL_BEATSIZE_HWORD : (uint16_t)DMAC_BTCTRL_BEATSIZE_BYTE;
+
+    DMAC_ChannelDisable(SERCOM0_USART_RX_DMA_CHANNEL);
+
+    /* The DMAC takes the end address of an incrementing destination */
+    sercom0USARTRxDmaDescriptor.DMAC_BTCTRL = (uint16_t)(DMAC_BTCTRL_BLOCKACT_NOACT | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_DSTINC_Msk) | beatSize;
+    sercom0USARTRxDmaDescriptor.DMAC_BTCNT = (uint16_t)sercom0USARTObj.rdBufferSize;
+    sercom0USARTRxDmaDescriptor.DMAC_SRCADDR = (uint32_t)&SERCOM0_REGS->USART_INT.SERCOM_DATA;
+    sercom0USARTRxDmaDescriptor.DMAC_DSTADDR = (uint32_t)&SERCOM0_USART_ReadBuffer[0] + SERCOM0_USART_READ_BUFFER_SIZE;
+    sercom0USARTRxDmaDescriptor.DMAC_DESCADDR = (uint32_t)&sercom0USARTRxDmaDescriptor;
+
+    sercom0USARTFrameObj.frameSize = 0U;
+    sercom0USARTFrameObj.isLineActive = false;
+
+    (void)DMAC_ChannelLinkedListTransfer(SERCOM0_USART_RX_DMA_CHANNEL, &sercom0USARTRxDmaDescriptor);
+}
+#endif
+
+static void SERCOM0_USART_RingBufferReset( void )
+{
+    sercom0USARTObj.rdInIndex = 0U;
+    sercom0USARTObj.rdOutIndex = 0U;
+    sercom0USARTObj.wrInIndex = 0U;
+    sercom0USARTObj.wrOutIndex = 0U;
+
+    if (SERCOM0_USART_Is9BitModeEnabled() == true)
+    {
+        sercom0USARTObj.rdBufferSize = SERCOM0_USART_READ_BUFFER_9BIT_SIZE;
+        sercom0USARTObj.wrBufferSize = SERCOM0_USART_WRITE_BUFFER_9BIT_SIZE;
+    }
+    else
+    {
+        sercom0USARTObj.rdBufferSize = SERCOM0_USART_READ_BUFFER_SIZE;
+        sercom0USARTObj.wrBufferSize = SERCOM0_USART_WRITE_BUFFER_SIZE;
     }
 
-    return setupStatus;
+#ifdef SERCOM0_USART_RX_DMA_CHANNEL
+    SERCOM0_USART_RxDmaStart();
+#endif
 }
 
-USART_ERROR SERCOM0_USART_ErrorGet( void )
+__STATIC_FORCEINLINE size_t SERCOM0_USART_RingCountGet( uint32_t inIndex, uint32_t outIndex, uint32_t bufferSize )
 {
-    USART_ERROR errorStatus = (USART_ERROR) (SERCOM0_REGS->USART_INT.SERCOM_STATUS & (uint16_t)(SERCOM_USART_INT_STATUS_PERR_Msk | SERCOM_USART_INT_STATUS_FERR_Msk | SERCOM_USART_INT_STATUS_BUFOVF_Msk ));
+    size_t count;
 
-    if(errorStatus != USART_ERROR_NONE)
+    if (inIndex >= outIndex)
     {
-        SERCOM0_USART_ErrorClear();
+        count = inIndex - outIndex;
+    }
+    else
+    {
+        count = (bufferSize - outIndex) + inIndex;
     }
 
-    return errorStatus;
+    return count;
 }
 
-void SERCOM0_USART_Enable( void )
+__STATIC_FORCEINLINE void SERCOM0_USART_ReadNotificationSend( void )
 {
-    if((SERCOM0_REGS->USART_INT.SERCOM_CTRLA & SERCOM_USART_INT_CTRLA_ENABLE_Msk) == 0U)
+    uint32_t nUnreadBytesAvailable;
+
+    if ((sercom0USARTObj.isRdNotificationEnabled == true) && (sercom0USARTObj.rdCallback != NULL))
     {
-        SERCOM0_REGS->USART_INT.SERCOM_CTRLA |= SERCOM_USART_INT_CTRLA_ENABLE_Msk;
+        nUnreadBytesAvailable = SERCOM0_USART_RingCountGet(sercom0USARTObj.rdInIndex, sercom0USARTObj.rdOutIndex, sercom0USARTObj.rdBufferSize);
 
-        /* Wait for sync */
-        while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+        if (sercom0USARTObj.isRdNotifyPersistently == true)
         {
-            /* Do nothing */
+            if (nUnreadBytesAvailable >= sercom0USARTObj.rdThreshold)
+            {
+                sercom0USARTObj.rdCallback(SERCOM_USART_EVENT_READ_THRESHOLD_REACHED, sercom0USARTObj.rdContext);
+            }
+        }
+        else
+        {
+            if (nUnreadBytesAvailable == sercom0USARTObj.rdThreshold)
+            {
+                sercom0USARTObj.rdCallback(SERCOM_USART_EVENT_READ_THRESHOLD_REACHED, sercom0USARTObj.rdContext);
+            }
         }
     }
 }
 
-void SERCOM0_USART_Disable( void )
+__STATIC_FORCEINLINE void SERCOM0_USART_WriteNotificationSend( void )
 {
-    if((SERCOM0_REGS->USART_INT.SERCOM_CTRLA & SERCOM_USART_INT_CTRLA_ENABLE_Msk) != 0U)
+    uint32_t nFreeWrBufferCount;
+
+    if ((sercom0USARTObj.isWrNotificationEnabled == true) && (sercom0USARTObj.wrCallback != NULL))
     {
-        SERCOM0_REGS->USART_INT.SERCOM_CTRLA &= ~SERCOM_USART_INT_CTRLA_ENABLE_Msk;
+        nFreeWrBufferCount = (sercom0USARTObj.wrBufferSize - 1U) - SERCOM0_USART_RingCountGet(sercom0USARTObj.wrInIndex, sercom0USARTObj.wrOutIndex, sercom0USARTObj.wrBufferSize);
 
-        /* Wait for sync */
-        while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+        if (sercom0USARTObj.isWrNotifyPersistently == true)
         {
-            /* Do nothing */
+            if (nFreeWrBufferCount >= sercom0USARTObj.wrThreshold)
+            {
+                sercom0USARTObj.wrCallback(SERCOM_USART_EVENT_WRITE_THRESHOLD_REACHED, sercom0USARTObj.wrContext);
+            }
+        }
+        else
+        {
+            if (nFreeWrBufferCount == sercom0USARTObj.wrThreshold)
+            {
+                sercom0USARTObj.wrCallback(SERCOM_USART_EVENT_WRITE_THRESHOLD_REACHED, sercom0USARTObj.wrContext);
+            }
         }
     }
 }
 
-
-void SERCOM0_USART_TransmitterEnable( void )
+/* Called from the interrupt context only */
+__STATIC_FORCEINLINE bool SERCOM0_USART_RxPushByte( uint16_t rdByte )
 {
-    SERCOM0_REGS->USART_INT.SERCOM_CTRLB |= SERCOM_USART_INT_CTRLB_TXEN_Msk;
+    uint32_t tempInIndex;
+    bool isSuccess = false;
 
-    /* Wait for sync */
-    while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+    tempInIndex = sercom0USARTObj.rdInIndex + 1U;
+
+    if (tempInIndex >= sercom0USARTObj.rdBufferSize)
     {
-        /* Do nothing */
+        tempInIndex = 0U;
     }
-}
 
-void SERCOM0_USART_TransmitterDisable( void )
-{
-    SERCOM0_REGS->USART_INT.SERCOM_CTRLB &= ~SERCOM_USART_INT_CTRLB_TXEN_Msk;
+    if (tempInIndex == sercom0USARTObj.rdOutIndex)
+    {
+        /* Queue is full - give the application a chance to read data out */
+        if (sercom0USARTObj.rdCallback != NULL)
+        {
+            sercom0USARTObj.rdCallback(SERCOM_USART_EVENT_READ_BUFFER_FULL, sercom0USARTObj.rdContext);
+        }
+    }
 
-    /* Wait for sync */
-    while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+    /* Check if the application has freed up space */
+    if (tempInIndex != sercom0USARTObj.rdOutIndex)
     {
-        /* Do nothing */
+        if (SERCOM0_USART_Is9BitModeEnabled() == true)
+        {
+            ((volatile uint16_t*)&SERCOM0_USART_ReadBuffer[0])[sercom0USARTObj.rdInIndex] = rdByte;
+        }
+        else
+        {
+            SERCOM0_USART_ReadBuffer[sercom0USARTObj.rdInIndex] = (uint8_t)rdByte;
+        }
+
+        sercom0USARTObj.rdInIndex = tempInIndex;
+
+        isSuccess = true;
     }
+
+    return isSuccess;
 }
 
-bool SERCOM0_USART_Write( void *buffer, const size_t size )
+/* Called from the interrupt context only */
+__STATIC_FORCEINLINE bool SERCOM0_USART_TxPullByte( uint16_t *pWrByte )
 {
-    bool writeStatus      = false;
-    uint8_t *pu8Data      = (uint8_t*)buffer;
-    uint16_t *pu16Data    = (uint16_t*)buffer;
-    uint32_t u32Index     = 0U;
+    bool isSuccess = false;
+    uint32_t outIndex = sercom0USARTObj.wrOutIndex;
 
-    if(buffer != NULL)
+    if (outIndex != sercom0USARTObj.wrInIndex)
     {
-        /* Blocks while buffer is being transferred */
-        while(u32Index < size)
+        if (SERCOM0_USART_Is9BitModeEnabled() == true)
         {
-            /* Check if USART is ready for new data */
-            while((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & (uint8_t)SERCOM_USART_INT_INTFLAG_DRE_Msk) == 0U)
-            {
-                /* Do nothing */
-            }
+            *pWrByte = ((volatile uint16_t*)&SERCOM0_USART_WriteBuffer[0])[outIndex];
+        }
+        else
+        {
+            *pWrByte = SERCOM0_USART_WriteBuffer[outIndex];
+        }
 
-            /* Write data to USART module */
-            if (((SERCOM0_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) != 0x01U)
-            {
-                /* 8-bit mode */
-                SERCOM0_REGS->USART_INT.SERCOM_DATA = pu8Data[u32Index];
-            }
-            else
-            {
-                /* 9-bit mode */
-                SERCOM0_REGS->USART_INT.SERCOM_DATA = pu16Data[u32Index];
-            }
+        outIndex++;
 
-            /* Increment index */
-            u32Index++;
+        if (outIndex >= sercom0USARTObj.wrBufferSize)
+        {
+            outIndex = 0U;
         }
-        writeStatus = true;
+
+        sercom0USARTObj.wrOutIndex = outIndex;
+
+        isSuccess = true;
     }
 
-    return writeStatus;
+    return isSuccess;
 }
 
+#ifdef SERCOM0_USART_RX_DMA_CHANNEL
 
-bool SERCOM0_USART_TransmitterIsReady( void )
+/* Moves the read ring input index up to the DMA write position and returns
+ * the number of new characters. Callable from thread and interrupt context. */
+static size_t SERCOM0_USART_RxDmaSync( void )
 {
-    bool transmitterStatus = false;
+    uint32_t processorStatus = __get_PRIMASK();
+    uint32_t inIndex;
+    size_t nNewChars;
 
-    if ((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_DRE_Msk) == SERCOM_USART_INT_INTFLAG_DRE_Msk)
+    __disable_irq();
+
+    inIndex = (uint32_t)DMAC_ChannelGetTransferredCount(SERCOM0_USART_RX_DMA_CHANNEL);
+
+    if (inIndex >= sercom0USARTObj.rdBufferSize)
     {
-        transmitterStatus = true;
+        inIndex = 0U;
     }
 
-    return transmitterStatus;
-}
+    nNewChars = SERCOM0_USART_RingCountGet(inIndex, sercom0USARTObj.rdInIndex, sercom0USARTObj.rdBufferSize);
 
-void SERCOM0_USART_WriteByte( int data )
-{
-    /* Check if USART is ready for new data */
-    while((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_DRE_Msk) == 0U)
+    if (nNewChars > 0U)
     {
-        /* Do nothing */
+        /* The DMAC does not stop at rdOutIndex; unread characters were overwritten */
+        if ((SERCOM0_USART_RingCountGet(sercom0USARTObj.rdInIndex, sercom0USARTObj.rdOutIndex, sercom0USARTObj.rdBufferSize) + nNewChars) >= sercom0USARTObj.rdBufferSize)
+        {
+            sercom0USARTObj.errorStatus |= USART_ERROR_OVERRUN;
+        }
+
+        sercom0USARTObj.rdInIndex = inIndex;
+
+        sercom0USARTFrameObj.frameSize += nNewChars;
+        sercom0USARTFrameObj.isLineActive = true;
     }
 
-    SERCOM0_REGS->USART_INT.SERCOM_DATA = (uint16_t)data;
+    __set_PRIMASK(processorStatus);
+
+    return nNewChars;
 }
 
-bool SERCOM0_USART_TransmitComplete( void )
+/* Called from the TC3 interrupt context. A frame ends once a whole timer
+ * period passes without a new character. Once the line has also been quiet
+ * for a period, TC3 stops and the next start bit (RXS) restarts it, so an
+ * idle line does not wake the CPU. */
+static void SERCOM0_USART_RxIdleTimerHandler( TC_TIMER_STATUS status, uintptr_t context )
 {
-    bool transmitComplete = false;
+    size_t frameSize;
+    bool isStartDetected = ((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & (uint8_t)SERCOM_USART_INT_INTFLAG_RXS_Msk) != 0U);
 
-    if ((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_TXC_Msk) == SERCOM_USART_INT_INTFLAG_TXC_Msk)
+    /* Sampled per period: a character still arriving keeps the timer on */
+    SERCOM0_REGS->USART_INT.SERCOM_INTFLAG = (uint8_t)SERCOM_USART_INT_INTFLAG_RXS_Msk;
+
+    if (SERCOM0_USART_RxDmaSync() > 0U)
     {
-        transmitComplete = true;
+        SERCOM0_USART_ReadNotificationSend();
     }
 
-    return transmitComplete;
-}
+    if (sercom0USARTFrameObj.isLineActive == true)
+    {
+        sercom0USARTFrameObj.isLineActive = false;
+    }
+    else if (sercom0USARTFrameObj.frameSize > 0U)
+    {
+        frameSize = sercom0USARTFrameObj.frameSize;
+        sercom0USARTFrameObj.frameSize = 0U;
 
-void SERCOM0_USART_ReceiverEnable( void )
-{
-    SERCOM0_REGS->USART_INT.SERCOM_CTRLB |= SERCOM_USART_INT_CTRLB_RXEN_Msk;
+        if (sercom0USARTFrameObj.callback != NULL)
+        {
+            sercom0USARTFrameObj.callback(frameSize, sercom0USARTFrameObj.context);
+        }
+    }
+    else if (isStartDetected == false)
+    {
+        /* Line idle, nothing received. A start bit after the flag was
+         * cleared above raises the interrupt as soon as it is enabled. */
+        TC3_TimerStop();
 
-    /* Wait for sync */
-    while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+        SERCOM0_REGS->USART_INT.SERCOM_INTENSET = (uint8_t)SERCOM_USART_INT_INTENSET_RXS_Msk;
+    }
+    else
     {
-        /* Do nothing */
+        /* A character is on its way */
     }
 }
 
-void SERCOM0_USART_ReceiverDisable( void )
+/* Start bit on an idle line: resume sampling. The RXS flag stays set so the
+ * first period does not take the line for idle. */
+__STATIC_FORCEINLINE void SERCOM0_USART_ISR_RXS_Handler( void )
 {
-    SERCOM0_REGS->USART_INT.SERCOM_CTRLB &= ~SERCOM_USART_INT_CTRLB_RXEN_Msk;
+    SERCOM0_REGS->USART_INT.SERCOM_INTENCLR = (uint8_t)SERCOM_USART_INT_INTENCLR_RXS_Msk;
 
-    /* Wait for sync */
-    while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
-    {
+    TC3_Timer16bitCounterSet(0U);
+    TC3_TimerStart();
+}
+
+/* Called from the DMAC interrupt context */
+static void SERCOM0_USART_RX_DMA_Handler( DMAC_TRANSFER_EVENT event, uintptr_t context )
+{
+    if (event == DMAC_TRANSFER_EVENT_ERROR)
+    {
+        /* The circular transfer only stops on a bus error; drop the ring and restart */
+        sercom0USARTObj.rdInIndex = 0U;
+        sercom0USARTObj.rdOutIndex = 0U;
+
+        SERCOM0_USART_RxDmaStart();
+
+        if (sercom0USARTObj.rdCallback != NULL)
+        {
+            sercom0USARTObj.rdCallback(SERCOM_USART_EVENT_READ_ERROR, sercom0USARTObj.rdContext);
+        }
+    }
+}
+
+#endif
+
+#endif
+
+#ifdef SERCOM0_USART_TX_DMA_CHANNEL
+
+/* Called from the DMAC interrupt context */
+static void SERCOM0_USART_TX_DMA_Handler( DMAC_TRANSFER_EVENT event, uintptr_t context )
+{
+    /* One beat per character; less than txSize on a transfer error */
+    sercom0USARTDmaObj.txProcessedSize = (size_t)DMAC_ChannelGetTransferredCount(SERCOM0_USART_TX_DMA_CHANNEL);
+    sercom0USARTDmaObj.txBusyStatus = false;
+
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+    /* Resume the ring transmission that was held off while the DMA owned the transmitter */
+    if (SERCOM0_USART_WriteCountGet() > 0U)
+    {
+        SERCOM0_REGS->USART_INT.SERCOM_INTENSET = (uint8_t)SERCOM_USART_INT_INTENSET_DRE_Msk;
+    }
+#endif
+
+    if (sercom0USARTDmaObj.txCallback != NULL)
+    {
+        sercom0USARTDmaObj.txCallback(sercom0USARTDmaObj.txContext);
+    }
+}
+
+#endif
+
+/* Picks the oversampling and BAUD value; false when clkFrequency is too low */
+static bool SERCOM0_USART_BaudCompute( uint32_t baudRate, uint32_t clkFrequency, uint32_t *baudValue, uint32_t *sampleRate )
+{
+    bool isValid = true;
+
+    if(clkFrequency >= (16U * baudRate))
+    {
+        *baudValue = 65536U - (uint32_t)(((uint64_t)65536U * 16U * baudRate) / clkFrequency);
+        *sampleRate = 0U;
+    }
+    else if(clkFrequency >= (8U * baudRate))
+    {
+        *baudValue = 65536U - (uint32_t)(((uint64_t)65536U * 8U * baudRate) / clkFrequency);
+        *sampleRate = 2U;
+    }
+    else if(clkFrequency >= (3U * baudRate))
+    {
+        *baudValue = 65536U - (uint32_t)(((uint64_t)65536U * 3U * baudRate) / clkFrequency);
+        *sampleRate = 4U;
+    }
+    else
+    {
+        isValid = false;
+    }
+
+    return isValid;
+}
+
+/* Called by CLOCK_FrequencySet with interrupts masked. Before the change the
+ * character being sent is let out, so the new baud rate does not cut it; a
+ * character being received at that moment is lost. */
+static bool SERCOM0_USART_ClockHandler( CLOCK_EVENT event, uint32_t frequency, uintptr_t context )
+{
+    /* TXC stays clear when nothing was sent since reset, so the wait ends
+     * after about two characters at 4 cycles per poll */
+    uint32_t spin = (CLOCK_FrequencyGet() / sercom0USARTBaudRate) * 5U;
+
+    (void)context;
+
+    if (event == CLOCK_EVENT_CHANGE_PENDING)
+    {
+        if (SERCOM0_USART_BaudCompute(sercom0USARTBaudRate, frequency, &sercom0USARTPendingBaudValue, &sercom0USARTPendingSampleRate) == false)
+        {
+            return false;
+        }
+
+        while (((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & (uint8_t)SERCOM_USART_INT_INTFLAG_TXC_Msk) == 0U) && (spin > 0U))
+        {
+            spin--;
+        }
+
+        return true;
+    }
+
+    /* BAUD and SAMPR are enable-protected */
+    SERCOM0_REGS->USART_INT.SERCOM_CTRLA &= ~SERCOM_USART_INT_CTRLA_ENABLE_Msk;
+
+    while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+    SERCOM0_REGS->USART_INT.SERCOM_BAUD = (uint16_t)SERCOM_USART_INT_BAUD_BAUD(sercom0USARTPendingBaudValue);
+    SERCOM0_REGS->USART_INT.SERCOM_CTRLA = (SERCOM0_REGS->USART_INT.SERCOM_CTRLA & ~SERCOM_USART_INT_CTRLA_SAMPR_Msk) | SERCOM_USART_INT_CTRLA_SAMPR(sercom0USARTPendingSampleRate);
+
+    SERCOM0_REGS->USART_INT.SERCOM_CTRLA |= SERCOM_USART_INT_CTRLA_ENABLE_Msk;
+
+    while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+    return true;
+}
+
+void SERCOM0_USART_Initialize( void )
+{
+    /*
+     * Configures USART Clock Mode
+     * Configures TXPO and RXPO
+     * Configures Data Order
+     * Configures Standby Mode
+     * Configures Sampling rate
+     * Configures IBON
+     */
+    SERCOM0_REGS->USART_INT.SERCOM_CTRLA = SERCOM_USART_INT_CTRLA_MODE_USART_INT_CLK | SERCOM_USART_INT_CTRLA_RXPO(0x0UL) | SERCOM_USART_INT_CTRLA_TXPO(0x0UL) | SERCOM_USART_INT_CTRLA_DORD_Msk | SERCOM_USART_INT_CTRLA_IBON_Msk | SERCOM_USART_INT_CTRLA_FORM(0x0UL) | SERCOM_USART_INT_CTRLA_SAMPR(0UL) ;
+
+    /* Configure Baud Rate */
+    SERCOM0_REGS->USART_INT.SERCOM_BAUD = (uint16_t)SERCOM_USART_INT_BAUD_BAUD(SERCOM0_USART_INT_BAUD_VALUE);
+    sercom0USARTBaudRate = 115200U;
+    (void)CLOCK_CallbackRegister(SERCOM0_USART_ClockHandler, 0U);
+
+    /*
+     * Configures RXEN
+     * Configures TXEN
+     * Configures CHSIZE
+     * Configures Parity
+     * Configures Stop bits
+     */
+    SERCOM0_REGS->USART_INT.SERCOM_CTRLB = SERCOM_USART_INT_CTRLB_CHSIZE_8_BIT | SERCOM_USART_INT_CTRLB_SBMODE_1_BIT | SERCOM_USART_INT_CTRLB_RXEN_Msk | SERCOM_USART_INT_CTRLB_TXEN_Msk;
+
+#ifdef SERCOM0_USART_RX_DMA_CHANNEL
+    /* Start-of-frame detection raises RXS, which restarts the idle timer */
+    SERCOM0_REGS->USART_INT.SERCOM_CTRLB |= SERCOM_USART_INT_CTRLB_SFDE_Msk;
+#endif
+
+    /* Wait for sync */
+    while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+
+    /* Enable the UART after the configurations */
+    SERCOM0_REGS->USART_INT.SERCOM_CTRLA |= SERCOM_USART_INT_CTRLA_ENABLE_Msk;
+
+    /* Wait for sync */
+    while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+
+    SERCOM0_USART_DataWidthUpdate();
+
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+    /* Initialize instance object */
+    sercom0USARTObj.rdCallback = NULL;
+    sercom0USARTObj.wrCallback = NULL;
+    sercom0USARTObj.isRdNotificationEnabled = false;
+    sercom0USARTObj.isWrNotificationEnabled = false;
+    sercom0USARTObj.isRdNotifyPersistently = false;
+    sercom0USARTObj.isWrNotifyPersistently = false;
+    sercom0USARTObj.rdThreshold = 0U;
+    sercom0USARTObj.wrThreshold = 0U;
+    sercom0USARTObj.errorStatus = USART_ERROR_NONE;
+
+    SERCOM0_USART_RingBufferReset();
+
+#ifdef SERCOM0_USART_RX_DMA_CHANNEL
+    /* The DMAC drains the receiver; TC3 tracks its progress and the line idle time */
+    sercom0USARTFrameObj.callback = NULL;
+
+    DMAC_ChannelCallbackRegister(SERCOM0_USART_RX_DMA_CHANNEL, SERCOM0_USART_RX_DMA_Handler, 0U);
+
+    TC3_TimerCallbackRegister(SERCOM0_USART_RxIdleTimerHandler, 0U);
+    TC3_TimerStart();
+
+    SERCOM0_REGS->USART_INT.SERCOM_INTENSET = (uint8_t)SERCOM_USART_INT_INTENSET_ERROR_Msk;
+#else
+    /* Enable receive and error interrupts. DRE is enabled on demand by the write calls. */
+    SERCOM0_REGS->USART_INT.SERCOM_INTENSET = (uint8_t)(SERCOM_USART_INT_INTENSET_ERROR_Msk | SERCOM_USART_INT_INTENSET_RXC_Msk);
+#endif
+#endif
+
+#ifdef SERCOM0_USART_TX_DMA_CHANNEL
+    sercom0USARTDmaObj.txBuffer = NULL;
+    sercom0USARTDmaObj.txSize = 0U;
+    sercom0USARTDmaObj.txProcessedSize = 0U;
+    sercom0USARTDmaObj.txCallback = NULL;
+    sercom0USARTDmaObj.txBusyStatus = false;
+
+    DMAC_ChannelCallbackRegister(SERCOM0_USART_TX_DMA_CHANNEL, SERCOM0_USART_TX_DMA_Handler, 0U);
+#endif
+}
+
+uint32_t SERCOM0_USART_FrequencyGet( void )
+{
+    return CLOCK_FrequencyGet();
+}
+
+bool SERCOM0_USART_SerialSetup( USART_SERIAL_SETUP * serialSetup, uint32_t clkFrequency )
+{
+    bool setupStatus       = false;
+    uint32_t baudValue     = 0U;
+    uint32_t sampleRate    = 0U;
+
+    if((serialSetup != NULL) && (serialSetup->baudRate != 0U))
+    {
+        if(clkFrequency == 0U)
+        {
+            clkFrequency = SERCOM0_USART_FrequencyGet();
+        }
+
+        (void)SERCOM0_USART_BaudCompute(serialSetup->baudRate, clkFrequency, &baudValue, &sampleRate);
+        sercom0USARTBaudRate = serialSetup->baudRate;
+
+        /* Disable the USART before configurations */
+        SERCOM0_REGS->USART_INT.SERCOM_CTRLA &= ~SERCOM_USART_INT_CTRLA_ENABLE_Msk;
+
+        /* Wait for sync */
+        while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+        {
+            /* Do nothing */
+        }
+
+        /* Configure Baud Rate */
+        SERCOM0_REGS->USART_INT.SERCOM_BAUD = (uint16_t)SERCOM_USART_INT_BAUD_BAUD(baudValue);
+
+        /* Configure Parity Options */
+        if(serialSetup->parity == USART_PARITY_NONE)
+        {
+            SERCOM0_REGS->USART_INT.SERCOM_CTRLA =  (SERCOM0_REGS->USART_INT.SERCOM_CTRLA & ~(SERCOM_USART_INT_CTRLA_SAMPR_Msk | SERCOM_USART_INT_CTRLA_FORM_Msk)) | SERCOM_USART_INT_CTRLA_FORM(0x0UL) | SERCOM_USART_INT_CTRLA_SAMPR((uint32_t)sampleRate); 
+            SERCOM0_REGS->USART_INT.SERCOM_CTRLB = (SERCOM0_REGS->USART_INT.SERCOM_CTRLB & ~(SERCOM_USART_INT_CTRLB_CHSIZE_Msk | SERCOM_USART_INT_CTRLB_SBMODE_Msk)) | ((uint32_t) serialSetup->dataWidth | (uint32_t) serialSetup->stopBits);
+        }
+        else
+        {
+            SERCOM0_REGS->USART_INT.SERCOM_CTRLA =  (SERCOM0_REGS->USART_INT.SERCOM_CTRLA & ~(SERCOM_USART_INT_CTRLA_SAMPR_Msk | SERCOM_USART_INT_CTRLA_FORM_Msk)) | SERCOM_USART_INT_CTRLA_FORM(0x1UL) | SERCOM_USART_INT_CTRLA_SAMPR((uint32_t)sampleRate); 
+            SERCOM0_REGS->USART_INT.SERCOM_CTRLB = (SERCOM0_REGS->USART_INT.SERCOM_CTRLB & ~(SERCOM_USART_INT_CTRLB_CHSIZE_Msk | SERCOM_USART_INT_CTRLB_SBMODE_Msk | SERCOM_USART_INT_CTRLB_PMODE_Msk)) | (uint32_t) serialSetup->dataWidth | (uint32_t) serialSetup->stopBits | (uint32_t) serialSetup->parity ;
+        }
+
+        /* Wait for sync */
+        while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+        {
+            /* Do nothing */
+        }
+
+        SERCOM0_USART_DataWidthUpdate();
+
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+        /* Character width may have changed; discard queued characters */
+        SERCOM0_USART_RingBufferReset();
+#endif
+
+        /* Enable the USART after the configurations */
+        SERCOM0_REGS->USART_INT.SERCOM_CTRLA |= SERCOM_USART_INT_CTRLA_ENABLE_Msk;
+
+        /* Wait for sync */
+        while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+        {
+            /* Do nothing */
+        }
+
+        setupStatus = true;
+    }
+
+    return setupStatus;
+}
+
+USART_ERROR SERCOM0_USART_ErrorGet( void )
+{
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+    /* Errors are latched and cleared by the interrupt handler */
+    USART_ERROR errorStatus = sercom0USARTObj.errorStatus;
+
+    sercom0USARTObj.errorStatus = USART_ERROR_NONE;
+#else
+    USART_ERROR errorStatus = (USART_ERROR) (SERCOM0_REGS->USART_INT.SERCOM_STATUS & (uint16_t)(SERCOM_USART_INT_STATUS_PERR_Msk | SERCOM_USART_INT_STATUS_FERR_Msk | SERCOM_USART_INT_STATUS_BUFOVF_Msk ));
+
+    if(errorStatus != USART_ERROR_NONE)
+    {
+        SERCOM0_USART_ErrorClear();
+    }
+#endif
+
+    return errorStatus;
+}
+
+void SERCOM0_USART_Enable( void )
+{
+    if((SERCOM0_REGS->USART_INT.SERCOM_CTRLA & SERCOM_USART_INT_CTRLA_ENABLE_Msk) == 0U)
+    {
+        SERCOM0_REGS->USART_INT.SERCOM_CTRLA |= SERCOM_USART_INT_CTRLA_ENABLE_Msk;
+
+        /* Wait for sync */
+        while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+        {
+            /* Do nothing */
+        }
+    }
+}
+
+void SERCOM0_USART_Disable( void )
+{
+    if((SERCOM0_REGS->USART_INT.SERCOM_CTRLA & SERCOM_USART_INT_CTRLA_ENABLE_Msk) != 0U)
+    {
+        SERCOM0_REGS->USART_INT.SERCOM_CTRLA &= ~SERCOM_USART_INT_CTRLA_ENABLE_Msk;
+
+        /* Wait for sync */
+        while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+        {
+            /* Do nothing */
+        }
+    }
+}
+
+
+void SERCOM0_USART_TransmitterEnable( void )
+{
+    SERCOM0_REGS->USART_INT.SERCOM_CTRLB |= SERCOM_USART_INT_CTRLB_TXEN_Msk;
+
+    /* Wait for sync */
+    while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+}
+
+void SERCOM0_USART_TransmitterDisable( void )
+{
+    SERCOM0_REGS->USART_INT.SERCOM_CTRLB &= ~SERCOM_USART_INT_CTRLB_TXEN_Msk;
+
+    /* Wait for sync */
+    while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+}
+
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+bool SERCOM0_USART_Write( void *buffer, const size_t size )
+{
+    bool writeStatus = false;
+    size_t nCharsWritten = 0U;
+    size_t charSize = (SERCOM0_USART_Is9BitModeEnabled() == true) ? 2U : 1U;
+
+    if(buffer != NULL)
+    {
+        /* Blocks only while the transmit ring is full */
+        while(nCharsWritten < size)
+        {
+            nCharsWritten += SERCOM0_USART_WriteAsync(&((uint8_t*)buffer)[nCharsWritten * charSize], size - nCharsWritten);
+        }
+        writeStatus = true;
+    }
+
+    return writeStatus;
+}
+#else
+bool SERCOM0_USART_Write( void *buffer, const size_t size )
+{
+    bool writeStatus      = false;
+
+    if(buffer != NULL)
+    {
+        /* Blocks while buffer is being transferred */
+        if (SERCOM0_USART_Is9BitModeEnabled() == true)
+        {
+            SERCOM0_USART_Write16((const uint16_t*)buffer, size);
+        }
+        else
+        {
+            SERCOM0_USART_Write8((const uint8_t*)buffer, size);
+        }
+        writeStatus = true;
+    }
+
+    return writeStatus;
+}
+#endif
+
+
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+bool SERCOM0_USART_TransmitterIsReady( void )
+{
+    return (SERCOM0_USART_WriteFreeBufferCountGet() > 0U);
+}
+#else
+bool SERCOM0_USART_TransmitterIsReady( void )
+{
+    bool transmitterStatus = false;
+
+    if ((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_DRE_Msk) == SERCOM_USART_INT_INTFLAG_DRE_Msk)
+    {
+        transmitterStatus = true;
+    }
+
+    return transmitterStatus;
+}
+#endif
+
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+void SERCOM0_USART_WriteByte( int data )
+{
+    uint16_t wrData = (uint16_t)data;
+
+    if (SERCOM0_USART_Is9BitModeEnabled() == true)
+    {
+        (void)SERCOM0_USART_Write(&wrData, 1U);
+    }
+    else
+    {
+        uint8_t wrByte = (uint8_t)wrData;
+
+        (void)SERCOM0_USART_Write(&wrByte, 1U);
+    }
+}
+#else
+void SERCOM0_USART_WriteByte( int data )
+{
+    /* Check if USART is ready for new data */
+    while((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_DRE_Msk) == 0U)
+    {
+        /* Do nothing */
+    }
+
+    SERCOM0_REGS->USART_INT.SERCOM_DATA = (uint16_t)data;
+}
+#endif
+
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+bool SERCOM0_USART_TransmitComplete( void )
+{
+    bool transmitComplete = false;
+
+    if ((SERCOM0_USART_WriteCountGet() == 0U) && ((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_TXC_Msk) == SERCOM_USART_INT_INTFLAG_TXC_Msk))
+    {
+        transmitComplete = true;
+    }
+
+#ifdef SERCOM0_USART_TX_DMA_CHANNEL
+    if (sercom0USARTDmaObj.txBusyStatus == true)
+    {
+        transmitComplete = false;
+    }
+#endif
+
+    return transmitComplete;
+}
+#else
+bool SERCOM0_USART_TransmitComplete( void )
+{
+    bool transmitComplete = false;
+
+    if ((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_TXC_Msk) == SERCOM_USART_INT_INTFLAG_TXC_Msk)
+    {
+        transmitComplete = true;
+    }
+
+#ifdef SERCOM0_USART_TX_DMA_CHANNEL
+    if (sercom0USARTDmaObj.txBusyStatus == true)
+    {
+        transmitComplete = false;
+    }
+#endif
+
+    return transmitComplete;
+}
+#endif
+
+void SERCOM0_USART_ReceiverEnable( void )
+{
+    SERCOM0_REGS->USART_INT.SERCOM_CTRLB |= SERCOM_USART_INT_CTRLB_RXEN_Msk;
+
+    /* Wait for sync */
+    while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+    {
+        /* Do nothing */
+    }
+}
+
+void SERCOM0_USART_ReceiverDisable( void )
+{
+    SERCOM0_REGS->USART_INT.SERCOM_CTRLB &= ~SERCOM_USART_INT_CTRLB_RXEN_Msk;
+
+    /* Wait for sync */
+    while((SERCOM0_REGS->USART_INT.SERCOM_SYNCBUSY) != 0U)
+    {
         /* Do nothing */
     }
 }
 
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+bool SERCOM0_USART_Read( void *buffer, const size_t size )
+{
+    bool readStatus = false;
+    size_t nCharsRead = 0U;
+    size_t charSize = (SERCOM0_USART_Is9BitModeEnabled() == true) ? 2U : 1U;
+
+    if(buffer != NULL)
+    {
+        /* Discard errors latched while no read request was pending */
+        sercom0USARTObj.errorStatus = USART_ERROR_NONE;
+
+        /* Blocks only while the receive ring is empty */
+        while((nCharsRead < size) && (sercom0USARTObj.errorStatus == USART_ERROR_NONE))
+        {
+            nCharsRead += SERCOM0_USART_ReadAvailable(&((uint8_t*)buffer)[nCharsRead * charSize], size - nCharsRead);
+        }
+
+        if(size == nCharsRead)
+        {
+            readStatus = true;
+        }
+    }
+
+    return readStatus;
+}
+#else
 bool SERCOM0_USART_Read( void *buffer, const size_t size )
 {
     bool readStatus         = false;
-    uint8_t* pu8Data        = (uint8_t*)buffer;
-    uint16_t *pu16Data      = (uint16_t*)buffer;
-    uint32_t u32Index       = 0U;
-    USART_ERROR errorStatus = USART_ERROR_NONE;
+    size_t u32Index         = 0U;
 
     if(buffer != NULL)
     {
@@ -389,59 +1057,430 @@ bool SERCOM0_USART_Read( void *buffer, const size_t size )
         /* Clear error flags and flush out error data that may have been received when no active request was pending */
         SERCOM0_USART_ErrorClear();
 
-        while(u32Index < size)
+        if (SERCOM0_USART_Is9BitModeEnabled() == true)
+        {
+            u32Index = SERCOM0_USART_Read16((uint16_t*)buffer, size);
+        }
+        else
+        {
+            u32Index = SERCOM0_USART_Read8((uint8_t*)buffer, size);
+        }
+
+        if(size == u32Index)
+        {
+            readStatus = true;
+        }
+    }
+
+    return readStatus;
+}
+#endif
+
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+bool SERCOM0_USART_ReceiverIsReady( void )
+{
+    return (SERCOM0_USART_ReadCountGet() > 0U);
+}
+#else
+bool SERCOM0_USART_ReceiverIsReady( void )
+{
+    bool receiverStatus = false;
+
+    if ((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_RXC_Msk) == SERCOM_USART_INT_INTFLAG_RXC_Msk)
+    {
+        receiverStatus = true;
+    }
+
+    return receiverStatus;
+}
+#endif
+
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+int SERCOM0_USART_ReadByte( void )
+{
+    int rdData = -1;
+    uint16_t rdChar = 0U;
+
+    if (SERCOM0_USART_Is9BitModeEnabled() == true)
+    {
+        if (SERCOM0_USART_ReadAvailable(&rdChar, 1U) == 1U)
+        {
+            rdData = (int)rdChar;
+        }
+    }
+    else
+    {
+        uint8_t rdByte = 0U;
+
+        if (SERCOM0_USART_ReadAvailable(&rdByte, 1U) == 1U)
+        {
+            rdData = (int)rdByte;
+        }
+    }
+
+    return rdData;
+}
+#else
+int SERCOM0_USART_ReadByte( void )
+{
+    return (int)SERCOM0_REGS->USART_INT.SERCOM_DATA;
+}
+#endif
+
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+
+size_t SERCOM0_USART_WriteAsync( const void *buffer, const size_t size )
+{
+    size_t nCharsWritten = 0U;
+    uint32_t inIndex = sercom0USARTObj.wrInIndex;
+    uint32_t tempInIndex;
+    bool is9Bit = SERCOM0_USART_Is9BitModeEnabled();
+
+    if (buffer != NULL)
+    {
+        while (nCharsWritten < size)
         {
-            /* Check if USART has new data */
-            while((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_RXC_Msk) == 0U)
+            tempInIndex = inIndex + 1U;
+
+            if (tempInIndex >= sercom0USARTObj.wrBufferSize)
             {
-                /* Do nothing */
+                tempInIndex = 0U;
             }
 
-            errorStatus = (USART_ERROR) (SERCOM0_REGS->USART_INT.SERCOM_STATUS & (uint16_t)(SERCOM_USART_INT_STATUS_PERR_Msk | SERCOM_USART_INT_STATUS_FERR_Msk | SERCOM_USART_INT_STATUS_BUFOVF_Msk));
-
-            if(errorStatus != USART_ERROR_NONE)
+            if (tempInIndex == sercom0USARTObj.wrOutIndex)
             {
+                /* Ring is full */
                 break;
             }
 
-            if (((SERCOM0_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) != 0x01U)
+            if (is9Bit == true)
             {
-                /* 8-bit mode */
-                pu8Data[u32Index] = (uint8_t)SERCOM0_REGS->USART_INT.SERCOM_DATA;
+                ((volatile uint16_t*)&SERCOM0_USART_WriteBuffer[0])[inIndex] = ((const uint16_t*)buffer)[nCharsWritten];
             }
             else
             {
-                /* 9-bit mode */
-                pu16Data[u32Index] = (uint16_t)SERCOM0_REGS->USART_INT.SERCOM_DATA;
+                SERCOM0_USART_WriteBuffer[inIndex] = ((const uint8_t*)buffer)[nCharsWritten];
             }
 
-            /* Increment index */
-            u32Index++;
+            inIndex = tempInIndex;
+            nCharsWritten++;
         }
 
-        if(size == u32Index)
+        /* Publish the new characters before kicking the transmitter */
+        sercom0USARTObj.wrInIndex = inIndex;
+
+#ifdef SERCOM0_USART_TX_DMA_CHANNEL
+        /* While a DMA write is in progress its completion handler kicks the transmitter */
+        if ((nCharsWritten > 0U) && (sercom0USARTDmaObj.txBusyStatus == false))
+#else
+        if (nCharsWritten > 0U)
+#endif
         {
-            readStatus = true;
+            SERCOM0_REGS->USART_INT.SERCOM_INTENSET = (uint8_t)SERCOM_USART_INT_INTENSET_DRE_Msk;
         }
     }
 
-    return readStatus;
+    return nCharsWritten;
 }
 
-bool SERCOM0_USART_ReceiverIsReady( void )
+size_t SERCOM0_USART_WriteCountGet( void )
 {
-    bool receiverStatus = false;
+    return SERCOM0_USART_RingCountGet(sercom0USARTObj.wrInIndex, sercom0USARTObj.wrOutIndex, sercom0USARTObj.wrBufferSize);
+}
 
-    if ((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & SERCOM_USART_INT_INTFLAG_RXC_Msk) == SERCOM_USART_INT_INTFLAG_RXC_Msk)
+size_t SERCOM0_USART_WriteFreeBufferCountGet( void )
+{
+    return (SERCOM0_USART_WriteBufferSizeGet() - SERCOM0_USART_WriteCountGet());
+}
+
+size_t SERCOM0_USART_WriteBufferSizeGet( void )
+{
+    /* One slot is kept empty to tell a full ring from an empty one */
+    return (sercom0USARTObj.wrBufferSize - 1U);
+}
+
+bool SERCOM0_USART_WriteNotificationEnable( bool isEnabled, bool isPersistent )
+{
+    bool previousStatus = sercom0USARTObj.isWrNotificationEnabled;
+
+    sercom0USARTObj.isWrNotificationEnabled = isEnabled;
+
+    sercom0USARTObj.isWrNotifyPersistently = isPersistent;
+
+    return previousStatus;
+}
+
+void SERCOM0_USART_WriteThresholdSet( uint32_t nBytesThreshold )
+{
+    if (nBytesThreshold > 0U)
     {
-        receiverStatus = true;
+        sercom0USARTObj.wrThreshold = nBytesThreshold;
     }
+}
 
-    return receiverStatus;
+void SERCOM0_USART_WriteCallbackRegister( SERCOM_USART_RING_BUFFER_CALLBACK callback, uintptr_t context )
+{
+    sercom0USARTObj.wrCallback = callback;
+
+    sercom0USARTObj.wrContext = context;
 }
 
-int SERCOM0_USART_ReadByte( void )
+size_t SERCOM0_USART_ReadAvailable( void *buffer, const size_t size )
 {
-    return (int)SERCOM0_REGS->USART_INT.SERCOM_DATA;
+    size_t nCharsRead = 0U;
+    uint32_t outIndex;
+    uint32_t inIndex;
+    bool is9Bit = SERCOM0_USART_Is9BitModeEnabled();
+
+#ifdef SERCOM0_USART_RX_DMA_CHANNEL
+    (void)SERCOM0_USART_RxDmaSync();
+#endif
+
+    outIndex = sercom0USARTObj.rdOutIndex;
+    inIndex = sercom0USARTObj.rdInIndex;
+
+    if (buffer != NULL)
+    {
+        while ((nCharsRead < size) && (outIndex != inIndex))
+        {
+            if (is9Bit == true)
+            {
+                ((uint16_t*)buffer)[nCharsRead] = ((volatile uint16_t*)&SERCOM0_USART_ReadBuffer[0])[outIndex];
+            }
+            else
+            {
+                ((uint8_t*)buffer)[nCharsRead] = SERCOM0_USART_ReadBuffer[outIndex];
+            }
+
+            outIndex++;
+
+            if (outIndex >= sercom0USARTObj.rdBufferSize)
+            {
+                outIndex = 0U;
+            }
+
+            nCharsRead++;
+        }
+
+        /* Release the slots back to the interrupt handler */
+        sercom0USARTObj.rdOutIndex = outIndex;
+    }
+
+    return nCharsRead;
+}
+
+size_t SERCOM0_USART_ReadCountGet( void )
+{
+#ifdef SERCOM0_USART_RX_DMA_CHANNEL
+    (void)SERCOM0_USART_RxDmaSync();
+#endif
+
+    return SERCOM0_USART_RingCountGet(sercom0USARTObj.rdInIndex, sercom0USARTObj.rdOutIndex, sercom0USARTObj.rdBufferSize);
+}
+
+size_t SERCOM0_USART_ReadFreeBufferCountGet( void )
+{
+    return (SERCOM0_USART_ReadBufferSizeGet() - SERCOM0_USART_ReadCountGet());
+}
+
+size_t SERCOM0_USART_ReadBufferSizeGet( void )
+{
+    /* One slot is kept empty to tell a full ring from an empty one */
+    return (sercom0USARTObj.rdBufferSize - 1U);
+}
+
+bool SERCOM0_USART_ReadNotificationEnable( bool isEnabled, bool isPersistent )
+{
+    bool previousStatus = sercom0USARTObj.isRdNotificationEnabled;
+
+    sercom0USARTObj.isRdNotificationEnabled = isEnabled;
+
+    sercom0USARTObj.isRdNotifyPersistently = isPersistent;
+
+    return previousStatus;
+}
+
+void SERCOM0_USART_ReadThresholdSet( uint32_t nBytesThreshold )
+{
+    if (nBytesThreshold > 0U)
+    {
+        sercom0USARTObj.rdThreshold = nBytesThreshold;
+    }
+}
+
+void SERCOM0_USART_ReadCallbackRegister( SERCOM_USART_RING_BUFFER_CALLBACK callback, uintptr_t context )
+{
+    sercom0USARTObj.rdCallback = callback;
+
+    sercom0USARTObj.rdContext = context;
+}
+
+__STATIC_FORCEINLINE void SERCOM0_USART_ISR_ERR_Handler( void )
+{
+    USART_ERROR errorStatus = (USART_ERROR) (SERCOM0_REGS->USART_INT.SERCOM_STATUS & (uint16_t)(SERCOM_USART_INT_STATUS_PERR_Msk | SERCOM_USART_INT_STATUS_FERR_Msk | SERCOM_USART_INT_STATUS_BUFOVF_Msk));
+
+    if (errorStatus != USART_ERROR_NONE)
+    {
+        /* Save the error so that it can be reported through SERCOM0_USART_ErrorGet */
+        sercom0USARTObj.errorStatus = errorStatus;
+
+        /* Clear the error flags and flush out the erroneous data */
+        SERCOM0_USART_ErrorClear();
+
+        if (sercom0USARTObj.rdCallback != NULL)
+        {
+            sercom0USARTObj.rdCallback(SERCOM_USART_EVENT_READ_ERROR, sercom0USARTObj.rdContext);
+        }
+    }
+}
+
+__STATIC_FORCEINLINE void SERCOM0_USART_ISR_RX_Handler( void )
+{
+    uint16_t rdData;
+
+    while ((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & (uint8_t)SERCOM_USART_INT_INTFLAG_RXC_Msk) == (uint8_t)SERCOM_USART_INT_INTFLAG_RXC_Msk)
+    {
+        rdData = (uint16_t)SERCOM0_REGS->USART_INT.SERCOM_DATA;
+
+        if (SERCOM0_USART_RxPushByte(rdData) == true)
+        {
+            SERCOM0_USART_ReadNotificationSend();
+        }
+    }
+}
+
+__STATIC_FORCEINLINE void SERCOM0_USART_ISR_TX_Handler( void )
+{
+    uint16_t wrByte;
+
+    while ((SERCOM0_REGS->USART_INT.SERCOM_INTFLAG & (uint8_t)SERCOM_USART_INT_INTFLAG_DRE_Msk) == (uint8_t)SERCOM_USART_INT_INTFLAG_DRE_Msk)
+    {
+        if (SERCOM0_USART_TxPullByte(&wrByte) == true)
+        {
+            SERCOM0_REGS->USART_INT.SERCOM_DATA = wrByte;
+
+            SERCOM0_USART_WriteNotificationSend();
+        }
+        else
+        {
+            /* Nothing to transmit. Disable the data register empty interrupt. */
+            SERCOM0_REGS->USART_INT.SERCOM_INTENCLR = (uint8_t)SERCOM_USART_INT_INTENCLR_DRE_Msk;
+            break;
+        }
+    }
+}
+
+/* Runs from SRAM. The ISR_*_Handler helpers and the ring accesses are forced
+ * inline so that no call leaves SRAM, except for the notification callbacks
+ * and, once per received frame, the TC3 restart in ISR_RXS_Handler. */
+RAMFUNC void SERCOM0_USART_InterruptHandler( void )
+{
+    uint8_t intEnable = SERCOM0_REGS->USART_INT.SERCOM_INTENSET;
+    uint8_t intFlag = SERCOM0_REGS->USART_INT.SERCOM_INTFLAG;
+
+    if (intEnable != 0U)
+    {
+        /* Checks for error flag */
+        if (((intFlag & SERCOM_USART_INT_INTFLAG_ERROR_Msk) == SERCOM_USART_INT_INTFLAG_ERROR_Msk) && ((intEnable & SERCOM_USART_INT_INTENSET_ERROR_Msk) == SERCOM_USART_INT_INTENSET_ERROR_Msk))
+        {
+            SERCOM0_USART_ISR_ERR_Handler();
+        }
+
+        /* Checks for receive complete empty flag */
+        if (((intFlag & SERCOM_USART_INT_INTFLAG_RXC_Msk) == SERCOM_USART_INT_INTFLAG_RXC_Msk) && ((intEnable & SERCOM_USART_INT_INTENSET_RXC_Msk) == SERCOM_USART_INT_INTENSET_RXC_Msk))
+        {
+            SERCOM0_USART_ISR_RX_Handler();
+        }
+
+        /* Checks for data register empty flag */
+        if (((intFlag & SERCOM_USART_INT_INTFLAG_DRE_Msk) == SERCOM_USART_INT_INTFLAG_DRE_Msk) && ((intEnable & SERCOM_USART_INT_INTENSET_DRE_Msk) == SERCOM_USART_INT_INTENSET_DRE_Msk))
+        {
+            SERCOM0_USART_ISR_TX_Handler();
+        }
+
+#ifdef SERCOM0_USART_RX_DMA_CHANNEL
+        /* Checks for receive start flag */
+        if (((intFlag & SERCOM_USART_INT_INTFLAG_RXS_Msk) == SERCOM_USART_INT_INTFLAG_RXS_Msk) && ((intEnable & SERCOM_USART_INT_INTENSET_RXS_Msk) == SERCOM_USART_INT_INTENSET_RXS_Msk))
+        {
+            SERCOM0_USART_ISR_RXS_Handler();
+        }
+#endif
+    }
+}
+
+#endif
+
+#ifdef SERCOM0_USART_RX_DMA_CHANNEL
+
+void SERCOM0_USART_FrameCallbackRegister( SERCOM_USART_FRAME_CALLBACK callback, uintptr_t context )
+{
+    sercom0USARTFrameObj.callback = callback;
+
+    sercom0USARTFrameObj.context = context;
+}
+
+#endif
+
+#ifdef SERCOM0_USART_TX_DMA_CHANNEL
+
+bool SERCOM0_USART_WriteDMA( const void *buffer, const size_t size, SERCOM_USART_CALLBACK callback, uintptr_t context )
+{
+    bool writeStatus = false;
+    bool is9Bit = SERCOM0_USART_Is9BitModeEnabled();
+    DMAC_CHANNEL_CONFIG settings;
+    uint32_t processorStatus;
+
+    if ((buffer != NULL) && (size > 0U))
+    {
+        /* Serialize against the ring and DMAC interrupt handlers */
+        processorStatus = __get_PRIMASK();
+        __disable_irq();
+
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+        if ((sercom0USARTDmaObj.txBusyStatus == false) && (SERCOM0_USART_WriteCountGet() == 0U))
+#else
+        if (sercom0USARTDmaObj.txBusyStatus == false)
+#endif
+        {
+            sercom0USARTDmaObj.txBuffer = (void*)buffer;
+            sercom0USARTDmaObj.txSize = size;
+            sercom0USARTDmaObj.txProcessedSize = 0U;
+            sercom0USARTDmaObj.txCallback = callback;
+            sercom0USARTDmaObj.txContext = context;
+
+            /* One beat per character, 16-bit wide in 9-bit mode */
+            settings = DMAC_ChannelSettingsGet(SERCOM0_USART_TX_DMA_CHANNEL) & (DMAC_CHANNEL_CONFIG)(~DMAC_BTCTRL_BEATSIZE_Msk);
+            settings |= (is9Bit == true) ? (DMAC_CHANNEL_CONFIG)DMAC_BTCTRL_BEATSIZE_HWORD : (DMAC_CHANNEL_CONFIG)DMAC_BTCTRL_BEATSIZE_BYTE;
+
+            if (DMAC_ChannelSettingsSet(SERCOM0_USART_TX_DMA_CHANNEL, settings) == true)
+            {
+                writeStatus = DMAC_ChannelTransfer(SERCOM0_USART_TX_DMA_CHANNEL, buffer, (const void*)&SERCOM0_REGS->USART_INT.SERCOM_DATA, (is9Bit == true) ? (size << 1U) : size);
+            }
+
+            sercom0USARTDmaObj.txBusyStatus = writeStatus;
+        }
+
+        __set_PRIMASK(processorStatus);
+    }
+
+    return writeStatus;
+}
+
+bool SERCOM0_USART_WriteDMAIsBusy( void )
+{
+    return sercom0USARTDmaObj.txBusyStatus;
+}
+
+size_t SERCOM0_USART_WriteDMACountGet( void )
+{
+    size_t count = sercom0USARTDmaObj.txProcessedSize;
+
+    if (sercom0USARTDmaObj.txBusyStatus == true)
+    {
+        count = (size_t)DMAC_ChannelGetTransferredCount(SERCOM0_USART_TX_DMA_CHANNEL);
+    }
+
+    return count;
 }
 
+#endif
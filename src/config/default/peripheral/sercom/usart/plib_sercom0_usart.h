@@ -51,6 +51,7 @@
 // *****************************************************************************
 // *****************************************************************************
 
+#include "configuration.h"
 #include "plib_sercom_usart_common.h"
 
 // DOM-IGNORE-BEGIN
@@ -103,6 +104,67 @@ USART_ERROR SERCOM0_USART_ErrorGet( void );
 
 uint32_t SERCOM0_USART_FrequencyGet( void );
 
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+
+RAMFUNC void SERCOM0_USART_InterruptHandler( void );
+
+size_t SERCOM0_USART_WriteAsync( const void *buffer, const size_t size );
+
+size_t SERCOM0_USART_WriteCountGet( void );
+
+size_t SERCOM0_USART_WriteFreeBufferCountGet( void );
+
+size_t SERCOM0_USART_WriteBufferSizeGet( void );
+
+bool SERCOM0_USART_WriteNotificationEnable( bool isEnabled, bool isPersistent );
+
+void SERCOM0_USART_WriteThresholdSet( uint32_t nBytesThreshold );
+
+void SERCOM0_USART_WriteCallbackRegister( SERCOM_USART_RING_BUFFER_CALLBACK callback, uintptr_t context );
+
+size_t SERCOM0_USART_ReadAvailable( void *buffer, const size_t size );
+
+size_t SERCOM0_USART_ReadCountGet( void );
+
+size_t SERCOM0_USART_ReadFreeBufferCountGet( void );
+
+size_t SERCOM0_USART_ReadBufferSizeGet( void );
+
+bool SERCOM0_USART_ReadNotificationEnable( bool isEnabled, bool isPersistent );
+
+void SERCOM0_USART_ReadThresholdSet( uint32_t nBytesThreshold );
+
+void SERCOM0_USART_ReadCallbackRegister( SERCOM_USART_RING_BUFFER_CALLBACK callback, uintptr_t context );
+
+#endif
+
+#ifdef SERCOM0_USART_RX_DMA_CHANNEL
+
+#ifndef SERCOM0_USART_RING_BUFFER_ENABLE
+#error "SERCOM0_USART_RX_DMA_CHANNEL requires SERCOM0_USART_RING_BUFFER_ENABLE"
+#endif
+
+/* The callback runs from the TC3 interrupt once the line has been idle for a
+ * timer period; frameSize characters are then available to
+ * SERCOM0_USART_ReadAvailable. */
+void SERCOM0_USART_FrameCallbackRegister( SERCOM_USART_FRAME_CALLBACK callback, uintptr_t context );
+
+#endif
+
+#ifdef SERCOM0_USART_TX_DMA_CHANNEL
+
+/* The buffer is transmitted in place and must stay valid until the callback
+ * runs (from the DMAC interrupt). size is in characters. Returns false while a
+ * DMA write or queued ring data is pending. In blocking mode do not call
+ * SERCOM0_USART_Write/WriteByte until the DMA write has completed. */
+bool SERCOM0_USART_WriteDMA( const void *buffer, const size_t size, SERCOM_USART_CALLBACK callback, uintptr_t context );
+
+bool SERCOM0_USART_WriteDMAIsBusy( void );
+
+size_t SERCOM0_USART_WriteDMACountGet( void );
+
+#endif
+
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus  // Provide C++ Compatibility
 
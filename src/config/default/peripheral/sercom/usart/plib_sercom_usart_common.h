@@ -374,6 +374,48 @@ typedef struct
 
 } SERCOM_USART_RING_BUFFER_OBJECT;
 
+// *****************************************************************************
+/* Frame Callback Function Pointer
+
+  Summary:
+    Defines the data type and function signature for the USART idle-line
+    frame callback function.
+
+  Description:
+    The USART peripheral calls back the client's function with this signature
+    when the receive line goes idle after frameSize characters were received.
+
+  Remarks:
+    None.
+*/
+
+typedef void (*SERCOM_USART_FRAME_CALLBACK)( size_t frameSize, uintptr_t context );
+
+// *****************************************************************************
+/* SERCOM USART Frame Object
+
+  Summary:
+    Defines the data type for the idle-line framing state.
+
+  Description:
+    This may be used for DMA receive with idle-line framing.
+
+  Remarks:
+    None.
+*/
+
+typedef struct
+{
+    SERCOM_USART_FRAME_CALLBACK                         callback;
+
+    uintptr_t                                           context;
+
+    size_t                                              frameSize;
+
+    bool                                                isLineActive;
+
+} SERCOM_USART_FRAME_OBJECT;
+
 
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus  // Provide C++ Compatibility
@@ -41,14 +41,18 @@
 #include "device.h"
 #include "interrupts.h"
 #include "plib_systick.h"
+#include "peripheral/clock/plib_clock.h"
 
+volatile static SYSTICK_OBJECT systick;
 
 void SYSTICK_TimerInitialize ( void )
 {
     SysTick->CTRL = 0U;
     SysTick->VAL = 0U;
     SysTick->LOAD = 0xbb80U - 1U;
-    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk;
+    SysTick->CTRL = SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_CLKSOURCE_Msk;
+
+    systick.callback = NULL;
 }
 
 void SYSTICK_TimerRestart ( void )
@@ -86,7 +90,7 @@ uint32_t SYSTICK_TimerCounterGet ( void )
 
 uint32_t SYSTICK_TimerFrequencyGet ( void )
 {
-    return (SYSTICK_FREQ);
+    return CLOCK_FrequencyGet();
 }
 
 void SYSTICK_DelayMs ( uint32_t delay_ms)
@@ -97,7 +101,7 @@ void SYSTICK_DelayMs ( uint32_t delay_ms)
    period = SysTick->LOAD + 1U;
 
    /* Calculate the count for the given delay */
-   delayCount=(SYSTICK_FREQ/1000U)*delay_ms;
+   delayCount=(SYSTICK_TimerFrequencyGet()/1000U)*delay_ms;
 
    if((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) == SysTick_CTRL_ENABLE_Msk)
    {
@@ -127,7 +131,7 @@ void SYSTICK_DelayUs ( uint32_t delay_us)
    period = SysTick->LOAD + 1U;
 
     /* Calculate the count for the given delay */
-   delayCount=(SYSTICK_FREQ/1000000U)*delay_us;
+   delayCount=(SYSTICK_TimerFrequencyGet()/1000000U)*delay_us;
 
    if((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) == SysTick_CTRL_ENABLE_Msk)
    {
@@ -155,3 +159,19 @@ bool SYSTICK_TimerPeriodHasExpired(void)
    return ((SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) > 0U);
 }
 
+void SYSTICK_TimerCallbackSet ( SYSTICK_CALLBACK callback, uintptr_t context )
+{
+   systick.callback = callback;
+
+   systick.context = context;
+}
+
+void SYSTICK_TimerInterruptHandler( void )
+{
+   if(systick.callback != NULL)
+   {
+       uintptr_t context = systick.context;
+
+       systick.callback(context);
+   }
+}
@@ -55,8 +55,18 @@
 // *****************************************************************************
 // *****************************************************************************
 
+/* SysTick clock with GCLK0 undivided; SYSTICK_TimerFrequencyGet returns the
+   current one */
 #define SYSTICK_FREQ   48000000U
 
+typedef void (*SYSTICK_CALLBACK)(uintptr_t context);
+
+typedef struct
+{
+   SYSTICK_CALLBACK          callback;
+   uintptr_t                 context;
+} SYSTICK_OBJECT ;
+
 
 /***************************** SYSTICK API *******************************/
 void SYSTICK_TimerInitialize ( void );
@@ -71,6 +81,8 @@ void SYSTICK_DelayMs ( uint32_t delay_ms );
 void SYSTICK_DelayUs ( uint32_t delay_us );
 
 bool SYSTICK_TimerPeriodHasExpired(void);
+void SYSTICK_TimerCallbackSet ( SYSTICK_CALLBACK callback, uintptr_t context );
+void SYSTICK_TimerInterruptHandler ( void );
 #ifdef __cplusplus // Provide C++ Compatibility
  }
 #endif
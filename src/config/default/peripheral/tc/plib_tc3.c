@@ -0,0 +1,227 @@
+/*******************************************************************************
+  Timer/Counter(TC3) PLIB
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_tc3.c
+
+  Summary
+    TC3 PLIB Implementation File.
+
+  Description
+    This file defines the interface to the TC peripheral library. This
+    library provides access to and control of the associated peripheral
+    instance.
+
+  Remarks:
+    None.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+/*  This section lists the other files that are included in this file.
+*/
+
+#include "interrupts.h"
+#include "plib_tc3.h"
+#include "peripheral/clock/plib_clock.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+volatile static TC_TIMER_CALLBACK_OBJ TC3_CallbackObject;
+
+/* Period for the GCLK0 frequency being switched to */
+static uint16_t TC3_PendingPeriod;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: TC3 Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+/* Called by CLOCK_FrequencySet with interrupts masked. The period keeps its
+ * length in time; a GCLK0 change that cannot express it is refused. */
+static bool TC3_ClockHandler( CLOCK_EVENT event, uint32_t frequency, uintptr_t context )
+{
+    uint64_t period;
+
+    (void)context;
+
+    if (event == CLOCK_EVENT_CHANGE_PENDING)
+    {
+        period = ((uint64_t)TC3_REGS->COUNT16.TC_CC[0U] + 1U) * frequency / CLOCK_FrequencyGet();
+        if ((period == 0U) || (period > 0x10000U))
+        {
+            return false;
+        }
+
+        TC3_PendingPeriod = (uint16_t)(period - 1U);
+    }
+    else
+    {
+        TC3_Timer16bitPeriodSet(TC3_PendingPeriod);
+    }
+
+    return true;
+}
+
+/* Initialize the TC module in Timer mode. GCLK0 (48 MHz) / 16 gives a 3 MHz
+ * count; the period is 1500 counts (500 us). */
+void TC3_TimerInitialize( void )
+{
+    /* Reset TC */
+    TC3_REGS->COUNT16.TC_CTRLA = TC_CTRLA_SWRST_Msk;
+
+    while((TC3_REGS->COUNT16.TC_STATUS & TC_STATUS_SYNCBUSY_Msk) != 0U)
+    {
+        /* Wait for Write Synchronization */
+    }
+
+    /* Configure counter mode & prescaler */
+    TC3_REGS->COUNT16.TC_CTRLA = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_PRESCALER_DIV16 | TC_CTRLA_WAVEGEN_MFRQ ;
+
+    /* Configure timer period */
+    TC3_REGS->COUNT16.TC_CC[0U] = 1499U;
+
+    /* Clear all interrupt flags */
+    TC3_REGS->COUNT16.TC_INTFLAG = (uint8_t)TC_INTFLAG_Msk;
+
+    TC3_CallbackObject.callback = NULL;
+
+    (void)CLOCK_CallbackRegister(TC3_ClockHandler, 0U);
+
+    /* Enable interrupt*/
+    TC3_REGS->COUNT16.TC_INTENSET = (uint8_t)(TC_INTENSET_OVF_Msk);
+
+    while((TC3_REGS->COUNT16.TC_STATUS & TC_STATUS_SYNCBUSY_Msk) != 0U)
+    {
+        /* Wait for Write Synchronization */
+    }
+}
+
+/* Enable the TC counter */
+void TC3_TimerStart( void )
+{
+    TC3_REGS->COUNT16.TC_CTRLA |= TC_CTRLA_ENABLE_Msk;
+
+    while((TC3_REGS->COUNT16.TC_STATUS & TC_STATUS_SYNCBUSY_Msk) != 0U)
+    {
+        /* Wait for Write Synchronization */
+    }
+}
+
+/* Disable the TC counter */
+void TC3_TimerStop( void )
+{
+    TC3_REGS->COUNT16.TC_CTRLA &= ~TC_CTRLA_ENABLE_Msk;
+
+    while((TC3_REGS->COUNT16.TC_STATUS & TC_STATUS_SYNCBUSY_Msk) != 0U)
+    {
+        /* Wait for Write Synchronization */
+    }
+}
+
+uint32_t TC3_TimerFrequencyGet( void )
+{
+    return CLOCK_FrequencyGet() / 16U;
+}
+
+/* Configure timer period */
+void TC3_Timer16bitPeriodSet( uint16_t period )
+{
+    TC3_REGS->COUNT16.TC_CC[0U] = period;
+
+    while((TC3_REGS->COUNT16.TC_STATUS & TC_STATUS_SYNCBUSY_Msk) != 0U)
+    {
+        /* Wait for Write Synchronization */
+    }
+}
+
+/* Read the timer period value */
+uint16_t TC3_Timer16bitPeriodGet( void )
+{
+    return (uint16_t)TC3_REGS->COUNT16.TC_CC[0U];
+}
+
+/* Get the current timer counter value */
+uint16_t TC3_Timer16bitCounterGet( void )
+{
+    /* Write command to force COUNT register read synchronization */
+    TC3_REGS->COUNT16.TC_READREQ = TC_READREQ_RREQ_Msk | (uint16_t)TC_READREQ_ADDR(0x10U);
+
+    while((TC3_REGS->COUNT16.TC_STATUS & TC_STATUS_SYNCBUSY_Msk) != 0U)
+    {
+        /* Wait for Write Synchronization */
+    }
+
+    /* Read current count value */
+    return (uint16_t)TC3_REGS->COUNT16.TC_COUNT;
+}
+
+/* Configure timer counter value */
+void TC3_Timer16bitCounterSet( uint16_t count )
+{
+    TC3_REGS->COUNT16.TC_COUNT = count;
+
+    while((TC3_REGS->COUNT16.TC_STATUS & TC_STATUS_SYNCBUSY_Msk) != 0U)
+    {
+        /* Wait for Write Synchronization */
+    }
+}
+
+/* Register callback function */
+void TC3_TimerCallbackRegister( TC_TIMER_CALLBACK callback, uintptr_t context )
+{
+    TC3_CallbackObject.callback = callback;
+
+    TC3_CallbackObject.context = context;
+}
+
+/* Timer Interrupt handler */
+void TC3_TimerInterruptHandler( void )
+{
+    TC_TIMER_STATUS status;
+
+    if (TC3_REGS->COUNT16.TC_INTENSET != 0U)
+    {
+        status = (TC_TIMER_STATUS) TC3_REGS->COUNT16.TC_INTFLAG;
+
+        /* Clear interrupt flags */
+        TC3_REGS->COUNT16.TC_INTFLAG = (uint8_t)TC_INTFLAG_Msk;
+
+        if((status != TC_TIMER_STATUS_NONE) && (TC3_CallbackObject.callback != NULL))
+        {
+            TC3_CallbackObject.callback(status, TC3_CallbackObject.context);
+        }
+    }
+}
@@ -0,0 +1,219 @@
+/*******************************************************************************
+  Timer/Counter(TC4) PLIB
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_tc4.c
+
+  Summary
+    TC4 PLIB Implementation File.
+
+  Description
+    This file defines the interface to the TC peripheral library. This
+    library provides access to and control of the associated peripheral
+    instance.
+
+  Remarks:
+    None.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+/*  This section lists the other files that are included in this file.
+*/
+
+#include "interrupts.h"
+#include "plib_tc4.h"
+#include "peripheral/clock/plib_clock.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+volatile static TC_TIMER_CALLBACK_OBJ TC4_CallbackObject;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: TC4 Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+/* Initialize the TC module in 32-bit Timer mode, TC4 paired with TC5. GCLK0
+ * (48 MHz) undivided, so one count is one CPU cycle. */
+void TC4_TimerInitialize( void )
+{
+    /* Reset TC */
+    TC4_REGS->COUNT32.TC_CTRLA = TC_CTRLA_SWRST_Msk;
+
+    while((TC4_REGS->COUNT32.TC_STATUS & TC_STATUS_SYNCBUSY_Msk) != 0U)
+    {
+        /* Wait for Write Synchronization */
+    }
+
+    /* Configure counter mode & prescaler */
+    TC4_REGS->COUNT32.TC_CTRLA = TC_CTRLA_MODE_COUNT32 | TC_CTRLA_PRESCALER_DIV1 | TC_CTRLA_WAVEGEN_MFRQ ;
+
+    /* Configure timer period */
+    TC4_REGS->COUNT32.TC_CC[0U] = 0xFFFFFFFFU;
+
+    /* Clear all interrupt flags */
+    TC4_REGS->COUNT32.TC_INTFLAG = (uint8_t)TC_INTFLAG_Msk;
+
+    TC4_CallbackObject.callback = NULL;
+
+    /* Enable interrupt*/
+    TC4_REGS->COUNT32.TC_INTENSET = (uint8_t)(TC_INTENSET_OVF_Msk);
+
+    while((TC4_REGS->COUNT32.TC_STATUS & TC_STATUS_SYNCBUSY_Msk) != 0U)
+    {
+        /* Wait for Write Synchronization */
+    }
+}
+
+/* Enable the TC counter */
+void TC4_TimerStart( void )
+{
+    TC4_REGS->COUNT32.TC_CTRLA |= TC_CTRLA_ENABLE_Msk;
+
+    while((TC4_REGS->COUNT32.TC_STATUS & TC_STATUS_SYNCBUSY_Msk) != 0U)
+    {
+        /* Wait for Write Synchronization */
+    }
+
+    /* Keep COUNT synchronized so that reads return at once */
+    TC4_REGS->COUNT32.TC_READREQ = TC_READREQ_RCONT_Msk | TC_READREQ_RREQ_Msk | (uint16_t)TC_READREQ_ADDR(0x10U);
+
+    while((TC4_REGS->COUNT32.TC_STATUS & TC_STATUS_SYNCBUSY_Msk) != 0U)
+    {
+        /* Wait for Read Synchronization */
+    }
+}
+
+/* Disable the TC counter */
+void TC4_TimerStop( void )
+{
+    TC4_REGS->COUNT32.TC_CTRLA &= ~TC_CTRLA_ENABLE_Msk;
+
+    while((TC4_REGS->COUNT32.TC_STATUS & TC_STATUS_SYNCBUSY_Msk) != 0U)
+    {
+        /* Wait for Write Synchronization */
+    }
+}
+
+uint32_t TC4_TimerFrequencyGet( void )
+{
+    return CLOCK_FrequencyGet();
+}
+
+/* Configure timer period */
+void TC4_Timer32bitPeriodSet( uint32_t period )
+{
+    TC4_REGS->COUNT32.TC_CC[0U] = period;
+
+    while((TC4_REGS->COUNT32.TC_STATUS & TC_STATUS_SYNCBUSY_Msk) != 0U)
+    {
+        /* Wait for Write Synchronization */
+    }
+}
+
+/* Read the timer period value */
+uint32_t TC4_Timer32bitPeriodGet( void )
+{
+    return TC4_REGS->COUNT32.TC_CC[0U];
+}
+
+/* Get the current timer counter value */
+uint32_t TC4_Timer32bitCounterGet( void )
+{
+    /* COUNT is read-synchronized continuously while the timer runs */
+    if ((TC4_REGS->COUNT32.TC_READREQ & TC_READREQ_RCONT_Msk) == 0U)
+    {
+        /* Write command to force COUNT register read synchronization */
+        TC4_REGS->COUNT32.TC_READREQ = TC_READREQ_RREQ_Msk | (uint16_t)TC_READREQ_ADDR(0x10U);
+
+        while((TC4_REGS->COUNT32.TC_STATUS & TC_STATUS_SYNCBUSY_Msk) != 0U)
+        {
+            /* Wait for Read Synchronization */
+        }
+    }
+
+    /* Read current count value */
+    return TC4_REGS->COUNT32.TC_COUNT;
+}
+
+/* Configure timer counter value */
+void TC4_Timer32bitCounterSet( uint32_t count )
+{
+    TC4_REGS->COUNT32.TC_COUNT = count;
+
+    while((TC4_REGS->COUNT32.TC_STATUS & TC_STATUS_SYNCBUSY_Msk) != 0U)
+    {
+        /* Wait for Write Synchronization */
+    }
+}
+
+/* Check whether the counter reached the period, and clear the flag */
+bool TC4_TimerPeriodHasExpired( void )
+{
+    bool timer_status;
+
+    timer_status = ((TC4_REGS->COUNT32.TC_INTFLAG & TC_INTFLAG_OVF_Msk) != 0U);
+    TC4_REGS->COUNT32.TC_INTFLAG = (uint8_t)TC_INTFLAG_OVF_Msk;
+
+    return timer_status;
+}
+
+/* Register callback function */
+void TC4_TimerCallbackRegister( TC_TIMER_CALLBACK callback, uintptr_t context )
+{
+    TC4_CallbackObject.callback = callback;
+
+    TC4_CallbackObject.context = context;
+}
+
+/* Timer Interrupt handler */
+void TC4_TimerInterruptHandler( void )
+{
+    TC_TIMER_STATUS status;
+
+    if (TC4_REGS->COUNT32.TC_INTENSET != 0U)
+    {
+        status = (TC_TIMER_STATUS) TC4_REGS->COUNT32.TC_INTFLAG;
+
+        /* Clear interrupt flags */
+        TC4_REGS->COUNT32.TC_INTFLAG = (uint8_t)TC_INTFLAG_Msk;
+
+        if((status != TC_TIMER_STATUS_NONE) && (TC4_CallbackObject.callback != NULL))
+        {
+            TC4_CallbackObject.callback(status, TC4_CallbackObject.context);
+        }
+    }
+}
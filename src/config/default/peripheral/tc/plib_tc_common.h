@@ -0,0 +1,144 @@
+/*******************************************************************************
+  TC Peripheral Library Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_tc_common.h
+
+  Summary
+    TC peripheral library interface.
+
+  Description
+    This file defines the interface to the TC peripheral library. This
+    library provides access to and control of the associated peripheral
+    instance.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef PLIB_TC_COMMON_H    // Guards against multiple inclusion
+#define PLIB_TC_COMMON_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* TC Timer interrupt status
+
+  Summary:
+    Identifies TC timer interrupt source mask.
+
+  Description:
+    This data type identifies the TC timer interrupt source mask.
+
+  Remarks:
+    None.
+*/
+
+typedef uint32_t TC_TIMER_STATUS;
+
+/* No interrupt */
+#define TC_TIMER_STATUS_NONE        (0U)
+
+/* Timer overflow */
+#define TC_TIMER_STATUS_OVERFLOW    (TC_INTFLAG_OVF_Msk)
+
+/* Timer match */
+#define TC_TIMER_STATUS_MATCH       (TC_INTFLAG_MC1_Msk)
+
+// *****************************************************************************
+/* TC Timer Callback Function Pointer
+
+  Summary:
+    Defines the data type and function signature for the TC timer callback
+    function.
+
+  Description:
+    This data type defines the function signature for the TC timer callback
+    function. The library calls back the client's function with this
+    signature from the interrupt routine.
+
+  Remarks:
+    None.
+*/
+
+typedef void (*TC_TIMER_CALLBACK) (TC_TIMER_STATUS status, uintptr_t context);
+
+// *****************************************************************************
+/* TC Timer Callback Object
+
+  Summary:
+    TC timer peripheral callback object.
+
+  Description:
+    This local data object holds the function signature for the TC timer
+    peripheral callback function.
+
+  Remarks:
+    None.
+*/
+
+typedef struct
+{
+    TC_TIMER_CALLBACK callback;
+
+    uintptr_t context;
+
+} TC_TIMER_CALLBACK_OBJ;
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // PLIB_TC_COMMON_H
@@ -28,6 +28,7 @@
 #include <stddef.h>
 #include "device.h"
 #include "interrupts.h"
+#include "system/int/sys_int.h"
 
 /*
  *  The MPLAB X Simulator does not yet support simulation of programming the
@@ -90,7 +91,7 @@ void __attribute__((optimize("-O1"),long_call))Dummy_App_Func(void)
  */
 void __attribute__((optimize("-O1"), section(".text.Reset_Handler"), long_call, noreturn)) Reset_Handler(void)
 {
-#ifdef SCB_VTOR_TBLOFF_Msk
+#if defined(SCB_VTOR_TBLOFF_Msk) && !defined(SYS_INT_VECTOR_TABLE_RAM)
     uint32_t *pSrc;
 #endif
 
@@ -116,7 +117,10 @@ void __attribute__((optimize("-O1"), section(".text.Reset_Handler"), long_call,
     __pic32c_data_initialization();
 
 
-#  ifdef SCB_VTOR_TBLOFF_Msk
+#  if defined(SYS_INT_VECTOR_TABLE_RAM)
+    /*  Run from a copy of the vector table in RAM */
+    SYS_INT_VectorTableInitialize();
+#  elif defined(SCB_VTOR_TBLOFF_Msk)
     /*  Set the vector-table base address in FLASH */
     pSrc = (uint32_t *) & __svectors;
     SCB->VTOR = ((uint32_t) pSrc & SCB_VTOR_TBLOFF_Msk);
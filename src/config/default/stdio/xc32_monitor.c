@@ -44,30 +44,60 @@ extern int read(int handle, void *buffer, unsigned int len);
 extern int write(int handle, void * buffer, size_t count);
 
 
+/* Blocks until at least one character is available, then returns everything
+ * already received (up to len) so buffered stdin fills in a single call. */
 int read(int handle, void *buffer, unsigned int len)
 {
     int nChars = 0;
-    bool success = false;
+    uint8_t *pu8Buffer = (uint8_t*)buffer;
+
     if ((handle == 0)  && (len > 0U))
     {
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
         do
         {
-            success = SERCOM0_USART_Read(buffer, 1);
+            nChars = (int)SERCOM0_USART_ReadAvailable(pu8Buffer, len);
+        }while(nChars == 0);
+#else
+        bool success = false;
+
+        do
+        {
+            success = SERCOM0_USART_Read(pu8Buffer, 1);
         }while( !success);
         nChars = 1;
+
+        while(((unsigned int)nChars < len) && (SERCOM0_USART_ReceiverIsReady() == true))
+        {
+            pu8Buffer[nChars] = (uint8_t)SERCOM0_USART_ReadByte();
+            nChars++;
+        }
+#endif
     }
     return nChars;
 }
 
+/* stdout and stderr. In ring buffer mode the characters are queued and sent
+ * by the SERCOM0 interrupt, so this only waits while the ring is full. */
 int write(int handle, void * buffer, size_t count)
 {
-   bool success = false;
-   if (handle == 1)
+   if ((handle == 1) || (handle == 2))
    {
+#ifdef SERCOM0_USART_RING_BUFFER_ENABLE
+       size_t nChars = 0U;
+
+       while(nChars < count)
+       {
+           nChars += SERCOM0_USART_WriteAsync(&((const uint8_t*)buffer)[nChars], count - nChars);
+       }
+#else
+       bool success = false;
+
        do
        {
            success = SERCOM0_USART_Write(buffer, count);
        }while( !success);
+#endif
    }
    return (int)count;
 }
\ No newline at end of file
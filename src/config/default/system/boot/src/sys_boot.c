@@ -0,0 +1,179 @@
+/*******************************************************************************
+  Boot System Service Implementation File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_boot.c
+
+  Summary
+    Boot system service implementation.
+
+  Description
+    _on_reset, which the reset handler calls before the C run-time data
+    initialization, starts SysTick as a free-running 24-bit down-counter of
+    CPU cycles. Marks take the cycles since the previous mark from it until
+    SYSTICK_TimerInitialize reloads SysTick; SYS_TIME_Now, which counts from
+    SYS_TIME_Initialize, is used from then on.
+
+  Remarks:
+    _on_reset runs before .data and .bss are set up, so it only touches
+    registers.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdio.h>
+#include "device.h"
+#include "system/time/sys_time.h"
+#include "system/boot/sys_boot.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_BOOT_SYSTICK_MAX        (0x00FFFFFFU)
+
+typedef struct
+{
+    const char  *phase;
+    uint32_t    cycles;
+    uint32_t    cpuFrequency;
+} SYS_BOOT_MARK_OBJECT;
+
+#if defined(SYS_BOOT_PROFILE_ENABLE)
+
+static SYS_BOOT_MARK_OBJECT sysBootMarks[SYS_BOOT_MARK_COUNT];
+static uint32_t sysBootMarkCount;
+
+/* SysTick value at the last mark while it runs freely */
+static uint32_t sysBootLastCount;
+
+/* SYS_TIME_Now at the last mark once SYS_TIME runs */
+static uint64_t sysBootLastTime;
+static bool sysBootIsTimeRunning;
+
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+#if defined(SYS_BOOT_FAST) || defined(SYS_BOOT_PROFILE_ENABLE)
+/* Called by Reset_Handler before the data initialization */
+void _on_reset( void )
+{
+#if defined(SYS_BOOT_FAST)
+    /* 8 MHz instead of 1 MHz for the start-up code and until the DFLL runs.
+       The flash needs no wait states at this frequency. */
+    SYSCTRL_REGS->SYSCTRL_OSC8M = (SYSCTRL_REGS->SYSCTRL_OSC8M & ~SYSCTRL_OSC8M_PRESC_Msk) | SYSCTRL_OSC8M_PRESC(0U);
+#endif
+
+#if defined(SYS_BOOT_PROFILE_ENABLE)
+    SysTick->CTRL = 0U;
+    SysTick->LOAD = SYS_BOOT_SYSTICK_MAX;
+    SysTick->VAL = 0U;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+#endif
+}
+#endif
+
+void SYS_BOOT_Mark( const char *phase, uint32_t cpuFrequency )
+{
+#if defined(SYS_BOOT_PROFILE_ENABLE)
+    uint32_t count;
+    uint32_t cycles;
+    uint64_t now;
+
+    if (sysBootMarkCount == 0U)
+    {
+        /* SysTick loaded SYS_BOOT_SYSTICK_MAX on its first cycle */
+        sysBootLastCount = SYS_BOOT_SYSTICK_MAX;
+    }
+
+    if (SysTick->LOAD == SYS_BOOT_SYSTICK_MAX)
+    {
+        count = SysTick->VAL;
+        cycles = (sysBootLastCount - count) & SYS_BOOT_SYSTICK_MAX;
+        sysBootLastCount = count;
+    }
+    else
+    {
+        now = SYS_TIME_Now();
+        cycles = (sysBootIsTimeRunning == true) ? (uint32_t)(now - sysBootLastTime) : (uint32_t)now;
+        sysBootLastTime = now;
+        sysBootIsTimeRunning = true;
+    }
+
+    if (sysBootMarkCount < SYS_BOOT_MARK_COUNT)
+    {
+        sysBootMarks[sysBootMarkCount].phase = phase;
+        sysBootMarks[sysBootMarkCount].cycles = cycles;
+        sysBootMarks[sysBootMarkCount].cpuFrequency = cpuFrequency;
+        sysBootMarkCount++;
+    }
+#else
+    (void)phase;
+    (void)cpuFrequency;
+#endif
+}
+
+void SYS_BOOT_Print( void )
+{
+#if defined(SYS_BOOT_PROFILE_ENABLE)
+    const SYS_BOOT_MARK_OBJECT *mark;
+    uint32_t total = 0U;
+    uint32_t us;
+    uint32_t i;
+
+    printf("\r\n%-24s %10s %10s %10s\r\n", "boot phase", "cycles", "us", "since reset");
+
+    for (i = 0U; i < sysBootMarkCount; i++)
+    {
+        mark = &sysBootMarks[i];
+        us = (uint32_t)(((uint64_t)mark->cycles * 1000000U) / mark->cpuFrequency);
+        total += us;
+
+        printf("%-24s %10lu %10lu %10lu\r\n", mark->phase, (unsigned long)mark->cycles,
+               (unsigned long)us, (unsigned long)total);
+    }
+#else
+    printf("\r\nboot profile: SYS_BOOT_PROFILE_ENABLE is not defined\r\n");
+#endif
+}
@@ -0,0 +1,196 @@
+/*******************************************************************************
+  Boot System Service Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_boot.h
+
+  Summary
+    Boot phase timestamps and the fast boot start-up.
+
+  Description
+    This file defines the interface to the boot system service. SysTick runs
+    freely from the reset handler until SYS_TIME takes it over, so the time
+    spent in the C start-up code and in every phase of SYS_Initialize can be
+    measured. SYS_BOOT_Print lists the phases.
+
+    With SYS_BOOT_FAST the CPU leaves reset at the full OSC8M frequency instead
+    of OSC8M / 8, and SYS_Initialize initializes the modules that do not need
+    GCLK0 while the DFLL starts. Buffers defined with SYS_BOOT_NO_INIT are
+    left out of the .bss zero fill.
+
+  Remarks:
+    The marks are compiled in when SYS_BOOT_PROFILE_ENABLE is defined.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_BOOT_H    // Guards against multiple inclusion
+#define SYS_BOOT_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+#ifndef SYS_BOOT_MARK_COUNT
+#define SYS_BOOT_MARK_COUNT         (16U)
+#endif
+
+/* CPU clock out of reset: OSC8M divided by 8, or undivided with SYS_BOOT_FAST */
+#if defined(SYS_BOOT_FAST)
+#define SYS_BOOT_RESET_CPU_FREQUENCY    (8000000U)
+#else
+#define SYS_BOOT_RESET_CPU_FREQUENCY    (1000000U)
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Macro:
+    SYS_BOOT_MARK(phase, cpuFrequency)
+
+  Summary:
+    Ends a boot phase.
+
+  Description:
+    Calls SYS_BOOT_Mark when SYS_BOOT_PROFILE_ENABLE is defined and expands
+    to nothing otherwise.
+
+  Example:
+    <code>
+    NVMCTRL_Initialize();
+    DMAC_Initialize();
+    SYS_BOOT_MARK("nvmctrl, dmac", CPU_CLOCK_FREQUENCY);
+    </code>
+
+  Remarks:
+    None.
+*/
+
+#if defined(SYS_BOOT_PROFILE_ENABLE)
+#define SYS_BOOT_MARK(phase, cpuFrequency)      SYS_BOOT_Mark((phase), (cpuFrequency))
+#else
+#define SYS_BOOT_MARK(phase, cpuFrequency)
+#endif
+
+// *****************************************************************************
+/* Function:
+    void SYS_BOOT_Mark( const char *phase, uint32_t cpuFrequency )
+
+   Summary:
+    Records the end of a boot phase.
+
+   Description:
+    This function stores the CPU cycles since the previous mark, or since
+    the reset handler for the first one, with the name of the phase.
+
+   Precondition:
+    None. Up to SYS_BOOT_MARK_COUNT marks are kept; later ones are ignored.
+
+   Parameters:
+    phase        - Name of the phase that ends, a string constant.
+    cpuFrequency - CPU clock in Hz during the phase, to convert the cycles
+                   to time.
+
+   Returns:
+    None.
+
+  Example:
+    See SYS_BOOT_MARK.
+
+  Remarks:
+    Before SYS_TIME_Initialize a phase must be shorter than 2^24 cycles; the
+    cycles of SYSTICK_TimerInitialize itself are not counted.
+*/
+
+void SYS_BOOT_Mark( const char *phase, uint32_t cpuFrequency );
+
+// *****************************************************************************
+/* Function:
+    void SYS_BOOT_Print( void )
+
+   Summary:
+    Prints the boot phases on the console.
+
+   Description:
+    For every mark this function prints the phase, its cycles and its time
+    in microseconds, and the time since reset.
+
+   Precondition:
+    The console must have been initialized.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    if (command == 'b')
+    {
+        SYS_BOOT_Print();
+    }
+    </code>
+
+  Remarks:
+    Prints through stdio, so it must not be called from an interrupt.
+*/
+
+void SYS_BOOT_Print( void );
+
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_BOOT_H
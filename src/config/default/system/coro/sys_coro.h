@@ -0,0 +1,362 @@
+/*******************************************************************************
+  Coroutine System Service Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_coro.h
+
+  Summary
+    Stackless coroutines for cooperative tasks.
+
+  Description
+    This file defines macros that let a SYS_SCHED task be written as a
+    linear sequence of steps that wait for conditions, delays or other
+    coroutines. A coroutine is a function that returns whenever it has to
+    wait; its continuation, the line it stopped at, is kept in a SYS_CORO
+    variable and the next call resumes from there. No stack is kept across
+    the wait, so a coroutine costs two bytes of RAM.
+
+  Remarks:
+    Local variables do not survive a wait; keep state that must in static
+    or task data. The macros expand to case labels of a switch statement
+    opened by SYS_CORO_BEGIN, so a coroutine body cannot contain a switch
+    of its own around a wait, and only one wait macro may be used per
+    source line.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_CORO_H    // Guards against multiple inclusion
+#define SYS_CORO_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "configuration.h"
+#include "system/sched/sys_sched.h"
+#include "system/tmr/sys_tmr.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Coroutine Continuation
+
+   Summary:
+    Where a coroutine resumes.
+
+   Description:
+    Holds the source line of the wait the coroutine stopped at, or 0 to
+    start from SYS_CORO_BEGIN.
+
+   Remarks:
+    Zeroed storage is a coroutine at its start.
+*/
+
+typedef uint16_t SYS_CORO;
+
+// *****************************************************************************
+/* Coroutine Status
+
+   Summary:
+    Returned by every call of a coroutine.
+
+   Description:
+    Tells the caller whether the coroutine waits for a signal, wants to run
+    again as soon as possible, or has finished.
+
+   Remarks:
+    None.
+*/
+
+typedef enum
+{
+    /* Waiting for a condition that an event will make true */
+    SYS_CORO_WAITING = 0,
+
+    /* Gave up the CPU and wants to run again */
+    SYS_CORO_YIELDED,
+
+    /* Reached SYS_CORO_END or SYS_CORO_EXIT */
+    SYS_CORO_DONE
+
+} SYS_CORO_STATUS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Coroutine Macros
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Macros:
+    SYS_CORO_INIT( coro )
+    SYS_CORO_BEGIN( coro )
+    SYS_CORO_END( coro )
+    SYS_CORO_EXIT( coro )
+
+   Summary:
+    Delimit the body of a coroutine.
+
+   Description:
+    SYS_CORO_INIT rewinds a coroutine to its start. SYS_CORO_BEGIN opens the
+    body and jumps to the wait the coroutine stopped at. SYS_CORO_END closes
+    the body; reaching it, or SYS_CORO_EXIT anywhere in the body, rewinds
+    the coroutine and returns SYS_CORO_DONE.
+
+   Example:
+    <code>
+    static SYS_CORO_STATUS APP_Run( SYS_CORO *coro )
+    {
+        SYS_CORO_BEGIN(coro);
+
+        SYS_CORO_WAIT_UNTIL(coro, appData.isReady);
+
+        SYS_CORO_END(coro);
+    }
+    </code>
+
+   Remarks:
+    The function must return SYS_CORO_STATUS.
+*/
+
+#define SYS_CORO_INIT(coro)         do { *(coro) = 0U; } while (false)
+
+#define SYS_CORO_BEGIN(coro)        switch (*(coro)) { case 0U:
+
+#define SYS_CORO_END(coro)          default: break; } *(coro) = 0U; return SYS_CORO_DONE
+
+#define SYS_CORO_EXIT(coro)         do { *(coro) = 0U; return SYS_CORO_DONE; } while (false)
+
+// *****************************************************************************
+/* Macro:
+    SYS_CORO_WAIT_UNTIL( coro, condition )
+
+   Summary:
+    Waits until a condition is true.
+
+   Description:
+    Evaluates the condition and returns SYS_CORO_WAITING while it is false.
+    The condition is evaluated again every time the coroutine is called.
+
+   Example:
+    <code>
+    SYS_CORO_WAIT_UNTIL(coro, SERCOM0_USART_ReadCountGet() >= 4U);
+    </code>
+
+   Remarks:
+    Whatever makes the condition true must signal the task that runs the
+    coroutine, e.g. from the interrupt callback; nothing polls it.
+*/
+
+#define SYS_CORO_WAIT_UNTIL(coro, condition)                                 \
+    do                                                                       \
+    {                                                                        \
+        *(coro) = (SYS_CORO)__LINE__;                                        \
+        case __LINE__:                                                       \
+        if (!(condition))                                                    \
+        {                                                                    \
+            return SYS_CORO_WAITING;                                         \
+        }                                                                    \
+    } while (false)
+
+// *****************************************************************************
+/* Macro:
+    SYS_CORO_YIELD( coro )
+
+   Summary:
+    Lets the other tasks run before continuing.
+
+   Description:
+    Returns SYS_CORO_YIELDED once; the next call continues after the macro.
+    SYS_CORO_TaskRun signals the task again, so it runs on the next
+    scheduler pass.
+
+   Example:
+    <code>
+    for (appData.block = 0U; appData.block < 16U; appData.block++)
+    {
+        APP_BlockProcess(appData.block);
+        SYS_CORO_YIELD(coro);
+    }
+    </code>
+
+   Remarks:
+    None.
+*/
+
+#define SYS_CORO_YIELD(coro)                                                 \
+    do                                                                       \
+    {                                                                        \
+        *(coro) = (SYS_CORO)__LINE__;                                        \
+        return SYS_CORO_YIELDED;                                             \
+        case __LINE__:                                                       \
+        ;                                                                    \
+    } while (false)
+
+// *****************************************************************************
+/* Macro:
+    SYS_CORO_AWAIT( coro, call )
+
+   Summary:
+    Runs a child coroutine to completion.
+
+   Description:
+    Calls the child coroutine and returns its status until it returns
+    SYS_CORO_DONE, so a yield or a wait in the child suspends the parent as
+    well. The child's continuation must be rewound before the first await.
+
+   Example:
+    <code>
+    SYS_CORO_INIT(&appData.writeCoro);
+    SYS_CORO_AWAIT(coro, APP_FrameWrite(&appData.writeCoro, frame));
+    </code>
+
+   Remarks:
+    The child is typically a multi-step driver transaction with its own
+    SYS_CORO kept next to the parent's.
+*/
+
+#define SYS_CORO_AWAIT(coro, call)                                           \
+    do                                                                       \
+    {                                                                        \
+        SYS_CORO_STATUS sysCoroStatus;                                       \
+        *(coro) = (SYS_CORO)__LINE__;                                        \
+        case __LINE__:                                                       \
+        sysCoroStatus = (call);                                              \
+        if (sysCoroStatus != SYS_CORO_DONE)                                  \
+        {                                                                    \
+            return sysCoroStatus;                                            \
+        }                                                                    \
+    } while (false)
+
+// *****************************************************************************
+/* Macro:
+    SYS_CORO_DELAY( coro, task, delayMs )
+
+   Summary:
+    Waits for a time.
+
+   Description:
+    Starts the SYS_SCHED timer of the task that runs the coroutine and waits
+    until it has expired. The expiry signals the task.
+
+   Example:
+    <code>
+    LED_On();
+    SYS_CORO_DELAY(coro, &appData.task, 250U);
+    LED_Off();
+    </code>
+
+   Remarks:
+    The task timer must not be used for anything else during the delay.
+*/
+
+#define SYS_CORO_DELAY(coro, task, delayMs)                                  \
+    do                                                                       \
+    {                                                                        \
+        (void)SYS_SCHED_TimerStart((task), (delayMs), 0U);                   \
+        SYS_CORO_WAIT_UNTIL((coro), !SYS_TMR_IsActive(&(task)->timer));      \
+    } while (false)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    SYS_CORO_STATUS SYS_CORO_TaskRun( SYS_SCHED_TASK *task,
+                                      SYS_CORO_STATUS status )
+
+   Summary:
+    Completes a task step that ran a coroutine.
+
+   Description:
+    Signals the task again when the coroutine yielded, so that it resumes on
+    the next scheduler pass. Waiting and finished coroutines are left until
+    the task is signaled.
+
+   Parameters:
+    task   - Task that ran the coroutine.
+    status - Value returned by the coroutine.
+
+   Returns:
+    The status, unchanged.
+
+   Example:
+    <code>
+    void APP_Tasks( uint32_t events, uintptr_t context )
+    {
+        appData.events |= events;
+        (void)SYS_CORO_TaskRun(&appData.task, APP_Run(&appData.coro));
+    }
+    </code>
+
+   Remarks:
+    None.
+*/
+
+static inline SYS_CORO_STATUS SYS_CORO_TaskRun( SYS_SCHED_TASK *task,
+                                                SYS_CORO_STATUS status )
+{
+    if (status == SYS_CORO_YIELDED)
+    {
+        SYS_SCHED_EventSignal(task, 0U);
+    }
+
+    return status;
+}
+
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_CORO_H
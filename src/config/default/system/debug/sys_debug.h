@@ -57,6 +57,9 @@
 #ifdef SYS_DEBUG_USE_CONSOLE
 #include "system/console/sys_console.h"
 #endif
+#ifdef SYS_DEBUG_USE_LOG
+#include "system/log/sys_log.h"
+#endif
 
 
 // DOM-IGNORE-BEGIN
@@ -529,6 +532,24 @@ SYS_MODULE_INDEX SYS_DEBUG_ConsoleInstanceGet(void);
 
 #endif
 
+/*  Defining SYS_DEBUG_USE_LOG instead maps the macros to the deferred binary
+    log service. Messages still pass the global error level check, but only
+    the format ID and the arguments are recorded, so the format and the
+    message must be string literals.
+*/
+
+#ifdef SYS_DEBUG_USE_LOG
+
+#ifndef SYS_DEBUG_MESSAGE
+    #define SYS_DEBUG_MESSAGE(level, message)   do { if((uint32_t)(level) <= (uint32_t)SYS_DEBUG_ErrorLevelGet()) { SYS_LOG_PRINT(level, message); } }while(false)
+#endif
+
+#ifndef SYS_DEBUG_PRINT
+    #define SYS_DEBUG_PRINT(level, fmt, ...)    do { if((uint32_t)(level) <= (uint32_t)SYS_DEBUG_ErrorLevelGet()) { SYS_LOG_PRINT(level, fmt, ##__VA_ARGS__); } }while(false)
+#endif
+
+#endif
+
 #ifndef SYS_CONSOLE_PRINT
     #define SYS_CONSOLE_PRINT(fmt, ...)
 #endif
@@ -0,0 +1,253 @@
+/*******************************************************************************
+  Fault Capture System Service Implementation File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_fault.c
+
+  Summary
+    Fault capture system service implementation.
+
+  Description
+    The persistent record is a NO_INIT variable: the start-up code neither
+    loads nor clears it, so it keeps its contents across a reset as long as
+    the supply does. A magic number and a checksum tell a stored record from
+    the random contents after power-up.
+
+  Remarks:
+    None.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdio.h>
+#include "device.h"
+#include "system/fault/sys_fault.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Changes with the record layout, so a record of an older build is ignored */
+#define SYS_FAULT_MAGIC             (0xFA170000U | (SYS_FAULT_STACK_WORDS))
+
+/* r0, r1, r2, r3, r12, lr, pc and xPSR */
+#define SYS_FAULT_FRAME_WORDS       (8U)
+
+#define SYS_FAULT_CHECKSUM_WORDS    (offsetof(SYS_FAULT_RECORD, checksum) / sizeof(uint32_t))
+
+static SYS_FAULT_RECORD sysFaultPersistent NO_INIT;
+
+/* Record taken over at boot, valid when sysFaultHasRecord is true */
+static SYS_FAULT_RECORD sysFaultLast;
+static bool sysFaultHasRecord;
+
+/* Reason of the HardFault that SYS_FAULT_Raise is taking */
+static volatile SYS_FAULT_REASON sysFaultRaised;
+
+static const char * const sysFaultReasonNames[] =
+{
+    "none", "hardfault", "nmi", "assert", "stack overflow", "malloc failed",
+    "task block"
+};
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t SYS_FAULT_Checksum( const SYS_FAULT_RECORD *record )
+{
+    const uint32_t *words = (const uint32_t *)record;
+    uint32_t sum = 0x5EEDU;
+    uint32_t i;
+
+    for (i = 0U; i < SYS_FAULT_CHECKSUM_WORDS; i++)
+    {
+        sum = ((sum << 1) | (sum >> 31)) + words[i];
+    }
+
+    return ~sum;
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_FAULT_Initialize( void )
+{
+    sysFaultHasRecord = false;
+    sysFaultRaised = SYS_FAULT_REASON_NONE;
+
+    if ((sysFaultPersistent.magic == SYS_FAULT_MAGIC) &&
+        (sysFaultPersistent.stackWords <= SYS_FAULT_STACK_WORDS) &&
+        (sysFaultPersistent.checksum == SYS_FAULT_Checksum(&sysFaultPersistent)))
+    {
+        sysFaultLast = sysFaultPersistent;
+        sysFaultHasRecord = true;
+    }
+
+    sysFaultPersistent.magic = 0U;
+}
+
+const SYS_FAULT_RECORD *SYS_FAULT_RecordGet( void )
+{
+    return (sysFaultHasRecord == true) ? &sysFaultLast : NULL;
+}
+
+void SYS_FAULT_Report( void )
+{
+    const SYS_FAULT_RECORD *record = &sysFaultLast;
+    uint32_t i;
+
+    if (sysFaultHasRecord == false)
+    {
+        return;
+    }
+
+    printf("\r\nFAULT reason %lu %s rcause 0x%02x\r\n", (unsigned long)record->reason,
+           (record->reason < (sizeof(sysFaultReasonNames) / sizeof(sysFaultReasonNames[0]))) ?
+           sysFaultReasonNames[record->reason] : "unknown",
+           (unsigned int)PM_REGS->PM_RCAUSE);
+    printf("FAULT r0 %08lx r1 %08lx r2 %08lx r3 %08lx\r\n", (unsigned long)record->r0,
+           (unsigned long)record->r1, (unsigned long)record->r2, (unsigned long)record->r3);
+    printf("FAULT r12 %08lx lr %08lx pc %08lx xpsr %08lx\r\n", (unsigned long)record->r12,
+           (unsigned long)record->lr, (unsigned long)record->pc, (unsigned long)record->xpsr);
+    printf("FAULT sp %08lx exc_return %08lx\r\n", (unsigned long)record->sp,
+           (unsigned long)record->excReturn);
+
+    /* Eight words per line, each line starting with its address */
+    for (i = 0U; i < record->stackWords; i++)
+    {
+        if ((i % 8U) == 0U)
+        {
+            printf("FAULT stack %08lx:", (unsigned long)(record->sp + ((SYS_FAULT_FRAME_WORDS + i) * 4U)));
+        }
+        printf(" %08lx", (unsigned long)record->stack[i]);
+        if (((i % 8U) == 7U) || ((i + 1U) == record->stackWords))
+        {
+            printf("\r\n");
+        }
+    }
+
+    printf("FAULT end\r\n");
+}
+
+void SYS_FAULT_Raise( SYS_FAULT_REASON reason )
+{
+    sysFaultRaised = reason;
+
+    /* Undefined instruction: HardFault, with this function's pc and its
+       caller's lr stacked */
+    __asm volatile ("udf #0");
+
+    while (true)
+    {
+        /* Not reached */
+    }
+}
+
+void SYS_FAULT_Capture( const uint32_t *frame, uint32_t excReturn, SYS_FAULT_REASON reason )
+{
+    SYS_FAULT_RECORD *record = &sysFaultPersistent;
+    uint32_t address = (uint32_t)frame;
+    uint32_t words = 0U;
+    uint32_t i;
+
+    __disable_irq();
+
+    if ((reason == SYS_FAULT_REASON_HARDFAULT) && (sysFaultRaised != SYS_FAULT_REASON_NONE))
+    {
+        reason = sysFaultRaised;
+    }
+
+    record->magic = SYS_FAULT_MAGIC;
+    record->reason = (uint32_t)reason;
+    record->sp = address;
+    record->excReturn = excReturn;
+
+    /* A stack pointer outside SRAM is a stack overflow or corruption; reading
+       through it would fault again and lock the core up */
+    if (((address & 3U) == 0U) && (address >= HMCRAMC0_ADDR) &&
+        (address <= ((HMCRAMC0_ADDR + HMCRAMC0_SIZE) - (SYS_FAULT_FRAME_WORDS * 4U))))
+    {
+        record->r0 = frame[0];
+        record->r1 = frame[1];
+        record->r2 = frame[2];
+        record->r3 = frame[3];
+        record->r12 = frame[4];
+        record->lr = frame[5];
+        record->pc = frame[6];
+        record->xpsr = frame[7];
+
+        words = (((HMCRAMC0_ADDR + HMCRAMC0_SIZE) - address) / 4U) - SYS_FAULT_FRAME_WORDS;
+        if (words > SYS_FAULT_STACK_WORDS)
+        {
+            words = SYS_FAULT_STACK_WORDS;
+        }
+        for (i = 0U; i < words; i++)
+        {
+            record->stack[i] = frame[SYS_FAULT_FRAME_WORDS + i];
+        }
+    }
+    else
+    {
+        record->r0 = 0U;
+        record->r1 = 0U;
+        record->r2 = 0U;
+        record->r3 = 0U;
+        record->r12 = 0U;
+        record->lr = 0U;
+        record->pc = 0U;
+        record->xpsr = 0U;
+    }
+
+    record->stackWords = words;
+    record->checksum = SYS_FAULT_Checksum(record);
+    __DSB();
+
+#if defined(__DEBUG) || defined(__DEBUG_D) && defined(__XC32)
+    __builtin_software_breakpoint();
+#endif
+
+    NVIC_SystemReset();
+}
@@ -0,0 +1,333 @@
+/*******************************************************************************
+  Fault Capture System Service Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_fault.h
+
+  Summary
+    Crash records that survive the reset after a fault.
+
+  Description
+    This file defines the interface to the fault capture system service. The
+    HardFault and NMI handlers in exceptions.c, and SYS_FAULT_Raise, store the
+    stacked registers, a snapshot of the stack above them and the reason in a
+    RAM record that the start-up code does not initialize, then reset the
+    device. On the next boot SYS_FAULT_Initialize takes the record over and
+    SYS_FAULT_Report prints it for tools/crash_decoder.py.
+
+  Remarks:
+    The Cortex-M0+ has no fault status registers; the reason only tells the
+    exception, or the software check that raised it. The record is lost when
+    the device loses power.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_FAULT_H    // Guards against multiple inclusion
+#define SYS_FAULT_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+#ifndef SYS_FAULT_STACK_WORDS
+#define SYS_FAULT_STACK_WORDS       (32U)
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Fault Reason
+
+  Summary:
+    What stopped the firmware.
+
+  Description:
+    HARDFAULT and NMI are the exceptions. The others are raised by software
+    with SYS_FAULT_Raise.
+
+  Remarks:
+    The values are printed by SYS_FAULT_Report and decoded by
+    tools/crash_decoder.py.
+*/
+
+typedef enum
+{
+    SYS_FAULT_REASON_NONE = 0,
+    SYS_FAULT_REASON_HARDFAULT,
+    SYS_FAULT_REASON_NMI,
+    SYS_FAULT_REASON_ASSERT,
+    SYS_FAULT_REASON_STACK_OVERFLOW,
+    SYS_FAULT_REASON_MALLOC_FAILED,
+    SYS_FAULT_REASON_TASK_BLOCK,
+
+} SYS_FAULT_REASON;
+
+// *****************************************************************************
+/* Fault Record
+
+  Summary:
+    State of the CPU when the fault was taken.
+
+  Description:
+    r0 to xpsr are the exception frame the core stacked, at address sp.
+    stack holds the stackWords words that follow the frame, which include
+    the return addresses of the interrupted call chain.
+
+  Remarks:
+    excReturn bit 2 tells whether sp was the process stack (an RTOS task) or
+    the main stack. The frame is not captured, and stackWords is 0, when sp
+    did not point into SRAM.
+*/
+
+typedef struct
+{
+    uint32_t            magic;
+    uint32_t            reason;
+    uint32_t            r0;
+    uint32_t            r1;
+    uint32_t            r2;
+    uint32_t            r3;
+    uint32_t            r12;
+    uint32_t            lr;
+    uint32_t            pc;
+    uint32_t            xpsr;
+    uint32_t            sp;
+    uint32_t            excReturn;
+    uint32_t            stackWords;
+    uint32_t            stack[SYS_FAULT_STACK_WORDS];
+    uint32_t            checksum;
+
+} SYS_FAULT_RECORD;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_FAULT_Initialize( void )
+
+   Summary:
+    Takes over the record of a fault before the last reset.
+
+   Description:
+    This function checks the persistent record. A valid one is copied for
+    SYS_FAULT_RecordGet and SYS_FAULT_Report, and the persistent copy is
+    invalidated so that it only reports once.
+
+   Precondition:
+    None.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    SYS_FAULT_Initialize();
+    </code>
+
+  Remarks:
+    Called from SYS_Initialize.
+*/
+
+void SYS_FAULT_Initialize( void );
+
+// *****************************************************************************
+/* Function:
+    const SYS_FAULT_RECORD *SYS_FAULT_RecordGet( void )
+
+   Summary:
+    Returns the record of the fault before the last reset.
+
+   Description:
+    The application can store or forward the record itself.
+
+   Precondition:
+    SYS_FAULT_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    The record, or NULL when the last reset did not follow a fault.
+
+  Example:
+    <code>
+    const SYS_FAULT_RECORD *fault = SYS_FAULT_RecordGet();
+
+    if (fault != NULL)
+    {
+        (void)SYS_KV_Set(APP_KEY_FAULT_PC, &fault->pc, sizeof(fault->pc));
+    }
+    </code>
+
+  Remarks:
+    None.
+*/
+
+const SYS_FAULT_RECORD *SYS_FAULT_RecordGet( void );
+
+// *****************************************************************************
+/* Function:
+    void SYS_FAULT_Report( void )
+
+   Summary:
+    Prints the record of the fault before the last reset on the console.
+
+   Description:
+    Every line starts with "FAULT", followed by the reason, the reset cause,
+    the registers and the stack snapshot in hexadecimal. Nothing is printed
+    when the last reset did not follow a fault.
+
+   Precondition:
+    SYS_FAULT_Initialize must have been called and the console must be
+    initialized.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    $ python3 tools/crash_decoder.py cicd_project.X.production.elf console.txt
+    </code>
+
+  Remarks:
+    Called at the end of SYS_Initialize, once the interrupts are enabled.
+*/
+
+void SYS_FAULT_Report( void );
+
+// *****************************************************************************
+/* Function:
+    void SYS_FAULT_Raise( SYS_FAULT_REASON reason )
+
+   Summary:
+    Stops on a fatal software error, as a HardFault would.
+
+   Description:
+    This function takes a HardFault with reason in place of
+    SYS_FAULT_REASON_HARDFAULT. The record shows the caller of this function
+    in lr, and the device resets.
+
+   Precondition:
+    None.
+
+   Parameters:
+    reason - SYS_FAULT_REASON_ASSERT or a more specific reason.
+
+   Returns:
+    Does not return.
+
+  Example:
+    <code>
+    if (length > sizeof(buffer))
+    {
+        SYS_FAULT_Raise(SYS_FAULT_REASON_ASSERT);
+    }
+    </code>
+
+  Remarks:
+    A debugger halts in the HardFault handler first.
+*/
+
+void __attribute__((noreturn)) SYS_FAULT_Raise( SYS_FAULT_REASON reason );
+
+// *****************************************************************************
+/* Function:
+    void SYS_FAULT_Capture( const uint32_t *frame, uint32_t excReturn,
+                            SYS_FAULT_REASON reason )
+
+   Summary:
+    Stores the fault record and resets the device.
+
+   Description:
+    Called by the fault handlers with the stack pointer that holds the
+    exception frame and the EXC_RETURN value of the exception.
+
+   Precondition:
+    None.
+
+   Parameters:
+    frame     - Exception frame.
+    excReturn - lr on entry to the handler.
+    reason    - Exception taken.
+
+   Returns:
+    Does not return.
+
+  Example:
+    See HardFault_Handler in exceptions.c.
+
+  Remarks:
+    Runs with interrupts disabled and without using the C library. In debug
+    builds it stops at a breakpoint before the reset.
+*/
+
+void __attribute__((noreturn)) SYS_FAULT_Capture( const uint32_t *frame, uint32_t excReturn, SYS_FAULT_REASON reason );
+
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_FAULT_H
@@ -0,0 +1,332 @@
+/*******************************************************************************
+  Flash Job Queue System Service Implementation File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_flash.c
+
+  Summary
+    Flash job queue implementation.
+
+  Description
+    Jobs run from the NVMCTRL READY interrupt. Every interrupt finishes one
+    command (error check and verify) and starts the next one, or completes the
+    job and starts the next job in the queue.
+
+  Remarks:
+    None.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <string.h>
+#include "device.h"
+#include "peripheral/nvmctrl/plib_nvmctrl.h"
+#include "system/flash/sys_flash.h"
+
+#define SYS_FLASH_ALL_OPERATIONS    (SYS_FLASH_OPERATION_ERASE | SYS_FLASH_OPERATION_WRITE | SYS_FLASH_OPERATION_VERIFY)
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    SYS_FLASH_PHASE_ERASE = 0,
+    SYS_FLASH_PHASE_WRITE,
+    SYS_FLASH_PHASE_DONE
+
+} SYS_FLASH_PHASE;
+
+typedef struct
+{
+    uint32_t            operations;
+
+    uint32_t            address;
+
+    const uint8_t       *data;
+
+    uint32_t            length;
+
+    SYS_FLASH_CALLBACK  callback;
+
+    uintptr_t           context;
+
+} SYS_FLASH_JOB;
+
+typedef struct
+{
+    SYS_FLASH_JOB       queue[SYS_FLASH_QUEUE_SIZE];
+
+    uint32_t            head;
+
+    volatile uint32_t   count;
+
+    /* Progress of the job at the head of the queue */
+    SYS_FLASH_PHASE     phase;
+
+    uint32_t            offset;
+
+    bool                isCommandActive;
+
+    /* Set while SYS_FLASH_Process runs, so a callback that submits a job
+     * does not re-enter it */
+    bool                isProcessing;
+
+} SYS_FLASH_OBJECT;
+
+static SYS_FLASH_OBJECT sysFlashObj;
+
+/* Page image handed to the NVMCTRL: pads partial pages and avoids alignment
+ * requirements on the caller's data */
+static uint32_t sysFlashPage[NVMCTRL_FLASH_PAGESIZE / 4U];
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static bool SYS_FLASH_IsErased( uint32_t address, uint32_t size )
+{
+    const uint32_t *word = (const uint32_t *)address;
+    uint32_t i;
+
+    for (i = 0U; i < (size / 4U); i++)
+    {
+        if (word[i] != 0xFFFFFFFFU)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Checks the command that just completed and moves past it */
+static SYS_FLASH_RESULT SYS_FLASH_CommandFinish( const SYS_FLASH_JOB *job )
+{
+    SYS_FLASH_RESULT result = SYS_FLASH_RESULT_SUCCESS;
+    uint32_t address = job->address + sysFlashObj.offset;
+    bool isVerified = ((job->operations & (uint32_t)SYS_FLASH_OPERATION_VERIFY) != 0U);
+
+    if (NVMCTRL_ErrorGet() != NVMCTRL_ERROR_NONE)
+    {
+        result = SYS_FLASH_RESULT_NVM_ERROR;
+    }
+    else if (sysFlashObj.phase == SYS_FLASH_PHASE_ERASE)
+    {
+        /* Rows that are written afterwards are verified page by page */
+        if (isVerified && ((job->operations & (uint32_t)SYS_FLASH_OPERATION_WRITE) == 0U) &&
+            !SYS_FLASH_IsErased(address, NVMCTRL_FLASH_ROWSIZE))
+        {
+            result = SYS_FLASH_RESULT_VERIFY_ERROR;
+        }
+
+        sysFlashObj.offset += NVMCTRL_FLASH_ROWSIZE;
+    }
+    else
+    {
+        if (isVerified && (memcmp((const void *)address, sysFlashPage, NVMCTRL_FLASH_PAGESIZE) != 0))
+        {
+            result = SYS_FLASH_RESULT_VERIFY_ERROR;
+        }
+
+        sysFlashObj.offset += NVMCTRL_FLASH_PAGESIZE;
+    }
+
+    return result;
+}
+
+/* Starts the next command of the job, returns false once the job is done */
+static bool SYS_FLASH_CommandStart( const SYS_FLASH_JOB *job )
+{
+    uint32_t size;
+
+    if (sysFlashObj.phase == SYS_FLASH_PHASE_ERASE)
+    {
+        if (((job->operations & (uint32_t)SYS_FLASH_OPERATION_ERASE) != 0U) && (sysFlashObj.offset < job->length))
+        {
+            (void)NVMCTRL_RowErase(job->address + sysFlashObj.offset);
+            return true;
+        }
+
+        sysFlashObj.phase = SYS_FLASH_PHASE_WRITE;
+        sysFlashObj.offset = 0U;
+    }
+
+    if (sysFlashObj.phase == SYS_FLASH_PHASE_WRITE)
+    {
+        if (((job->operations & (uint32_t)SYS_FLASH_OPERATION_WRITE) != 0U) && (sysFlashObj.offset < job->length))
+        {
+            size = job->length - sysFlashObj.offset;
+
+            if (size > NVMCTRL_FLASH_PAGESIZE)
+            {
+                size = NVMCTRL_FLASH_PAGESIZE;
+            }
+
+            (void)memset(sysFlashPage, 0xFF, sizeof(sysFlashPage));
+            (void)memcpy(sysFlashPage, &job->data[sysFlashObj.offset], size);
+
+            (void)NVMCTRL_PageWrite(sysFlashPage, job->address + sysFlashObj.offset);
+            return true;
+        }
+
+        sysFlashObj.phase = SYS_FLASH_PHASE_DONE;
+    }
+
+    return false;
+}
+
+/* Runs with the NVMCTRL idle, either from its interrupt or from a submit
+ * that found the queue empty */
+static void SYS_FLASH_Process( void )
+{
+    SYS_FLASH_JOB *job;
+    SYS_FLASH_RESULT result;
+    SYS_FLASH_CALLBACK callback;
+    uintptr_t context;
+
+    sysFlashObj.isProcessing = true;
+
+    while (sysFlashObj.count > 0U)
+    {
+        job = &sysFlashObj.queue[sysFlashObj.head];
+        result = SYS_FLASH_RESULT_SUCCESS;
+
+        if (sysFlashObj.isCommandActive)
+        {
+            sysFlashObj.isCommandActive = false;
+            result = SYS_FLASH_CommandFinish(job);
+        }
+
+        if ((result == SYS_FLASH_RESULT_SUCCESS) && SYS_FLASH_CommandStart(job))
+        {
+            sysFlashObj.isCommandActive = true;
+            break;
+        }
+
+        /* Job done or failed: release its slot before the callback so the
+         * callback can queue a follow-up job */
+        callback = job->callback;
+        context = job->context;
+
+        sysFlashObj.head = (sysFlashObj.head + 1U) % SYS_FLASH_QUEUE_SIZE;
+        sysFlashObj.count--;
+        sysFlashObj.phase = SYS_FLASH_PHASE_ERASE;
+        sysFlashObj.offset = 0U;
+
+        if (callback != NULL)
+        {
+            callback(result, context);
+        }
+    }
+
+    sysFlashObj.isProcessing = false;
+}
+
+static void SYS_FLASH_EventHandler( uintptr_t context )
+{
+    SYS_FLASH_Process();
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_FLASH_Initialize( void )
+{
+    (void)memset(&sysFlashObj, 0, sizeof(sysFlashObj));
+
+    NVMCTRL_CallbackRegister(SYS_FLASH_EventHandler, 0U);
+}
+
+bool SYS_FLASH_JobSubmit( uint32_t operations, uint32_t address, const void *data, size_t length,
+                          SYS_FLASH_CALLBACK callback, uintptr_t context )
+{
+    uint32_t processorStatus;
+    SYS_FLASH_JOB *job;
+    bool isQueued = false;
+
+    /* A job must erase or write something; verify only checks those steps */
+    if ((length == 0U) || ((operations & ((uint32_t)SYS_FLASH_OPERATION_ERASE | (uint32_t)SYS_FLASH_OPERATION_WRITE)) == 0U) ||
+        ((operations & ~(uint32_t)SYS_FLASH_ALL_OPERATIONS) != 0U) ||
+        (((operations & (uint32_t)SYS_FLASH_OPERATION_ERASE) != 0U) && ((address % NVMCTRL_FLASH_ROWSIZE) != 0U)) ||
+        (((operations & (uint32_t)SYS_FLASH_OPERATION_WRITE) != 0U) && (((address % NVMCTRL_FLASH_PAGESIZE) != 0U) || (data == NULL))))
+    {
+        return false;
+    }
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    if (sysFlashObj.count < SYS_FLASH_QUEUE_SIZE)
+    {
+        job = &sysFlashObj.queue[(sysFlashObj.head + sysFlashObj.count) % SYS_FLASH_QUEUE_SIZE];
+
+        job->operations = operations;
+        job->address = address;
+        job->data = (const uint8_t *)data;
+        job->length = length;
+        job->callback = callback;
+        job->context = context;
+
+        sysFlashObj.count++;
+
+        /* Otherwise the running job picks it up when it completes */
+        if (!sysFlashObj.isCommandActive && !sysFlashObj.isProcessing)
+        {
+            SYS_FLASH_Process();
+        }
+
+        isQueued = true;
+    }
+
+    __set_PRIMASK(processorStatus);
+
+    return isQueued;
+}
+
+bool SYS_FLASH_IsBusy( void )
+{
+    return (sysFlashObj.count != 0U);
+}
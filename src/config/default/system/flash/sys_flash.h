@@ -0,0 +1,285 @@
+/*******************************************************************************
+  Flash Job Queue System Service Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_flash.h
+
+  Summary
+    Interrupt driven erase, write and verify jobs for the on-chip flash.
+
+  Description
+    This file defines the interface to the flash job queue system service. A
+    job erases the rows of a range, programs it page by page and verifies the
+    result. Jobs are queued and executed one NVMCTRL command at a time from
+    the NVMCTRL READY interrupt, so callers do not poll the NVMCTRL.
+
+    The SAMD21J18A has no read-while-write section: while a row erase or page
+    write is in progress every fetch from flash stalls, for code, constants
+    and the vector table in flash alike. Only the busy polling moved to the
+    interrupt; the CPU still waits for each command unless it runs from SRAM
+    (RAMFUNC code with SYS_INT_VECTOR_TABLE_RAM) or sleeps. Submit jobs when
+    that latency is acceptable, for example when the application is about to
+    go idle.
+
+  Remarks:
+    All program and erase commands must go through this service while it is
+    in use, since it owns the NVMCTRL callback.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_FLASH_H    // Guards against multiple inclusion
+#define SYS_FLASH_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Flash Job Operations
+
+   Summary:
+    Steps performed by a flash job.
+
+   Description:
+    The operations are flags that can be combined. They are performed in the
+    order erase, write, verify:
+
+    SYS_FLASH_OPERATION_ERASE  - Erases every row that the range touches. The
+                                 address must be row aligned.
+    SYS_FLASH_OPERATION_WRITE  - Programs the range page by page. The address
+                                 must be page aligned; a partial last page is
+                                 padded with 0xFF.
+    SYS_FLASH_OPERATION_VERIFY - Checks each page after it is written, or each
+                                 row after it is erased when nothing is
+                                 written.
+
+   Remarks:
+    None.
+*/
+
+typedef enum
+{
+    SYS_FLASH_OPERATION_ERASE = 0x1U,
+
+    SYS_FLASH_OPERATION_WRITE = 0x2U,
+
+    SYS_FLASH_OPERATION_VERIFY = 0x4U
+
+} SYS_FLASH_OPERATION;
+
+// *****************************************************************************
+/* Flash Job Result
+
+   Summary:
+    Outcome of a flash job, passed to its callback.
+
+   Description:
+    SYS_FLASH_RESULT_SUCCESS      - All operations completed.
+    SYS_FLASH_RESULT_NVM_ERROR    - The NVMCTRL reported a programming, lock or
+                                    NVM error. The job stopped at that command.
+    SYS_FLASH_RESULT_VERIFY_ERROR - The flash content does not match. The job
+                                    stopped at that page or row.
+
+   Remarks:
+    None.
+*/
+
+typedef enum
+{
+    SYS_FLASH_RESULT_SUCCESS = 0,
+
+    SYS_FLASH_RESULT_NVM_ERROR,
+
+    SYS_FLASH_RESULT_VERIFY_ERROR
+
+} SYS_FLASH_RESULT;
+
+// *****************************************************************************
+/* Flash Job Callback
+
+   Summary:
+    Called when a job completes or fails.
+
+   Description:
+    The callback runs in the NVMCTRL interrupt context. It may submit another
+    job.
+
+   Remarks:
+    None.
+*/
+
+typedef void (*SYS_FLASH_CALLBACK)( SYS_FLASH_RESULT result, uintptr_t context );
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_FLASH_Initialize( void )
+
+   Summary:
+    Empties the job queue and takes over the NVMCTRL callback.
+
+   Description:
+    This function empties the job queue and registers the service with the
+    NVMCTRL PLIB callback.
+
+   Precondition:
+    NVMCTRL_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    SYS_FLASH_Initialize();
+    </code>
+
+  Remarks:
+    None.
+*/
+
+void SYS_FLASH_Initialize( void );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_FLASH_JobSubmit( uint32_t operations, uint32_t address,
+                              const void *data, size_t length,
+                              SYS_FLASH_CALLBACK callback, uintptr_t context )
+
+   Summary:
+    Queues a flash job.
+
+   Description:
+    This function adds a job to the queue and starts it if the flash is idle.
+    The data is read page by page while the job runs, so it must stay valid
+    and unchanged until the callback is called.
+
+   Precondition:
+    SYS_FLASH_Initialize must have been called.
+
+   Parameters:
+    operations  - SYS_FLASH_OPERATION flags.
+    address     - Start of the range.
+    data        - Data to program. Not used without SYS_FLASH_OPERATION_WRITE.
+    length      - Size of the range in bytes.
+    callback    - Called with the result. May be NULL.
+    context     - Passed to the callback.
+
+   Returns:
+    true if the job was queued, false if the queue is full or the parameters
+    are invalid.
+
+  Example:
+    <code>
+    static uint32_t calibration[16];
+
+    (void)SYS_FLASH_JobSubmit(SYS_FLASH_OPERATION_ERASE | SYS_FLASH_OPERATION_WRITE | SYS_FLASH_OPERATION_VERIFY,
+                              APP_CALIBRATION_ADDRESS, calibration, sizeof(calibration),
+                              APP_CalibrationSaved, 0U);
+    </code>
+
+  Remarks:
+    Can be called from interrupt context.
+*/
+
+bool SYS_FLASH_JobSubmit( uint32_t operations, uint32_t address, const void *data, size_t length,
+                          SYS_FLASH_CALLBACK callback, uintptr_t context );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_FLASH_IsBusy( void )
+
+   Summary:
+    Returns true while jobs are queued or running.
+
+   Description:
+    This function returns true while jobs are queued or running.
+
+   Precondition:
+    SYS_FLASH_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    true if a job has not completed yet.
+
+  Example:
+    <code>
+    while (SYS_FLASH_IsBusy())
+    {
+    }
+    </code>
+
+  Remarks:
+    None.
+*/
+
+bool SYS_FLASH_IsBusy( void );
+
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_FLASH_H
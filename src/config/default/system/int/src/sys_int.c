@@ -50,8 +50,73 @@
 // Section: Included Files
 // *****************************************************************************
 // *****************************************************************************
+#include <stdio.h>
 #include "system/int/sys_int.h"
 #include "peripheral/nvic/plib_nvic.h"
+#include "device_vectors.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Handlers that have run, in order of their first run */
+static SYS_INT_STATS *sysIntStatsHead;
+static SYS_INT_STATS **sysIntStatsTail = &sysIntStatsHead;
+
+#if defined(SYS_INT_VECTOR_TABLE_RAM)
+
+/* Linker defined start of the flash vector table */
+extern uint32_t __svectors;
+
+#define SYS_INT_VECTOR_COUNT    (sizeof(H3DeviceVectors) / sizeof(uint32_t))
+
+typedef struct
+{
+    SYS_INT_HANDLER handler;
+    uintptr_t       context;
+} SYS_INT_HANDLER_ENTRY;
+
+/* VTOR needs the table aligned to its size rounded up to a power of two:
+   44 vectors of 4 bytes */
+static uint32_t sysIntVectorTable[SYS_INT_VECTOR_COUNT] __attribute__((aligned(256)));
+
+/* Handlers attached with SYS_INT_HandlerSet, indexed by vector number */
+static SYS_INT_HANDLER_ENTRY sysIntHandlers[SYS_INT_VECTOR_COUNT];
+
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void SYS_INT_StatsClear( SYS_INT_STATS *stats )
+{
+    stats->count = 0U;
+    stats->durationMin = 0U;
+    stats->durationMax = 0U;
+    stats->durationTotal = 0U;
+    stats->latencyCount = 0U;
+    stats->latencyMin = 0U;
+    stats->latencyMax = 0U;
+    stats->latencyTotal = 0U;
+}
+
+#if defined(SYS_INT_VECTOR_TABLE_RAM)
+/* Vector of every source attached with SYS_INT_HandlerSet. IPSR holds the
+   number of the active vector. */
+static void SYS_INT_Dispatch( void )
+{
+    const SYS_INT_HANDLER_ENTRY *entry = &sysIntHandlers[__get_IPSR()];
+
+    entry->handler(entry->context);
+}
+#endif
 
 
 // *****************************************************************************
@@ -100,3 +165,162 @@ void SYS_INT_SourceRestore( INT_SOURCE source, bool status )
     }
     return;
 }
+
+void SYS_INT_StatsRecord( SYS_INT_STATS *stats, uint32_t start, uint32_t latency )
+{
+    uint32_t now = SysTick->VAL;
+    uint32_t duration;
+    uint32_t processorStatus;
+
+    /* SysTick counts down and reloads with LOAD after 0 */
+    duration = (start >= now) ? (start - now) : (start + (SysTick->LOAD + 1U) - now);
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    if (stats->isRegistered == false)
+    {
+        stats->isRegistered = true;
+        stats->next = NULL;
+        *sysIntStatsTail = stats;
+        sysIntStatsTail = &stats->next;
+    }
+
+    if ((stats->count == 0U) || (duration < stats->durationMin))
+    {
+        stats->durationMin = duration;
+    }
+    if (duration > stats->durationMax)
+    {
+        stats->durationMax = duration;
+    }
+    stats->count++;
+    stats->durationTotal += duration;
+
+    if (latency != SYS_INT_STATS_LATENCY_NONE)
+    {
+        if ((stats->latencyCount == 0U) || (latency < stats->latencyMin))
+        {
+            stats->latencyMin = latency;
+        }
+        if (latency > stats->latencyMax)
+        {
+            stats->latencyMax = latency;
+        }
+        stats->latencyCount++;
+        stats->latencyTotal += latency;
+    }
+
+    __set_PRIMASK(processorStatus);
+}
+
+void SYS_INT_StatsReset( void )
+{
+    SYS_INT_STATS *stats;
+    uint32_t processorStatus;
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    for (stats = sysIntStatsHead; stats != NULL; stats = stats->next)
+    {
+        SYS_INT_StatsClear(stats);
+    }
+
+    __set_PRIMASK(processorStatus);
+}
+
+void SYS_INT_StatsPrint( void )
+{
+    SYS_INT_STATS *stats;
+    SYS_INT_STATS copy;
+    uint32_t processorStatus;
+
+    printf("\r\n%-10s %10s %8s %8s %8s %8s %8s %8s\r\n", "cycles", "count",
+           "lat min", "lat mean", "lat max", "dur min", "dur mean", "dur max");
+
+    /* Handlers are only ever appended, so the links stay valid */
+    for (stats = sysIntStatsHead; stats != NULL; stats = stats->next)
+    {
+        processorStatus = __get_PRIMASK();
+        __disable_irq();
+
+        copy = *stats;
+
+        __set_PRIMASK(processorStatus);
+
+        printf("%-10s %10lu ", copy.name, (unsigned long)copy.count);
+
+        if (copy.latencyCount == 0U)
+        {
+            printf("%8s %8s %8s ", "-", "-", "-");
+        }
+        else
+        {
+            printf("%8lu %8lu %8lu ", (unsigned long)copy.latencyMin,
+                   (unsigned long)(copy.latencyTotal / copy.latencyCount),
+                   (unsigned long)copy.latencyMax);
+        }
+
+        printf("%8lu %8lu %8lu\r\n", (unsigned long)copy.durationMin,
+               (unsigned long)((copy.count == 0U) ? 0U : (copy.durationTotal / copy.count)),
+               (unsigned long)copy.durationMax);
+    }
+}
+
+void SYS_INT_VectorTableInitialize( void )
+{
+#if defined(SYS_INT_VECTOR_TABLE_RAM)
+    const uint32_t *flashTable = &__svectors;
+    uint32_t index;
+
+    for (index = 0U; index < SYS_INT_VECTOR_COUNT; index++)
+    {
+        sysIntVectorTable[index] = flashTable[index];
+    }
+
+    /* The table must be written before the core fetches from it */
+    __DSB();
+    SCB->VTOR = ((uint32_t)sysIntVectorTable & SCB_VTOR_TBLOFF_Msk);
+    __DSB();
+    __ISB();
+#endif
+}
+
+bool SYS_INT_HandlerSet( INT_SOURCE source, SYS_INT_HANDLER handler, uintptr_t context )
+{
+#if defined(SYS_INT_VECTOR_TABLE_RAM)
+    uint32_t index;
+    uint32_t processorStatus;
+
+    /* Reset, NMI and HardFault stay in place */
+    if ((source < SVCall_IRQn) || (source > PERIPH_MAX_IRQn))
+    {
+        return false;
+    }
+
+    index = (uint32_t)((int32_t)source + 16);
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    if (handler == NULL)
+    {
+        sysIntVectorTable[index] = (&__svectors)[index];
+        sysIntHandlers[index].handler = NULL;
+        sysIntHandlers[index].context = 0U;
+    }
+    else
+    {
+        sysIntHandlers[index].handler = handler;
+        sysIntHandlers[index].context = context;
+        sysIntVectorTable[index] = (uint32_t)SYS_INT_Dispatch;
+    }
+
+    __set_PRIMASK(processorStatus);
+
+    return true;
+#else
+    return false;
+#endif
+}
@@ -58,6 +58,8 @@
 */
 
 #include <stdbool.h>
+#include <stdint.h>
+#include "configuration.h"
 #include "device.h"
 
 // DOM-IGNORE-BEGIN
@@ -499,6 +501,303 @@ void SYS_INT_SourceStatusClear( INT_SOURCE aSrcSelection  );
 
 /* MISRAC 2012 deviation block end */
 
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interrupt Statistics
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Interrupt Statistics Object
+
+   Summary:
+    Latency and duration statistics of one interrupt handler.
+
+   Description:
+    SYS_INT_STATS_MEASURE keeps one of these per wrapped handler. Times are
+    in CPU cycles, taken from the SysTick counter. The duration runs from
+    the first instruction of the handler to its return and includes the
+    handlers that preempted it. The latency runs from the interrupt event
+    to the first instruction of the handler and is only known for sources
+    that time their own event, such as SysTick and the timers.
+
+   Remarks:
+    The members are private to the service.
+*/
+
+typedef struct SYS_INT_STATS
+{
+    struct SYS_INT_STATS    *next;
+
+    const char              *name;
+
+    bool                    isRegistered;
+
+    uint32_t                count;
+    uint32_t                durationMin;
+    uint32_t                durationMax;
+    uint64_t                durationTotal;
+
+    uint32_t                latencyCount;
+    uint32_t                latencyMin;
+    uint32_t                latencyMax;
+    uint64_t                latencyTotal;
+
+} SYS_INT_STATS;
+
+/* Latency argument of SYS_INT_STATS_MEASURE for sources without an event
+ * timestamp */
+#define SYS_INT_STATS_LATENCY_NONE          (0xFFFFFFFFU)
+
+/* Latency of the SysTick interrupt: the counter reloaded at the event */
+#define SYS_INT_STATS_LATENCY_SYSTICK       (SysTick->LOAD - sysIntStatsStart)
+
+// *****************************************************************************
+/* Macro:
+    SYS_INT_STATS_MEASURE(vector, latency, code)
+
+   Summary:
+    Runs the body of an interrupt handler and records its statistics.
+
+   Description:
+    Wraps the body of a handler in interrupts.c. vector names the statistics
+    in the report; latency is evaluated first thing in the handler and gives
+    the cycles since the interrupt event, or SYS_INT_STATS_LATENCY_NONE.
+    Without SYS_INT_STATS_ENABLE only the code runs.
+
+  Example:
+    <code>
+    void DMAC_Handler( void )
+    {
+        SYS_INT_STATS_MEASURE(DMAC, SYS_INT_STATS_LATENCY_NONE,
+                              DMAC_InterruptHandler());
+    }
+    </code>
+
+  Remarks:
+    Durations and latencies must be shorter than one SysTick period, as the
+    counter is only compared within a period.
+*/
+
+#if defined(SYS_INT_STATS_ENABLE)
+#define SYS_INT_STATS_MEASURE(vector, latency, code)                    \
+    do                                                                  \
+    {                                                                   \
+        static SYS_INT_STATS sysIntStats = { .name = #vector };         \
+        uint32_t sysIntStatsStart = SysTick->VAL;                       \
+        uint32_t sysIntStatsLatency = (latency);                        \
+        code;                                                           \
+        SYS_INT_StatsRecord(&sysIntStats, sysIntStatsStart,             \
+                            sysIntStatsLatency);                        \
+    } while (false)
+#else
+#define SYS_INT_STATS_MEASURE(vector, latency, code)                    \
+    do                                                                  \
+    {                                                                   \
+        code;                                                           \
+    } while (false)
+#endif
+
+// *****************************************************************************
+/* Function:
+    void SYS_INT_StatsRecord( SYS_INT_STATS *stats, uint32_t start,
+                              uint32_t latency )
+
+   Summary:
+    Records one run of an interrupt handler.
+
+   Description:
+    This function adds the cycles from start, a SysTick counter value, to
+    now and the latency to the statistics, and adds them to the report the
+    first time.
+
+   Precondition:
+    None.
+
+   Parameters:
+    stats   - Statistics of the handler.
+    start   - SysTick counter value at the handler entry.
+    latency - Cycles from the event to the entry, or
+              SYS_INT_STATS_LATENCY_NONE.
+
+   Returns:
+    None.
+
+  Example:
+    See SYS_INT_STATS_MEASURE, which calls it.
+
+  Remarks:
+    None.
+*/
+
+void SYS_INT_StatsRecord( SYS_INT_STATS *stats, uint32_t start, uint32_t latency );
+
+// *****************************************************************************
+/* Function:
+    void SYS_INT_StatsReset( void )
+
+   Summary:
+    Clears the statistics of all interrupt handlers.
+
+   Description:
+    This function starts a new measurement period.
+
+   Precondition:
+    None.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    SYS_INT_StatsReset();
+    </code>
+
+  Remarks:
+    None.
+*/
+
+void SYS_INT_StatsReset( void );
+
+// *****************************************************************************
+/* Function:
+    void SYS_INT_StatsPrint( void )
+
+   Summary:
+    Prints the interrupt statistics on the console.
+
+   Description:
+    For every handler that has run this function prints the count and the
+    minimum, mean and maximum latency and duration in CPU cycles. A latency
+    of "-" is not measured for the handler.
+
+   Precondition:
+    The console must have been initialized.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    if (command == 'i')
+    {
+        SYS_INT_StatsPrint();
+    }
+    </code>
+
+  Remarks:
+    Prints through stdio, so it must not be called from an interrupt.
+*/
+
+void SYS_INT_StatsPrint( void );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Vector Table
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Interrupt Handler
+
+   Summary:
+    Handler attached to an interrupt source with SYS_INT_HandlerSet.
+
+   Description:
+    The context given to SYS_INT_HandlerSet is passed back on every call, so
+    one function can serve all the instances of a peripheral.
+
+   Remarks:
+    None.
+*/
+
+typedef void (*SYS_INT_HANDLER)( uintptr_t context );
+
+// *****************************************************************************
+/* Function:
+    void SYS_INT_VectorTableInitialize( void )
+
+   Summary:
+    Moves the vector table to RAM.
+
+   Description:
+    This function copies the vector table from flash to RAM and points VTOR
+    at the copy, so that vector fetches no longer wait for the flash and
+    SYS_INT_HandlerSet can change the entries. Without
+    SYS_INT_VECTOR_TABLE_RAM it does nothing.
+
+   Precondition:
+    The C run-time data initialization must have been done.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    See Reset_Handler in startup_xc32.c, which calls it.
+
+  Remarks:
+    Must be called before any interrupt is enabled.
+*/
+
+void SYS_INT_VectorTableInitialize( void );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_INT_HandlerSet( INT_SOURCE source, SYS_INT_HANDLER handler,
+                             uintptr_t context )
+
+   Summary:
+    Attaches a handler with a context to an interrupt source at run time.
+
+   Description:
+    This function replaces the handler of the source in the RAM vector table.
+    When the interrupt is taken, handler is called with context. A NULL
+    handler restores the handler linked into the flash table.
+
+   Precondition:
+    SYS_INT_VectorTableInitialize must have been called.
+
+   Parameters:
+    source  - SVCall_IRQn, PendSV_IRQn, SysTick_IRQn or a peripheral
+              interrupt.
+    handler - Function to call, or NULL.
+    context - Value passed to handler.
+
+   Returns:
+    true  - The handler is attached.
+    false - The source cannot be changed, or SYS_INT_VECTOR_TABLE_RAM is
+            not defined.
+
+  Example:
+    <code>
+    static void DRV_UART_InterruptHandler( uintptr_t context )
+    {
+        DRV_UART_OBJ *dObj = (DRV_UART_OBJ *)context;
+        ...
+    }
+
+    (void)SYS_INT_HandlerSet(SERCOM1_IRQn, DRV_UART_InterruptHandler,
+                             (uintptr_t)&uart1Obj);
+    </code>
+
+  Remarks:
+    All the handlers share one dispatcher, which looks up the handler and
+    context of the active vector in a table; there is no code generated per
+    instance. A handler is not included in the SYS_INT_STATS_ENABLE
+    statistics unless it uses SYS_INT_STATS_MEASURE itself.
+*/
+
+bool SYS_INT_HandlerSet( INT_SOURCE source, SYS_INT_HANDLER handler, uintptr_t context );
+
 #include "sys_int_mapping.h"
 
 // DOM-IGNORE-BEGIN
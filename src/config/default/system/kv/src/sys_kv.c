@@ -0,0 +1,756 @@
+/*******************************************************************************
+  Key/Value Store System Service Implementation File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_kv.c
+
+  Summary
+    Wear-leveled key/value store implementation.
+
+  Description
+    The reserved flash region is split into two sectors. The first page of a
+    sector holds its header, the other pages hold records:
+
+      uint16_t key, uint16_t crc, uint8_t length, uint8_t reserved, value
+
+    padded to a multiple of four bytes. A record never spans a page and a page
+    is programmed exactly once between erases. The sector with the newest
+    valid header is active; the other one is kept erased for compaction.
+
+  Remarks:
+    None.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <string.h>
+#include "peripheral/nvmctrl/plib_nvmctrl.h"
+#include "system/flash/sys_flash.h"
+#include "system/kv/sys_kv.h"
+
+#define SYS_KV_PAGE_SIZE            NVMCTRL_FLASH_PAGESIZE
+#define SYS_KV_ROW_SIZE             NVMCTRL_FLASH_ROWSIZE
+
+#define SYS_KV_SECTOR_MAGIC         0x3156564BU     /* "KVV1" */
+
+#define SYS_KV_RECORD_HEADER_SIZE   6U
+#define SYS_KV_RECORD_SIZE(length)  (((SYS_KV_RECORD_HEADER_SIZE + (length)) + 3U) & ~3U)
+#define SYS_KV_RECORD_MAX_SIZE      SYS_KV_RECORD_SIZE(SYS_KV_VALUE_MAX_SIZE)
+
+#define SYS_KV_KEY_ERASED           0xFFFFU
+#define SYS_KV_NO_RECORD            0xFFFFU
+
+#if (SYS_KV_VALUE_MAX_SIZE < 1U) || (SYS_KV_VALUE_MAX_SIZE > 255U) || (SYS_KV_RECORD_SIZE(SYS_KV_VALUE_MAX_SIZE) > NVMCTRL_FLASH_PAGESIZE)
+#error "SYS_KV_VALUE_MAX_SIZE must fit one record into a flash page"
+#endif
+
+#if (SYS_KV_KEY_COUNT < 1U) || (SYS_KV_KEY_COUNT >= SYS_KV_KEY_ERASED)
+#error "SYS_KV_KEY_COUNT is out of range"
+#endif
+
+/* Region reserved by the linker script, see NVM_DATA_LENGTH */
+extern uint32_t __nvm_data_start[];
+extern uint32_t __nvm_data_end[];
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    SYS_KV_STATE_IDLE = 0,
+    SYS_KV_STATE_COMMIT_WAIT,
+    SYS_KV_STATE_COMPACT_COPY,
+    SYS_KV_STATE_COMPACT_WAIT,
+    SYS_KV_STATE_HEADER_WAIT,
+    SYS_KV_STATE_ERASE,
+    SYS_KV_STATE_ERASE_WAIT,
+    SYS_KV_STATE_ERROR
+
+} SYS_KV_STATE;
+
+typedef struct
+{
+    uint16_t    key;
+
+    uint16_t    crc;
+
+    uint8_t     length;
+
+    uint8_t     reserved;
+
+} SYS_KV_RECORD_HEADER;
+
+typedef struct
+{
+    uint32_t    magic;
+
+    uint32_t    sequence;
+
+    uint32_t    sequenceInverted;
+
+} SYS_KV_SECTOR_HEADER;
+
+typedef struct
+{
+    SYS_KV_STATE    state;
+
+    uint32_t        regionStart;
+
+    uint32_t        sectorSize;
+
+    /* Base address of the active sector, valid when isFormatted */
+    uint32_t        activeSector;
+
+    uint32_t        sequence;
+
+    /* Next unprogrammed page of the active sector */
+    uint32_t        tailAddress;
+
+    /* Bytes used in stagePage and, while committing, bytes being programmed */
+    uint32_t        stageFill;
+
+    uint32_t        commitFill;
+
+    /* Compaction cursor into the spare sector */
+    uint16_t        compactKey;
+
+    uint32_t        compactFill;
+
+    uint32_t        compactAddress;
+
+    uint32_t        eraseAddress;
+
+    uint32_t        eraseEnd;
+
+    bool            isFormatted;
+
+    /* Completion of the flash job, set from the NVMCTRL interrupt */
+    volatile bool               isJobPending;
+
+    volatile SYS_FLASH_RESULT   jobResult;
+
+} SYS_KV_OBJECT;
+
+static SYS_KV_OBJECT sysKvObj;
+
+/* Offset from regionStart of the latest programmed record of every key */
+static uint16_t sysKvIndex[SYS_KV_KEY_COUNT];
+
+/* Records not programmed yet. Unused bytes are kept erased (0xFF). */
+static uint32_t sysKvStagePage[SYS_KV_PAGE_SIZE / 4U];
+
+/* Page image for compaction and sector headers */
+static uint32_t sysKvCopyPage[SYS_KV_PAGE_SIZE / 4U];
+
+static const uint16_t sysKvCrcTable[16] =
+{
+    0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+    0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU
+};
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* CRC-16/CCITT-FALSE, one nibble at a time */
+static uint16_t SYS_KV_Crc( uint16_t crc, const uint8_t *data, size_t length )
+{
+    size_t i;
+
+    for (i = 0U; i < length; i++)
+    {
+        crc = (uint16_t)((crc << 4) ^ sysKvCrcTable[((crc >> 12) ^ ((uint16_t)data[i] >> 4)) & 0x0FU]);
+        crc = (uint16_t)((crc << 4) ^ sysKvCrcTable[((crc >> 12) ^ (uint16_t)data[i]) & 0x0FU]);
+    }
+
+    return crc;
+}
+
+static uint16_t SYS_KV_RecordCrc( const SYS_KV_RECORD_HEADER *header, const uint8_t *value )
+{
+    uint16_t crc = SYS_KV_Crc(0xFFFFU, (const uint8_t *)&header->key, sizeof(header->key));
+
+    crc = SYS_KV_Crc(crc, &header->length, sizeof(header->length));
+
+    return SYS_KV_Crc(crc, value, header->length);
+}
+
+/* Returns the size of the valid record at offset, or 0 at the end of the
+ * records in this page */
+static uint32_t SYS_KV_RecordCheck( const uint8_t *page, uint32_t offset, uint32_t limit, SYS_KV_RECORD_HEADER *header )
+{
+    uint32_t size = 0U;
+
+    if ((offset + SYS_KV_RECORD_HEADER_SIZE) <= limit)
+    {
+        (void)memcpy(header, &page[offset], SYS_KV_RECORD_HEADER_SIZE);
+
+        if ((header->key != SYS_KV_KEY_ERASED) && (header->length <= SYS_KV_VALUE_MAX_SIZE) &&
+            ((offset + SYS_KV_RECORD_SIZE(header->length)) <= limit) &&
+            (header->crc == SYS_KV_RecordCrc(header, &page[offset + SYS_KV_RECORD_HEADER_SIZE])))
+        {
+            size = SYS_KV_RECORD_SIZE(header->length);
+        }
+    }
+
+    return size;
+}
+
+/* Points the index at the records of a programmed page */
+static void SYS_KV_PageIndex( uint32_t pageAddress, uint32_t limit )
+{
+    const uint8_t *page = (const uint8_t *)pageAddress;
+    SYS_KV_RECORD_HEADER header;
+    uint32_t offset = 0U;
+    uint32_t size;
+
+    size = SYS_KV_RecordCheck(page, offset, limit, &header);
+
+    while (size != 0U)
+    {
+        if (header.key < SYS_KV_KEY_COUNT)
+        {
+            sysKvIndex[header.key] = (header.length == 0U) ? SYS_KV_NO_RECORD :
+                                     (uint16_t)((pageAddress + offset) - sysKvObj.regionStart);
+        }
+
+        offset += size;
+        size = SYS_KV_RecordCheck(page, offset, limit, &header);
+    }
+}
+
+static bool SYS_KV_IsErased( uint32_t address, uint32_t size )
+{
+    const uint32_t *word = (const uint32_t *)address;
+    uint32_t i;
+
+    for (i = 0U; i < (size / 4U); i++)
+    {
+        if (word[i] != 0xFFFFFFFFU)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool SYS_KV_SectorHeaderGet( uint32_t sector, uint32_t *sequence )
+{
+    SYS_KV_SECTOR_HEADER header;
+
+    (void)memcpy(&header, (const void *)sector, sizeof(header));
+
+    *sequence = header.sequence;
+
+    return (header.magic == SYS_KV_SECTOR_MAGIC) && (header.sequence == ~header.sequenceInverted);
+}
+
+/* Rebuilds the index and the tail from the records of the active sector */
+static void SYS_KV_SectorScan( void )
+{
+    uint32_t address;
+    uint32_t end = sysKvObj.activeSector + sysKvObj.sectorSize;
+
+    (void)memset(sysKvIndex, 0xFF, sizeof(sysKvIndex));
+
+    sysKvObj.tailAddress = sysKvObj.activeSector + SYS_KV_PAGE_SIZE;
+
+    for (address = sysKvObj.tailAddress; address < end; address += SYS_KV_PAGE_SIZE)
+    {
+        if (!SYS_KV_IsErased(address, SYS_KV_PAGE_SIZE))
+        {
+            SYS_KV_PageIndex(address, SYS_KV_PAGE_SIZE);
+            sysKvObj.tailAddress = address + SYS_KV_PAGE_SIZE;
+        }
+    }
+}
+
+static uint32_t SYS_KV_SpareSectorGet( void )
+{
+    return (sysKvObj.activeSector == sysKvObj.regionStart) ? (sysKvObj.regionStart + sysKvObj.sectorSize) : sysKvObj.regionStart;
+}
+
+static void SYS_KV_EraseStart( uint32_t address, uint32_t size )
+{
+    sysKvObj.eraseAddress = address;
+    sysKvObj.eraseEnd = address + size;
+    sysKvObj.state = SYS_KV_STATE_ERASE;
+}
+
+static void SYS_KV_JobHandler( SYS_FLASH_RESULT result, uintptr_t context )
+{
+    sysKvObj.jobResult = result;
+    sysKvObj.isJobPending = false;
+}
+
+/* Queues a verified flash job. On false the state is left alone so that the
+ * next SYS_KV_Tasks call retries. */
+static bool SYS_KV_JobSubmit( uint32_t operations, uint32_t address, const uint32_t *data, uint32_t length )
+{
+    sysKvObj.isJobPending = true;
+
+    if (!SYS_FLASH_JobSubmit(operations | (uint32_t)SYS_FLASH_OPERATION_VERIFY, address, data, length, SYS_KV_JobHandler, 0U))
+    {
+        sysKvObj.isJobPending = false;
+        return false;
+    }
+
+    return true;
+}
+
+static void SYS_KV_HeaderWrite( uint32_t sector, uint32_t sequence )
+{
+    SYS_KV_SECTOR_HEADER header;
+
+    header.magic = SYS_KV_SECTOR_MAGIC;
+    header.sequence = sequence;
+    header.sequenceInverted = ~sequence;
+
+    (void)memset(sysKvCopyPage, 0xFF, sizeof(sysKvCopyPage));
+    (void)memcpy(sysKvCopyPage, &header, sizeof(header));
+
+    sysKvObj.compactAddress = sector;
+
+    if (SYS_KV_JobSubmit((uint32_t)SYS_FLASH_OPERATION_WRITE, sector, sysKvCopyPage, SYS_KV_PAGE_SIZE))
+    {
+        sysKvObj.state = SYS_KV_STATE_HEADER_WAIT;
+    }
+}
+
+/* Finds the newest record of key in the RAM page */
+static const uint8_t *SYS_KV_StageFind( uint16_t key, SYS_KV_RECORD_HEADER *header )
+{
+    const uint8_t *stage = (const uint8_t *)sysKvStagePage;
+    const uint8_t *record = NULL;
+    SYS_KV_RECORD_HEADER current;
+    uint32_t offset = 0U;
+
+    while (offset < sysKvObj.stageFill)
+    {
+        (void)memcpy(&current, &stage[offset], SYS_KV_RECORD_HEADER_SIZE);
+
+        if (current.key == key)
+        {
+            *header = current;
+            record = &stage[offset];
+        }
+
+        offset += SYS_KV_RECORD_SIZE(current.length);
+    }
+
+    return record;
+}
+
+static bool SYS_KV_Append( uint16_t key, const void *data, size_t length )
+{
+    uint8_t *stage = (uint8_t *)sysKvStagePage;
+    SYS_KV_RECORD_HEADER header;
+
+    if ((sysKvObj.stageFill + SYS_KV_RECORD_SIZE(length)) > SYS_KV_PAGE_SIZE)
+    {
+        return false;
+    }
+
+    header.key = key;
+    header.length = (uint8_t)length;
+    header.reserved = 0xFFU;
+    header.crc = SYS_KV_RecordCrc(&header, (const uint8_t *)data);
+
+    (void)memcpy(&stage[sysKvObj.stageFill], &header, SYS_KV_RECORD_HEADER_SIZE);
+    (void)memcpy(&stage[sysKvObj.stageFill + SYS_KV_RECORD_HEADER_SIZE], data, length);
+
+    sysKvObj.stageFill += SYS_KV_RECORD_SIZE(length);
+
+    return true;
+}
+
+static void SYS_KV_CompactCopy( void )
+{
+    uint8_t *copy = (uint8_t *)sysKvCopyPage;
+    SYS_KV_RECORD_HEADER header;
+    const uint8_t *record;
+    uint32_t size;
+    uint32_t spare = SYS_KV_SpareSectorGet();
+
+    while (sysKvObj.compactKey < SYS_KV_KEY_COUNT)
+    {
+        if (sysKvIndex[sysKvObj.compactKey] != SYS_KV_NO_RECORD)
+        {
+            record = (const uint8_t *)(sysKvObj.regionStart + sysKvIndex[sysKvObj.compactKey]);
+            (void)memcpy(&header, record, SYS_KV_RECORD_HEADER_SIZE);
+            size = SYS_KV_RECORD_SIZE(header.length);
+
+            if ((sysKvObj.compactFill + size) > SYS_KV_PAGE_SIZE)
+            {
+                break;
+            }
+
+            (void)memcpy(&copy[sysKvObj.compactFill], record, size);
+            sysKvObj.compactFill += size;
+        }
+
+        sysKvObj.compactKey++;
+    }
+
+    if (sysKvObj.compactFill == 0U)
+    {
+        /* All live records copied: activate the spare sector */
+        SYS_KV_HeaderWrite(spare, sysKvObj.sequence + 1U);
+    }
+    else if (sysKvObj.compactAddress >= (spare + sysKvObj.sectorSize))
+    {
+        sysKvObj.state = SYS_KV_STATE_ERROR;
+    }
+    else if (SYS_KV_JobSubmit((uint32_t)SYS_FLASH_OPERATION_WRITE, sysKvObj.compactAddress, sysKvCopyPage, SYS_KV_PAGE_SIZE))
+    {
+        sysKvObj.state = SYS_KV_STATE_COMPACT_WAIT;
+    }
+    else
+    {
+        /* Queue full, retried from the next call */
+    }
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_KV_Initialize( void )
+{
+    uint32_t sequence0;
+    uint32_t sequence1;
+    bool isValid0;
+    bool isValid1;
+    uint32_t sector1;
+
+    (void)memset(&sysKvObj, 0, sizeof(sysKvObj));
+    (void)memset(sysKvIndex, 0xFF, sizeof(sysKvIndex));
+    (void)memset(sysKvStagePage, 0xFF, sizeof(sysKvStagePage));
+
+    sysKvObj.regionStart = (uint32_t)__nvm_data_start;
+    sysKvObj.sectorSize = (((uint32_t)__nvm_data_end - sysKvObj.regionStart) / 2U) & ~(SYS_KV_ROW_SIZE - 1U);
+    sector1 = sysKvObj.regionStart + sysKvObj.sectorSize;
+
+    /* Compaction must leave a free page even if every key holds a value of
+     * the largest size */
+    if ((sysKvObj.sectorSize < SYS_KV_ROW_SIZE) ||
+        ((((sysKvObj.sectorSize / SYS_KV_PAGE_SIZE) - 2U) * (SYS_KV_PAGE_SIZE / SYS_KV_RECORD_MAX_SIZE)) < SYS_KV_KEY_COUNT))
+    {
+        sysKvObj.state = SYS_KV_STATE_ERROR;
+        return;
+    }
+
+    isValid0 = SYS_KV_SectorHeaderGet(sysKvObj.regionStart, &sequence0);
+    isValid1 = SYS_KV_SectorHeaderGet(sector1, &sequence1);
+
+    if (!isValid0 && !isValid1)
+    {
+        /* Blank or foreign region: erase both sectors, then write a header */
+        SYS_KV_EraseStart(sysKvObj.regionStart, 2U * sysKvObj.sectorSize);
+        return;
+    }
+
+    if (isValid0 && (!isValid1 || ((int32_t)(sequence0 - sequence1) > 0)))
+    {
+        sysKvObj.activeSector = sysKvObj.regionStart;
+        sysKvObj.sequence = sequence0;
+    }
+    else
+    {
+        sysKvObj.activeSector = sector1;
+        sysKvObj.sequence = sequence1;
+    }
+
+    sysKvObj.isFormatted = true;
+
+    SYS_KV_SectorScan();
+
+    /* The spare sector may hold the old copy or an interrupted compaction */
+    if (!SYS_KV_IsErased(SYS_KV_SpareSectorGet(), sysKvObj.sectorSize))
+    {
+        SYS_KV_EraseStart(SYS_KV_SpareSectorGet(), sysKvObj.sectorSize);
+    }
+}
+
+void SYS_KV_Tasks( void )
+{
+    uint8_t *stage = (uint8_t *)sysKvStagePage;
+    uint32_t oldSector;
+
+    /* Every state either waits for or starts a flash job */
+    if ((sysKvObj.state == SYS_KV_STATE_ERROR) || sysKvObj.isJobPending)
+    {
+        return;
+    }
+
+    switch (sysKvObj.state)
+    {
+        case SYS_KV_STATE_IDLE:
+        {
+            if (sysKvObj.stageFill == 0U)
+            {
+                break;
+            }
+
+            if (sysKvObj.tailAddress >= (sysKvObj.activeSector + sysKvObj.sectorSize))
+            {
+                sysKvObj.compactKey = 0U;
+                sysKvObj.compactFill = 0U;
+                sysKvObj.compactAddress = SYS_KV_SpareSectorGet() + SYS_KV_PAGE_SIZE;
+                (void)memset(sysKvCopyPage, 0xFF, sizeof(sysKvCopyPage));
+                sysKvObj.state = SYS_KV_STATE_COMPACT_COPY;
+            }
+            else
+            {
+                /* Program a snapshot: Set may keep appending to the RAM page
+                 * while the job runs */
+                sysKvObj.commitFill = sysKvObj.stageFill;
+                (void)memset(sysKvCopyPage, 0xFF, sizeof(sysKvCopyPage));
+                (void)memcpy(sysKvCopyPage, sysKvStagePage, sysKvObj.commitFill);
+
+                if (SYS_KV_JobSubmit((uint32_t)SYS_FLASH_OPERATION_WRITE, sysKvObj.tailAddress, sysKvCopyPage, SYS_KV_PAGE_SIZE))
+                {
+                    sysKvObj.state = SYS_KV_STATE_COMMIT_WAIT;
+                }
+            }
+            break;
+        }
+
+        case SYS_KV_STATE_COMMIT_WAIT:
+        {
+            /* A page that fails to verify is skipped and the records are
+             * programmed again into the next one */
+            if (sysKvObj.jobResult == SYS_FLASH_RESULT_SUCCESS)
+            {
+                SYS_KV_PageIndex(sysKvObj.tailAddress, sysKvObj.commitFill);
+
+                sysKvObj.stageFill -= sysKvObj.commitFill;
+                (void)memmove(stage, &stage[sysKvObj.commitFill], sysKvObj.stageFill);
+                (void)memset(&stage[sysKvObj.stageFill], 0xFF, SYS_KV_PAGE_SIZE - sysKvObj.stageFill);
+            }
+
+            sysKvObj.commitFill = 0U;
+            sysKvObj.tailAddress += SYS_KV_PAGE_SIZE;
+            sysKvObj.state = SYS_KV_STATE_IDLE;
+            break;
+        }
+
+        case SYS_KV_STATE_COMPACT_COPY:
+        {
+            SYS_KV_CompactCopy();
+            break;
+        }
+
+        case SYS_KV_STATE_COMPACT_WAIT:
+        {
+            if (sysKvObj.jobResult == SYS_FLASH_RESULT_SUCCESS)
+            {
+                sysKvObj.compactFill = 0U;
+                (void)memset(sysKvCopyPage, 0xFF, sizeof(sysKvCopyPage));
+            }
+
+            /* On failure the same image goes to the next page */
+            sysKvObj.compactAddress += SYS_KV_PAGE_SIZE;
+            sysKvObj.state = SYS_KV_STATE_COMPACT_COPY;
+            break;
+        }
+
+        case SYS_KV_STATE_HEADER_WAIT:
+        {
+            if (sysKvObj.jobResult != SYS_FLASH_RESULT_SUCCESS)
+            {
+                sysKvObj.state = SYS_KV_STATE_ERROR;
+                break;
+            }
+
+            oldSector = sysKvObj.activeSector;
+
+            sysKvObj.activeSector = sysKvObj.compactAddress;
+            sysKvObj.sequence = ((SYS_KV_SECTOR_HEADER *)sysKvObj.compactAddress)->sequence;
+
+            SYS_KV_SectorScan();
+
+            if (sysKvObj.isFormatted)
+            {
+                SYS_KV_EraseStart(oldSector, sysKvObj.sectorSize);
+            }
+            else
+            {
+                sysKvObj.isFormatted = true;
+                sysKvObj.state = SYS_KV_STATE_IDLE;
+            }
+            break;
+        }
+
+        case SYS_KV_STATE_ERASE:
+        {
+            if (sysKvObj.eraseAddress < sysKvObj.eraseEnd)
+            {
+                if (SYS_KV_JobSubmit((uint32_t)SYS_FLASH_OPERATION_ERASE, sysKvObj.eraseAddress, NULL, sysKvObj.eraseEnd - sysKvObj.eraseAddress))
+                {
+                    sysKvObj.state = SYS_KV_STATE_ERASE_WAIT;
+                }
+            }
+            else if (!sysKvObj.isFormatted)
+            {
+                SYS_KV_HeaderWrite(sysKvObj.regionStart, 1U);
+            }
+            else
+            {
+                sysKvObj.state = SYS_KV_STATE_IDLE;
+            }
+            break;
+        }
+
+        case SYS_KV_STATE_ERASE_WAIT:
+        {
+            if (sysKvObj.jobResult != SYS_FLASH_RESULT_SUCCESS)
+            {
+                sysKvObj.state = SYS_KV_STATE_ERROR;
+                break;
+            }
+
+            sysKvObj.eraseAddress = sysKvObj.eraseEnd;
+            sysKvObj.state = SYS_KV_STATE_ERASE;
+            break;
+        }
+
+        case SYS_KV_STATE_ERROR:
+        default:
+        {
+            break;
+        }
+    }
+}
+
+size_t SYS_KV_Get( uint16_t key, void *buffer, size_t size )
+{
+    SYS_KV_RECORD_HEADER header;
+    const uint8_t *record;
+
+    if (key >= SYS_KV_KEY_COUNT)
+    {
+        return 0U;
+    }
+
+    record = SYS_KV_StageFind(key, &header);
+
+    if ((record == NULL) && (sysKvIndex[key] != SYS_KV_NO_RECORD))
+    {
+        record = (const uint8_t *)(sysKvObj.regionStart + sysKvIndex[key]);
+        (void)memcpy(&header, record, SYS_KV_RECORD_HEADER_SIZE);
+    }
+
+    if (record == NULL)
+    {
+        return 0U;
+    }
+
+    (void)memcpy(buffer, &record[SYS_KV_RECORD_HEADER_SIZE], (size < header.length) ? size : header.length);
+
+    return header.length;
+}
+
+bool SYS_KV_Set( uint16_t key, const void *data, size_t length )
+{
+    uint8_t current[SYS_KV_VALUE_MAX_SIZE];
+
+    if ((key >= SYS_KV_KEY_COUNT) || (data == NULL) || (length == 0U) || (length > SYS_KV_VALUE_MAX_SIZE) ||
+        (sysKvObj.state == SYS_KV_STATE_ERROR))
+    {
+        return false;
+    }
+
+    /* Rewriting the stored value would only wear the flash */
+    if ((SYS_KV_Get(key, current, sizeof(current)) == length) && (memcmp(current, data, length) == 0))
+    {
+        return true;
+    }
+
+    return SYS_KV_Append(key, data, length);
+}
+
+bool SYS_KV_Delete( uint16_t key )
+{
+    uint8_t current[SYS_KV_VALUE_MAX_SIZE];
+
+    if ((key >= SYS_KV_KEY_COUNT) || (sysKvObj.state == SYS_KV_STATE_ERROR))
+    {
+        return false;
+    }
+
+    if (SYS_KV_Get(key, current, sizeof(current)) == 0U)
+    {
+        return true;
+    }
+
+    return SYS_KV_Append(key, current, 0U);
+}
+
+bool SYS_KV_IsBusy( void )
+{
+    return (sysKvObj.state != SYS_KV_STATE_ERROR) && ((sysKvObj.stageFill != 0U) || (sysKvObj.state != SYS_KV_STATE_IDLE));
+}
+
+SYS_STATUS SYS_KV_Status( void )
+{
+    SYS_STATUS status = SYS_STATUS_READY;
+
+    if (sysKvObj.state == SYS_KV_STATE_ERROR)
+    {
+        status = SYS_STATUS_ERROR;
+    }
+    else if (!sysKvObj.isFormatted)
+    {
+        status = SYS_STATUS_BUSY;
+    }
+    else
+    {
+        /* Ready */
+    }
+
+    return status;
+}
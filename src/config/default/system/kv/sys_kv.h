@@ -0,0 +1,333 @@
+/*******************************************************************************
+  Key/Value Store System Service Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_kv.h
+
+  Summary
+    Wear-leveled key/value store in on-chip flash.
+
+  Description
+    This file defines the interface to the key/value store system service.
+    Values are appended as CRC protected records to a flash region reserved by
+    the linker script (__nvm_data_start to __nvm_data_end). A RAM table indexed
+    by key points at the latest record of every key, so reads never scan
+    flash. Writes are collected in a RAM page and programmed through the flash
+    job queue (sys_flash.h), so SYS_KV_Tasks does not poll the NVMCTRL; when a
+    sector is full the live records are compacted into the spare sector in the
+    background. Flash fetches still stall while each command runs.
+
+  Remarks:
+    None.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_KV_H    // Guards against multiple inclusion
+#define SYS_KV_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+#include "system/system.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_KV_Initialize( void )
+
+   Summary:
+    Rebuilds the RAM index from the flash region.
+
+   Description:
+    This function selects the active sector from the sector headers and scans
+    its records to rebuild the index. Erasing a stale sector, or formatting an
+    empty region, is left to SYS_KV_Tasks.
+
+   Precondition:
+    SYS_FLASH_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    SYS_KV_Initialize();
+    </code>
+
+  Remarks:
+    Only reads flash, so it does not delay start-up by erase times.
+*/
+
+void SYS_KV_Initialize( void );
+
+// *****************************************************************************
+/* Function:
+    void SYS_KV_Tasks( void )
+
+   Summary:
+    Advances the store by at most one flash job.
+
+   Description:
+    This function queues the page write of pending records, the compaction
+    copies and the sector erases with the flash job queue (system/flash). It
+    never waits for the flash; a job queued in one call is checked in a later
+    one.
+
+   Precondition:
+    SYS_KV_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    while (true)
+    {
+        SYS_KV_Tasks();
+    }
+    </code>
+
+  Remarks:
+    Called from SYS_Tasks.
+*/
+
+void SYS_KV_Tasks( void );
+
+// *****************************************************************************
+/* Function:
+    size_t SYS_KV_Get( uint16_t key, void *buffer, size_t size )
+
+   Summary:
+    Reads the current value of a key.
+
+   Description:
+    This function copies up to size bytes of the latest value of key, which
+    may still be waiting in the RAM page, into buffer.
+
+   Precondition:
+    SYS_KV_Initialize must have been called.
+
+   Parameters:
+    key         - Key, less than SYS_KV_KEY_COUNT.
+    buffer      - Destination of the value.
+    size        - Size of buffer in bytes.
+
+   Returns:
+    Length of the stored value, which may be larger than size, or 0 if the
+    key has no value.
+
+  Example:
+    <code>
+    uint32_t bootCount = 0U;
+
+    (void)SYS_KV_Get(APP_KEY_BOOT_COUNT, &bootCount, sizeof(bootCount));
+    </code>
+
+  Remarks:
+    None.
+*/
+
+size_t SYS_KV_Get( uint16_t key, void *buffer, size_t size );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_KV_Set( uint16_t key, const void *data, size_t length )
+
+   Summary:
+    Stores a new value for a key.
+
+   Description:
+    This function appends a record to the RAM page. SYS_KV_Tasks programs the
+    page, so several updates made in one pass of the main loop share a single
+    page write. Writing the value the key already holds costs nothing.
+
+   Precondition:
+    SYS_KV_Initialize must have been called.
+
+   Parameters:
+    key         - Key, less than SYS_KV_KEY_COUNT.
+    data        - Value to store.
+    length      - 1 to SYS_KV_VALUE_MAX_SIZE bytes.
+
+   Returns:
+    true if the value was accepted, false if the parameters are invalid or the
+    RAM page is full; call SYS_KV_Tasks and retry.
+
+  Example:
+    <code>
+    bootCount++;
+    (void)SYS_KV_Set(APP_KEY_BOOT_COUNT, &bootCount, sizeof(bootCount));
+    </code>
+
+  Remarks:
+    The value is durable once SYS_KV_IsBusy returns false. Not interrupt safe.
+*/
+
+bool SYS_KV_Set( uint16_t key, const void *data, size_t length );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_KV_Delete( uint16_t key )
+
+   Summary:
+    Removes the value of a key.
+
+   Description:
+    This function appends a record without data that hides older values. The
+    key is dropped for good at the next compaction.
+
+   Precondition:
+    SYS_KV_Initialize must have been called.
+
+   Parameters:
+    key         - Key, less than SYS_KV_KEY_COUNT.
+
+   Returns:
+    Same as SYS_KV_Set.
+
+  Example:
+    <code>
+    (void)SYS_KV_Delete(APP_KEY_CALIBRATION);
+    </code>
+
+  Remarks:
+    None.
+*/
+
+bool SYS_KV_Delete( uint16_t key );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_KV_IsBusy( void )
+
+   Summary:
+    Returns true while updates are not yet in flash or a flash operation is
+    in progress.
+
+   Description:
+    This function reports whether the RAM page holds records or the state
+    machine is programming, compacting or erasing.
+
+   Precondition:
+    SYS_KV_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    true if SYS_KV_Tasks still has work to do.
+
+  Example:
+    <code>
+    while (SYS_KV_IsBusy())
+    {
+        SYS_KV_Tasks();
+    }
+    NVIC_SystemReset();
+    </code>
+
+  Remarks:
+    None.
+*/
+
+bool SYS_KV_IsBusy( void );
+
+// *****************************************************************************
+/* Function:
+    SYS_STATUS SYS_KV_Status( void )
+
+   Summary:
+    Returns the state of the store.
+
+   Description:
+    This function returns SYS_STATUS_READY when the store can commit records,
+    SYS_STATUS_BUSY while the region is being formatted and SYS_STATUS_ERROR
+    when no usable sector is left.
+
+   Precondition:
+    SYS_KV_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    SYS_STATUS of the store.
+
+  Example:
+    <code>
+    if (SYS_KV_Status() == SYS_STATUS_ERROR)
+    {
+        // Flash worn out or region locked
+    }
+    </code>
+
+  Remarks:
+    None.
+*/
+
+SYS_STATUS SYS_KV_Status( void );
+
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_KV_H
@@ -0,0 +1,205 @@
+/*******************************************************************************
+  Deferred Binary Log System Service Implementation File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_log.c
+
+  Summary
+    Deferred binary log system service implementation.
+
+  Description
+    This file keeps the RAM ring of binary log records and streams complete
+    records to the port selected by SYS_LOG_WRITE in configuration.h.
+
+  Remarks:
+    None.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "device.h"
+#include "definitions.h"
+#include "system/log/sys_log.h"
+
+#if ((SYS_LOG_BUFFER_SIZE & (SYS_LOG_BUFFER_SIZE - 1U)) != 0U) || (SYS_LOG_BUFFER_SIZE < 64U)
+#error "SYS_LOG_BUFFER_SIZE must be a power of two of at least 64 bytes"
+#endif
+
+#define SYS_LOG_RING_WORDS      (SYS_LOG_BUFFER_SIZE / sizeof(uint32_t))
+#define SYS_LOG_RING_MASK       (SYS_LOG_RING_WORDS - 1U)
+
+/* Records without a time source are stamped with a sequence number */
+#ifndef SYS_LOG_TIMESTAMP_GET
+#define SYS_LOG_TIMESTAMP_GET()     (sysLogObj.sequence++)
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    /* Free running word counters; the ring index is the counter & mask */
+    volatile uint32_t   inIndex;
+
+    volatile uint32_t   outIndex;
+
+    /* Records dropped since the last stored record */
+    volatile uint32_t   pendingDropped;
+
+    volatile uint32_t   totalDropped;
+
+    uint32_t            sequence;
+
+} SYS_LOG_OBJECT;
+
+static uint32_t sysLogRing[SYS_LOG_RING_WORDS] SYS_BOOT_NO_INIT;
+
+static SYS_LOG_OBJECT sysLogObj;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_LOG_Initialize( void )
+{
+    sysLogObj.inIndex = 0U;
+    sysLogObj.outIndex = 0U;
+    sysLogObj.pendingDropped = 0U;
+    sysLogObj.totalDropped = 0U;
+    sysLogObj.sequence = 0U;
+}
+
+bool SYS_LOG_Write( uint32_t level, const char *format, const uint32_t *args, size_t nArgs )
+{
+    uint32_t processorStatus;
+    uint32_t recordWords;
+    uint32_t inIndex;
+    uint32_t dropped;
+    uint32_t i;
+    bool isStored = false;
+
+    if (nArgs > SYS_LOG_MAX_ARGS)
+    {
+        nArgs = SYS_LOG_MAX_ARGS;
+    }
+
+    recordWords = SYS_LOG_HEADER_WORDS + nArgs;
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    inIndex = sysLogObj.inIndex;
+
+    if ((SYS_LOG_RING_WORDS - (inIndex - sysLogObj.outIndex)) >= recordWords)
+    {
+        dropped = (sysLogObj.pendingDropped > 0xFFU) ? 0xFFU : sysLogObj.pendingDropped;
+
+        sysLogRing[inIndex & SYS_LOG_RING_MASK] = SYS_LOG_SYNC | ((uint32_t)nArgs << 8) | ((level & 0xFFU) << 16) | (dropped << 24);
+        sysLogRing[(inIndex + 1U) & SYS_LOG_RING_MASK] = (uint32_t)format;
+        sysLogRing[(inIndex + 2U) & SYS_LOG_RING_MASK] = SYS_LOG_TIMESTAMP_GET();
+
+        for (i = 0U; i < nArgs; i++)
+        {
+            sysLogRing[(inIndex + SYS_LOG_HEADER_WORDS + i) & SYS_LOG_RING_MASK] = args[i];
+        }
+
+        sysLogObj.inIndex = inIndex + recordWords;
+        sysLogObj.pendingDropped = 0U;
+
+        isStored = true;
+    }
+    else
+    {
+        sysLogObj.pendingDropped++;
+        sysLogObj.totalDropped++;
+    }
+
+    __set_PRIMASK(processorStatus);
+
+    return isStored;
+}
+
+void SYS_LOG_Tasks( void )
+{
+    uint32_t outIndex = sysLogObj.outIndex;
+    uint32_t recordWords;
+    uint32_t ringIndex;
+    uint32_t firstWords;
+
+    /* Only the task moves outIndex, and writers publish inIndex after the
+     * record is complete, so the record can be read without masking */
+    while (outIndex != sysLogObj.inIndex)
+    {
+        ringIndex = outIndex & SYS_LOG_RING_MASK;
+        recordWords = SYS_LOG_HEADER_WORDS + ((sysLogRing[ringIndex] >> 8) & 0xFFU);
+
+        if (SYS_LOG_WRITE_FREE_GET() < (recordWords * sizeof(uint32_t)))
+        {
+            break;
+        }
+
+        firstWords = SYS_LOG_RING_WORDS - ringIndex;
+
+        if (firstWords >= recordWords)
+        {
+            (void)SYS_LOG_WRITE(&sysLogRing[ringIndex], recordWords * sizeof(uint32_t));
+        }
+        else
+        {
+            (void)SYS_LOG_WRITE(&sysLogRing[ringIndex], firstWords * sizeof(uint32_t));
+            (void)SYS_LOG_WRITE(&sysLogRing[0], (recordWords - firstWords) * sizeof(uint32_t));
+        }
+
+        outIndex += recordWords;
+        sysLogObj.outIndex = outIndex;
+    }
+}
+
+uint32_t SYS_LOG_DroppedCountGet( void )
+{
+    return sysLogObj.totalDropped;
+}
+
+bool SYS_LOG_IsPending( void )
+{
+    return (sysLogObj.outIndex != sysLogObj.inIndex);
+}
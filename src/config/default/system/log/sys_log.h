@@ -0,0 +1,346 @@
+/*******************************************************************************
+  Deferred Binary Log System Service Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_log.h
+
+  Summary
+    Deferred binary log system service interface.
+
+  Description
+    This file defines the interface to the deferred binary log system service.
+    A log call stores only the address of its format string, a timestamp and
+    the raw 32-bit arguments in a RAM ring. SYS_LOG_Tasks streams the records
+    to the console port and a host decoder (tools/log_decoder.py) rebuilds the
+    text from the format strings kept in the ELF file.
+
+  Remarks:
+    Format strings are placed in the .logstr section, which the linker script
+    marks as not loaded, so they cost no flash.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_LOG_H    // Guards against multiple inclusion
+#define SYS_LOG_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Log record layout
+
+   Summary:
+    Framing of a binary log record.
+
+   Description:
+    Every record is a sequence of little-endian 32-bit words:
+
+      word 0      header: bits 0-7 SYS_LOG_SYNC, bits 8-15 argument count,
+                  bits 16-23 level, bits 24-31 records dropped before this one
+                  (saturates at 255)
+      word 1      format ID, the address of the format string in .logstr
+      word 2      timestamp
+      word 3..    arguments
+
+   Remarks:
+    None.
+*/
+
+#define SYS_LOG_SYNC                0xA5U
+
+#define SYS_LOG_HEADER_WORDS        3U
+
+#define SYS_LOG_MAX_ARGS            8U
+
+// DOM-IGNORE-BEGIN
+#define SYS_LOG_NARGS(...)          SYS_LOG_NARGS_(_, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define SYS_LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, N, ...)  N
+#define SYS_LOG_CONCAT(a, b)        SYS_LOG_CONCAT_(a, b)
+#define SYS_LOG_CONCAT_(a, b)       a##b
+
+#define SYS_LOG_ARGS_0()
+#define SYS_LOG_ARGS_1(a)           , (uint32_t)(a)
+#define SYS_LOG_ARGS_2(a, ...)      , (uint32_t)(a) SYS_LOG_ARGS_1(__VA_ARGS__)
+#define SYS_LOG_ARGS_3(a, ...)      , (uint32_t)(a) SYS_LOG_ARGS_2(__VA_ARGS__)
+#define SYS_LOG_ARGS_4(a, ...)      , (uint32_t)(a) SYS_LOG_ARGS_3(__VA_ARGS__)
+#define SYS_LOG_ARGS_5(a, ...)      , (uint32_t)(a) SYS_LOG_ARGS_4(__VA_ARGS__)
+#define SYS_LOG_ARGS_6(a, ...)      , (uint32_t)(a) SYS_LOG_ARGS_5(__VA_ARGS__)
+#define SYS_LOG_ARGS_7(a, ...)      , (uint32_t)(a) SYS_LOG_ARGS_6(__VA_ARGS__)
+#define SYS_LOG_ARGS_8(a, ...)      , (uint32_t)(a) SYS_LOG_ARGS_7(__VA_ARGS__)
+#define SYS_LOG_ARGS(...)           SYS_LOG_CONCAT(SYS_LOG_ARGS_, SYS_LOG_NARGS(__VA_ARGS__))(__VA_ARGS__)
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_LOG_Initialize( void )
+
+   Summary:
+    Initializes the log ring.
+
+   Description:
+    This function empties the log ring and clears the dropped record count.
+
+   Precondition:
+    None.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    SYS_LOG_Initialize();
+    </code>
+
+  Remarks:
+    Called from SYS_Initialize before any module that logs.
+*/
+
+void SYS_LOG_Initialize( void );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_LOG_Write( uint32_t level, const char *format,
+                        const uint32_t *args, size_t nArgs )
+
+   Summary:
+    Appends one record to the log ring.
+
+   Description:
+    This function copies the header, the format ID, the timestamp and the
+    arguments into the ring in one critical section. If the record does not
+    fit it is dropped and counted; the count is reported in the header of the
+    next record that fits.
+
+   Precondition:
+    SYS_LOG_Initialize must have been called.
+
+   Parameters:
+    level       - SYS_ERROR_LEVEL of the record.
+    format      - Format string placed in the .logstr section.
+    args        - Arguments, already converted to 32-bit words.
+    nArgs       - Number of arguments, at most SYS_LOG_MAX_ARGS.
+
+   Returns:
+    true if the record was stored, false if it was dropped.
+
+  Example:
+    Use SYS_LOG_PRINT instead of calling this function directly.
+
+  Remarks:
+    Safe to call from interrupt context.
+*/
+
+bool SYS_LOG_Write( uint32_t level, const char *format, const uint32_t *args, size_t nArgs );
+
+// *****************************************************************************
+/* Function:
+    void SYS_LOG_Tasks( void )
+
+   Summary:
+    Streams complete records from the log ring to the output port.
+
+   Description:
+    This function hands whole records to SYS_LOG_WRITE while the port reports
+    room for them, so records never interleave with other output.
+
+   Precondition:
+    SYS_LOG_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    while (true)
+    {
+        SYS_LOG_Tasks();
+    }
+    </code>
+
+  Remarks:
+    Called from SYS_Tasks.
+*/
+
+void SYS_LOG_Tasks( void );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_LOG_DroppedCountGet( void )
+
+   Summary:
+    Returns the total number of records dropped because the ring was full.
+
+   Description:
+    This function returns the total number of records that were dropped
+    since SYS_LOG_Initialize.
+
+   Precondition:
+    SYS_LOG_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    Number of dropped records.
+
+  Example:
+    <code>
+    if (SYS_LOG_DroppedCountGet() != 0U)
+    {
+        // Enlarge SYS_LOG_BUFFER_SIZE or call SYS_LOG_Tasks more often
+    }
+    </code>
+
+  Remarks:
+    None.
+*/
+
+uint32_t SYS_LOG_DroppedCountGet( void );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_LOG_IsPending( void )
+
+   Summary:
+    Returns true while records wait in the ring.
+
+   Description:
+    This function returns true when records were written that SYS_LOG_Tasks
+    has not passed on yet.
+
+   Precondition:
+    SYS_LOG_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    true if the ring is not empty.
+
+  Example:
+    <code>
+    #define SYS_PM_IDLE_ALLOWED()   (SYS_LOG_IsPending() == false)
+    </code>
+
+  Remarks:
+    Part of SYS_PM_IDLE_ALLOWED, so that a record written by a task in the
+    last SYS_Tasks pass is not held in RAM through a long sleep.
+*/
+
+bool SYS_LOG_IsPending( void );
+
+// *****************************************************************************
+/* Macro:
+    SYS_LOG_PRINT( uint32_t level, const char *format, ... )
+
+   Summary:
+    Records a log message without formatting it.
+
+   Description:
+    This macro places the format string in the .logstr section and stores its
+    address together with the arguments through SYS_LOG_Write. Formatting is
+    done on the host by tools/log_decoder.py.
+
+   Precondition:
+    SYS_LOG_Initialize must have been called.
+
+   Parameters:
+    level       - SYS_ERROR_LEVEL of the message.
+    format      - printf style format string. Must be a string literal.
+    ...         - Up to SYS_LOG_MAX_ARGS integer or pointer arguments.
+
+  Returns:
+    None.
+
+  Example:
+    <code>
+    SYS_LOG_PRINT(SYS_ERROR_INFO, "adc ch%u = %d\r\n", channel, value);
+    </code>
+
+  Remarks:
+    Each argument is converted to uint32_t, so floating point values are not
+    supported. A %s argument is decoded only if it points to a constant string
+    in flash.
+*/
+
+#define SYS_LOG_PRINT(level, format, ...)                                                    \
+    do                                                                                       \
+    {                                                                                        \
+        static const char sysLogFormat[] __attribute__((section(".logstr"), used)) = format; \
+        const uint32_t sysLogArgs[] = { 0U SYS_LOG_ARGS(__VA_ARGS__) };                      \
+        (void)SYS_LOG_Write((uint32_t)(level), sysLogFormat, &sysLogArgs[1],                 \
+                            (sizeof(sysLogArgs) / sizeof(uint32_t)) - 1U);                   \
+    } while (false)
+
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_LOG_H
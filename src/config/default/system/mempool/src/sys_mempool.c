@@ -0,0 +1,290 @@
+/*******************************************************************************
+  Memory Pool System Service Implementation File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_mempool.c
+
+  Summary
+    Fixed-size block allocator implementation.
+
+  Description
+    A free block holds the link to the next free block, so blocks carry no
+    header and a class costs exactly its block storage. Block sizes are
+    powers of two; a released pointer is matched to its class by address
+    range and checked to be on a block boundary with a mask, because the
+    Cortex-M0+ has no divide instruction.
+
+  Remarks:
+    None.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "device.h"
+#include "system/mempool/sys_mempool.h"
+
+#if (SYS_MEMPOOL_CLASS_COUNT < 1U) || (SYS_MEMPOOL_CLASS_COUNT > 4U)
+#error "SYS_MEMPOOL_CLASS_COUNT must be 1 to 4"
+#endif
+
+#define SYS_MEMPOOL_SIZE_IS_VALID(size)     (((size) >= 8U) && (((size) & ((size) - 1U)) == 0U))
+
+#if !SYS_MEMPOOL_SIZE_IS_VALID(SYS_MEMPOOL_CLASS0_BLOCK_SIZE)
+#error "SYS_MEMPOOL_CLASS0_BLOCK_SIZE must be a power of two of at least 8"
+#endif
+#if (SYS_MEMPOOL_CLASS_COUNT > 1U) && !SYS_MEMPOOL_SIZE_IS_VALID(SYS_MEMPOOL_CLASS1_BLOCK_SIZE)
+#error "SYS_MEMPOOL_CLASS1_BLOCK_SIZE must be a power of two of at least 8"
+#endif
+#if (SYS_MEMPOOL_CLASS_COUNT > 2U) && !SYS_MEMPOOL_SIZE_IS_VALID(SYS_MEMPOOL_CLASS2_BLOCK_SIZE)
+#error "SYS_MEMPOOL_CLASS2_BLOCK_SIZE must be a power of two of at least 8"
+#endif
+#if (SYS_MEMPOOL_CLASS_COUNT > 3U) && !SYS_MEMPOOL_SIZE_IS_VALID(SYS_MEMPOOL_CLASS3_BLOCK_SIZE)
+#error "SYS_MEMPOOL_CLASS3_BLOCK_SIZE must be a power of two of at least 8"
+#endif
+
+#ifdef SYS_MEMPOOL_INTERRUPT_SAFE
+#define SYS_MEMPOOL_LOCK(status)            do { (status) = __get_PRIMASK(); __disable_irq(); } while (false)
+#define SYS_MEMPOOL_UNLOCK(status)          __set_PRIMASK(status)
+#else
+#define SYS_MEMPOOL_LOCK(status)            do { (status) = 0U; } while (false)
+#define SYS_MEMPOOL_UNLOCK(status)          do { (void)(status); } while (false)
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+typedef union SYS_MEMPOOL_BLOCK
+{
+    union SYS_MEMPOOL_BLOCK     *next;
+
+    /* Every block starts on an 8-byte boundary */
+    uint64_t                    align;
+
+} SYS_MEMPOOL_BLOCK;
+
+typedef struct
+{
+    uint8_t             *start;
+    uint8_t             *end;
+    size_t              blockSize;
+    uint16_t            blockCount;
+    uint16_t            used;
+    uint16_t            highWater;
+    uint32_t            failures;
+    SYS_MEMPOOL_BLOCK   *freeList;
+
+} SYS_MEMPOOL_CLASS;
+
+static SYS_MEMPOOL_CLASS sysMempoolClass[SYS_MEMPOOL_CLASS_COUNT];
+
+/* Block storage: the free lists are built by SYS_MEMPOOL_Initialize */
+static uint64_t sysMempoolStorage0[(SYS_MEMPOOL_CLASS0_BLOCK_SIZE / 8U) * SYS_MEMPOOL_CLASS0_BLOCK_COUNT] SYS_BOOT_NO_INIT;
+#if (SYS_MEMPOOL_CLASS_COUNT > 1U)
+static uint64_t sysMempoolStorage1[(SYS_MEMPOOL_CLASS1_BLOCK_SIZE / 8U) * SYS_MEMPOOL_CLASS1_BLOCK_COUNT] SYS_BOOT_NO_INIT;
+#endif
+#if (SYS_MEMPOOL_CLASS_COUNT > 2U)
+static uint64_t sysMempoolStorage2[(SYS_MEMPOOL_CLASS2_BLOCK_SIZE / 8U) * SYS_MEMPOOL_CLASS2_BLOCK_COUNT] SYS_BOOT_NO_INIT;
+#endif
+#if (SYS_MEMPOOL_CLASS_COUNT > 3U)
+static uint64_t sysMempoolStorage3[(SYS_MEMPOOL_CLASS3_BLOCK_SIZE / 8U) * SYS_MEMPOOL_CLASS3_BLOCK_COUNT] SYS_BOOT_NO_INIT;
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void SYS_MEMPOOL_ClassInitialize( SYS_MEMPOOL_CLASS *poolClass, uint64_t *storage,
+                                         size_t blockSize, uint16_t blockCount )
+{
+    SYS_MEMPOOL_BLOCK *block;
+    uint32_t index;
+
+    poolClass->start = (uint8_t *)storage;
+    poolClass->end = poolClass->start + (blockSize * blockCount);
+    poolClass->blockSize = blockSize;
+    poolClass->blockCount = blockCount;
+    poolClass->used = 0U;
+    poolClass->highWater = 0U;
+    poolClass->failures = 0U;
+    poolClass->freeList = NULL;
+
+    /* Link from the last block so the list starts at the lowest address */
+    for (index = blockCount; index > 0U; index--)
+    {
+        block = (SYS_MEMPOOL_BLOCK *)&poolClass->start[(index - 1U) * blockSize];
+        block->next = poolClass->freeList;
+        poolClass->freeList = block;
+    }
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_MEMPOOL_Initialize( void )
+{
+    SYS_MEMPOOL_ClassInitialize(&sysMempoolClass[0], sysMempoolStorage0,
+                                SYS_MEMPOOL_CLASS0_BLOCK_SIZE, SYS_MEMPOOL_CLASS0_BLOCK_COUNT);
+#if (SYS_MEMPOOL_CLASS_COUNT > 1U)
+    SYS_MEMPOOL_ClassInitialize(&sysMempoolClass[1], sysMempoolStorage1,
+                                SYS_MEMPOOL_CLASS1_BLOCK_SIZE, SYS_MEMPOOL_CLASS1_BLOCK_COUNT);
+#endif
+#if (SYS_MEMPOOL_CLASS_COUNT > 2U)
+    SYS_MEMPOOL_ClassInitialize(&sysMempoolClass[2], sysMempoolStorage2,
+                                SYS_MEMPOOL_CLASS2_BLOCK_SIZE, SYS_MEMPOOL_CLASS2_BLOCK_COUNT);
+#endif
+#if (SYS_MEMPOOL_CLASS_COUNT > 3U)
+    SYS_MEMPOOL_ClassInitialize(&sysMempoolClass[3], sysMempoolStorage3,
+                                SYS_MEMPOOL_CLASS3_BLOCK_SIZE, SYS_MEMPOOL_CLASS3_BLOCK_COUNT);
+#endif
+}
+
+void *SYS_MEMPOOL_Alloc( size_t size )
+{
+    SYS_MEMPOOL_CLASS *poolClass;
+    SYS_MEMPOOL_CLASS *firstClass = NULL;
+    SYS_MEMPOOL_BLOCK *block = NULL;
+    uint32_t processorStatus;
+    uint32_t index;
+
+    if (size == 0U)
+    {
+        return NULL;
+    }
+
+    for (index = 0U; (block == NULL) && (index < SYS_MEMPOOL_CLASS_COUNT); index++)
+    {
+        poolClass = &sysMempoolClass[index];
+        if (poolClass->blockSize < size)
+        {
+            continue;
+        }
+
+        if (firstClass == NULL)
+        {
+            firstClass = poolClass;
+        }
+
+        SYS_MEMPOOL_LOCK(processorStatus);
+
+        block = poolClass->freeList;
+        if (block != NULL)
+        {
+            poolClass->freeList = block->next;
+            poolClass->used++;
+            if (poolClass->used > poolClass->highWater)
+            {
+                poolClass->highWater = poolClass->used;
+            }
+        }
+
+        SYS_MEMPOOL_UNLOCK(processorStatus);
+    }
+
+    /* A larger class serving the request is not a failure */
+    if ((block == NULL) && (firstClass != NULL))
+    {
+        SYS_MEMPOOL_LOCK(processorStatus);
+        firstClass->failures++;
+        SYS_MEMPOOL_UNLOCK(processorStatus);
+    }
+
+    return block;
+}
+
+void SYS_MEMPOOL_Free( void *block )
+{
+    SYS_MEMPOOL_CLASS *poolClass;
+    uint8_t *address = (uint8_t *)block;
+    uint32_t processorStatus;
+    uint32_t index;
+
+    for (index = 0U; index < SYS_MEMPOOL_CLASS_COUNT; index++)
+    {
+        poolClass = &sysMempoolClass[index];
+        if ((address < poolClass->start) || (address >= poolClass->end))
+        {
+            continue;
+        }
+
+        if ((((uintptr_t)address - (uintptr_t)poolClass->start) & (poolClass->blockSize - 1U)) == 0U)
+        {
+            SYS_MEMPOOL_LOCK(processorStatus);
+
+            ((SYS_MEMPOOL_BLOCK *)block)->next = poolClass->freeList;
+            poolClass->freeList = (SYS_MEMPOOL_BLOCK *)block;
+            poolClass->used--;
+
+            SYS_MEMPOOL_UNLOCK(processorStatus);
+        }
+        break;
+    }
+}
+
+bool SYS_MEMPOOL_StatisticsGet( uint32_t classIndex,
+                                SYS_MEMPOOL_STATISTICS *statistics )
+{
+    SYS_MEMPOOL_CLASS *poolClass;
+    uint32_t processorStatus;
+
+    if ((classIndex >= SYS_MEMPOOL_CLASS_COUNT) || (statistics == NULL))
+    {
+        return false;
+    }
+
+    poolClass = &sysMempoolClass[classIndex];
+
+    SYS_MEMPOOL_LOCK(processorStatus);
+
+    statistics->blockSize = poolClass->blockSize;
+    statistics->blockCount = poolClass->blockCount;
+    statistics->used = poolClass->used;
+    statistics->highWater = poolClass->highWater;
+    statistics->failures = poolClass->failures;
+
+    SYS_MEMPOOL_UNLOCK(processorStatus);
+
+    return true;
+}
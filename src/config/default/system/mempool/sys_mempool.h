@@ -0,0 +1,265 @@
+/*******************************************************************************
+  Memory Pool System Service Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_mempool.h
+
+  Summary
+    Fixed-size block allocator with several size classes.
+
+  Description
+    This file defines the interface to the memory pool system service. Each
+    size class is a static array of equal blocks with a free list, so an
+    allocation or a release takes constant time and memory never fragments.
+    A request is served from the smallest class whose blocks are large
+    enough, or from the next larger class when that one is exhausted.
+
+  Remarks:
+    The classes are set with the SYS_MEMPOOL_CLASSn_BLOCK_SIZE and
+    SYS_MEMPOOL_CLASSn_BLOCK_COUNT options in configuration.h. The service
+    backs OSAL_Malloc and OSAL_Free.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_MEMPOOL_H    // Guards against multiple inclusion
+#define SYS_MEMPOOL_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Size Class Statistics
+
+   Summary:
+    Usage of one size class.
+
+   Description:
+    Counts kept since SYS_MEMPOOL_Initialize.
+
+   Remarks:
+    None.
+*/
+
+typedef struct
+{
+    /* Size and number of the blocks */
+    size_t      blockSize;
+    uint16_t    blockCount;
+
+    /* Blocks allocated now */
+    uint16_t    used;
+
+    /* Highest value of used */
+    uint16_t    highWater;
+
+    /* Requests that fit this class first and that no class could serve */
+    uint32_t    failures;
+
+} SYS_MEMPOOL_STATISTICS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_MEMPOOL_Initialize( void )
+
+   Summary:
+    Releases every block and clears the statistics.
+
+   Description:
+    This function links every block of every size class into the class's
+    free list.
+
+   Precondition:
+    None.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    SYS_MEMPOOL_Initialize();
+    </code>
+
+  Remarks:
+    Called from SYS_Initialize before any other module can allocate.
+*/
+
+void SYS_MEMPOOL_Initialize( void );
+
+// *****************************************************************************
+/* Function:
+    void *SYS_MEMPOOL_Alloc( size_t size )
+
+   Summary:
+    Allocates a block of at least size bytes.
+
+   Description:
+    This function takes a block from the smallest size class that fits the
+    request and still has a free block.
+
+   Precondition:
+    SYS_MEMPOOL_Initialize must have been called.
+
+   Parameters:
+    size - Bytes needed.
+
+   Returns:
+    Block aligned to 8 bytes, or NULL if size is 0, larger than the largest
+    class, or no class that fits has a free block.
+
+  Example:
+    <code>
+    uint8_t *frame = SYS_MEMPOOL_Alloc(48U);
+
+    if (frame != NULL)
+    {
+    }
+    </code>
+
+  Remarks:
+    Can be called from interrupts when SYS_MEMPOOL_INTERRUPT_SAFE is
+    defined; the free list is then updated with interrupts masked for a few
+    instructions.
+*/
+
+void *SYS_MEMPOOL_Alloc( size_t size );
+
+// *****************************************************************************
+/* Function:
+    void SYS_MEMPOOL_Free( void *block )
+
+   Summary:
+    Releases a block.
+
+   Description:
+    This function returns the block to the free list of the size class that
+    holds it. The class is found from the block address.
+
+   Precondition:
+    SYS_MEMPOOL_Initialize must have been called.
+
+   Parameters:
+    block - Block from SYS_MEMPOOL_Alloc, or NULL.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    SYS_MEMPOOL_Free(frame);
+    </code>
+
+  Remarks:
+    A pointer that is not the start of a pool block is ignored.
+*/
+
+void SYS_MEMPOOL_Free( void *block );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_MEMPOOL_StatisticsGet( uint32_t classIndex,
+                                    SYS_MEMPOOL_STATISTICS *statistics )
+
+   Summary:
+    Returns the usage of a size class.
+
+   Description:
+    This function copies the statistics of one size class, the smallest
+    class being 0.
+
+   Precondition:
+    SYS_MEMPOOL_Initialize must have been called.
+
+   Parameters:
+    classIndex - 0 to SYS_MEMPOOL_CLASS_COUNT - 1.
+    statistics - Receives the statistics.
+
+   Returns:
+    false if classIndex is out of range.
+
+  Example:
+    <code>
+    SYS_MEMPOOL_STATISTICS statistics;
+    uint32_t index;
+
+    for (index = 0U; SYS_MEMPOOL_StatisticsGet(index, &statistics); index++)
+    {
+        SYS_LOG_PRINT(SYS_ERROR_INFO, "pool %u peak %u failed %u\r\n", index,
+                      statistics.highWater, statistics.failures);
+    }
+    </code>
+
+  Remarks:
+    The high-water marks show how far each class can be shrunk.
+*/
+
+bool SYS_MEMPOOL_StatisticsGet( uint32_t classIndex,
+                                SYS_MEMPOOL_STATISTICS *statistics );
+
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_MEMPOOL_H
@@ -0,0 +1,210 @@
+/*******************************************************************************
+  Power Management System Service Implementation File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_pm.c
+
+  Summary
+    Tickless idle sleep implementation.
+
+  Description
+    The sleep length is the time to the next tick plus the whole ticks until
+    the next SYS_TMR expiry. TC4 counts GCLK0 from SYS_TIME_Pause; its
+    period is set to end the sleep at the deadline. After the wake-up the
+    count gives the cycles asleep, whatever woke the CPU. With GCLK0 divided
+    one count is that many SYS_TIME cycles.
+
+  Remarks:
+    None.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "device.h"
+#include "definitions.h"
+#include "system/pm/sys_pm.h"
+
+#ifndef SYS_PM_IDLE_ALLOWED
+#define SYS_PM_IDLE_ALLOWED()       (true)
+#endif
+
+/* Longest sleep; SYS_TIME_Resume takes less than 2^31 cycles */
+#define SYS_PM_SLEEP_MAX_CYCLES     (0x7FFFFFFFUL)
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    uint64_t            sleepCycles;
+
+} SYS_PM_OBJECT;
+
+static SYS_PM_OBJECT sysPmObj;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Cycles until the wheel has work, from the point SYS_TIME was paused */
+static uint32_t SYS_PM_SleepCyclesCompute( uint32_t ticks, uint32_t toNextTick )
+{
+    uint32_t period = SYS_TIME_TickPeriodGet();
+
+    if ((ticks - 1U) >= ((SYS_PM_SLEEP_MAX_CYCLES - toNextTick) / period))
+    {
+        return SYS_PM_SLEEP_MAX_CYCLES;
+    }
+
+    return toNextTick + ((ticks - 1U) * period);
+}
+
+/* Called with interrupts masked. Sleeps until the tick that is ticks ahead
+ * of the current one, or without a deadline when isBounded is false. */
+static void SYS_PM_Sleep( bool isBounded, uint32_t ticks )
+{
+    uint32_t sleepCycles = SYS_PM_SLEEP_MAX_CYCLES;
+    uint32_t toNextTick;
+    uint32_t start;
+    uint32_t stop;
+    uint32_t elapsed;
+    uint32_t top = 0U;
+    uint32_t scale;
+    bool isExpired;
+    bool isAsleep = false;
+
+    if (SYS_PM_IDLE_ALLOWED() && ((isBounded == false) || (ticks != 0U)))
+    {
+        /* SYS_TIME cycles per TC4 count */
+        scale = SYS_TIME_FrequencyGet() / TC4_TimerFrequencyGet();
+
+        TC4_TimerStart();
+
+        toNextTick = SYS_TIME_Pause();
+        start = TC4_Timer32bitCounterGet();
+
+        if (isBounded)
+        {
+            sleepCycles = SYS_PM_SleepCyclesCompute(ticks, toNextTick);
+        }
+
+        if (sleepCycles >= SYS_PM_SLEEP_MIN_CYCLES)
+        {
+            top = start + (sleepCycles / scale);
+            TC4_Timer32bitPeriodSet(top);
+            (void)TC4_TimerPeriodHasExpired();
+
+            PM_IdleModeEnter(SYS_PM_IDLE_MODE);
+            isAsleep = true;
+        }
+
+        /* The counter wraps to 0 at the period; read it consistently with
+         * the wrap flag */
+        isExpired = TC4_TimerPeriodHasExpired();
+        stop = TC4_Timer32bitCounterGet();
+        if ((isExpired == false) && TC4_TimerPeriodHasExpired())
+        {
+            isExpired = true;
+            stop = TC4_Timer32bitCounterGet();
+        }
+
+        elapsed = (isExpired ? ((top - start) + 1U + stop) : (stop - start)) * scale;
+
+        SYS_TIME_Resume(elapsed);
+
+        TC4_TimerStop();
+        TC4_Timer32bitPeriodSet(0xFFFFFFFFU);
+        TC4_Timer32bitCounterSet(0U);
+        (void)TC4_TimerPeriodHasExpired();
+
+        if (isAsleep)
+        {
+            sysPmObj.sleepCycles += elapsed;
+        }
+    }
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_PM_Initialize( void )
+{
+    TC4_TimerStop();
+    TC4_Timer32bitCounterSet(0U);
+    (void)TC4_TimerPeriodHasExpired();
+
+    sysPmObj.sleepCycles = 0U;
+}
+
+void SYS_PM_Idle( void )
+{
+    uint32_t processorStatus;
+    uint32_t ticks = 0U;
+    bool isTimerRunning;
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    isTimerRunning = SYS_TMR_NextExpiryGet(&ticks);
+    SYS_PM_Sleep(isTimerRunning, ticks);
+
+    __set_PRIMASK(processorStatus);
+}
+
+uint64_t SYS_PM_SleepCyclesGet( void )
+{
+    uint64_t sleepCycles;
+    uint32_t processorStatus;
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    sleepCycles = sysPmObj.sleepCycles;
+
+    __set_PRIMASK(processorStatus);
+
+    return sleepCycles;
+}
@@ -0,0 +1,189 @@
+/*******************************************************************************
+  Power Management System Service Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_pm.h
+
+  Summary
+    Tickless idle sleep for the SYS_Tasks loop.
+
+  Description
+    This file defines the interface to the power management system service.
+    At the end of every SYS_Tasks pass, SYS_PM_Idle puts the CPU to sleep
+    until the next interrupt or the next SYS_TMR expiry. SysTick is stopped
+    for the sleep, so no tick interrupt wakes the CPU in between.
+
+  Remarks:
+    TC4 (paired with TC5 as a 32-bit counter) is owned by this service. It
+    wakes the CPU at the timer deadline and measures the sleep, which is then
+    added to the SYS_TIME timebase.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_PM_H    // Guards against multiple inclusion
+#define SYS_PM_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_PM_Initialize( void )
+
+   Summary:
+    Prepares TC4 for measuring sleeps.
+
+   Description:
+    This function stops and clears the TC4 counter and the sleep statistics.
+
+   Precondition:
+    PM_Initialize, TC4_TimerInitialize and SYS_TIME_Initialize must have been
+    called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    SYS_PM_Initialize();
+    </code>
+
+  Remarks:
+    None.
+*/
+
+void SYS_PM_Initialize( void );
+
+// *****************************************************************************
+/* Function:
+    void SYS_PM_Idle( void )
+
+   Summary:
+    Sleeps until there is work to do.
+
+   Description:
+    This function puts the CPU in SYS_PM_IDLE_MODE when
+    SYS_PM_IDLE_ALLOWED() is true and no timer is due. TC4 is set to wake it
+    at the next SYS_TMR expiry; any interrupt ends the sleep earlier. The
+    time spent asleep is added to SYS_TIME before the function returns.
+
+   Precondition:
+    SYS_PM_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    while (true)
+    {
+        SYS_Tasks();
+    }
+    </code>
+
+  Remarks:
+    Called at the end of SYS_Tasks. Interrupts stay masked from the decision
+    to sleep until SYS_TIME is corrected, so an interrupt that arrives in
+    between cancels the sleep instead of being missed; its handler runs when
+    this function returns. Sleeps shorter than SYS_PM_SLEEP_MIN_CYCLES are
+    skipped.
+*/
+
+void SYS_PM_Idle( void );
+
+// *****************************************************************************
+/* Function:
+    uint64_t SYS_PM_SleepCyclesGet( void )
+
+   Summary:
+    Returns the CPU cycles spent asleep since SYS_PM_Initialize.
+
+   Description:
+    Compared with SYS_TIME_Now, this gives the share of time spent idle.
+
+   Precondition:
+    SYS_PM_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    Cycles asleep.
+
+  Example:
+    <code>
+    uint64_t idle = SYS_PM_SleepCyclesGet();
+    </code>
+
+  Remarks:
+    None.
+*/
+
+uint64_t SYS_PM_SleepCyclesGet( void );
+
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_PM_H
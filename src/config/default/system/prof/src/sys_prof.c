@@ -0,0 +1,229 @@
+/*******************************************************************************
+  Profiling System Service Implementation File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_prof.c
+
+  Summary
+    Profiling system service implementation.
+
+  Description
+    Durations are SYS_TIME cycles. The histogram bucket is the bit length of
+    the duration shifted right by SYS_PROF_BUCKET_SHIFT, found without a
+    count-leading-zeros instruction, which the Cortex-M0+ lacks: the bits
+    below the highest are filled in and a De Bruijn multiply indexes the
+    result. Means are only divided out when printing.
+
+  Remarks:
+    None.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdio.h>
+#include "device.h"
+#include "system/time/sys_time.h"
+#include "system/prof/sys_prof.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Profiles recorded so far, in order of their first record */
+static SYS_PROF_OBJECT *sysProfHead;
+static SYS_PROF_OBJECT **sysProfTail = &sysProfHead;
+
+/* Index of the highest set bit, indexed by (2^(n+1) - 1) * 0x07C4ACDD >> 27 */
+static const uint8_t sysProfBitIndex[32] =
+{
+     0U,  9U,  1U, 10U, 13U, 21U,  2U, 29U, 11U, 14U, 16U, 18U, 22U, 25U,  3U, 30U,
+     8U, 12U, 20U, 28U, 15U, 17U, 24U,  7U, 19U, 27U, 23U,  6U, 26U,  5U,  4U, 31U
+};
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t SYS_PROF_BucketGet( uint32_t cycles )
+{
+    uint32_t value = cycles >> SYS_PROF_BUCKET_SHIFT;
+    uint32_t bucket;
+
+    if (value == 0U)
+    {
+        return 0U;
+    }
+
+    value |= value >> 1;
+    value |= value >> 2;
+    value |= value >> 4;
+    value |= value >> 8;
+    value |= value >> 16;
+
+    bucket = (uint32_t)sysProfBitIndex[(value * 0x07C4ACDDU) >> 27] + 1U;
+
+    return (bucket < SYS_PROF_BUCKET_COUNT) ? bucket : (SYS_PROF_BUCKET_COUNT - 1U);
+}
+
+static void SYS_PROF_Clear( SYS_PROF_OBJECT *profile )
+{
+    uint32_t index;
+
+    profile->count = 0U;
+    profile->min = 0U;
+    profile->max = 0U;
+    profile->total = 0U;
+
+    for (index = 0U; index < SYS_PROF_BUCKET_COUNT; index++)
+    {
+        profile->buckets[index] = 0U;
+    }
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+uint32_t SYS_PROF_TimestampGet( void )
+{
+    return (uint32_t)SYS_TIME_Now();
+}
+
+void SYS_PROF_Record( SYS_PROF_OBJECT *profile, uint32_t start )
+{
+    uint32_t cycles = (uint32_t)SYS_TIME_Now() - start;
+    uint32_t processorStatus;
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    if (profile->isRegistered == false)
+    {
+        profile->isRegistered = true;
+        profile->next = NULL;
+        *sysProfTail = profile;
+        sysProfTail = &profile->next;
+    }
+
+    if ((profile->count == 0U) || (cycles < profile->min))
+    {
+        profile->min = cycles;
+    }
+    if (cycles > profile->max)
+    {
+        profile->max = cycles;
+    }
+    profile->count++;
+    profile->total += cycles;
+    profile->buckets[SYS_PROF_BucketGet(cycles)]++;
+
+    __set_PRIMASK(processorStatus);
+}
+
+void SYS_PROF_Reset( void )
+{
+    SYS_PROF_OBJECT *profile;
+    uint32_t processorStatus;
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    for (profile = sysProfHead; profile != NULL; profile = profile->next)
+    {
+        SYS_PROF_Clear(profile);
+    }
+
+    __set_PRIMASK(processorStatus);
+}
+
+void SYS_PROF_Print( void )
+{
+    SYS_PROF_OBJECT *profile;
+    SYS_PROF_OBJECT copy;
+    uint32_t processorStatus;
+    uint32_t index;
+    uint32_t mean;
+
+    printf("\r\n%-16s %10s %8s %8s %8s\r\n", "profile", "count", "min us", "mean us", "max us");
+
+    /* Profiles are only ever appended, so the links stay valid */
+    for (profile = sysProfHead; profile != NULL; profile = profile->next)
+    {
+        processorStatus = __get_PRIMASK();
+        __disable_irq();
+
+        copy = *profile;
+
+        __set_PRIMASK(processorStatus);
+
+        mean = (copy.count == 0U) ? 0U : (uint32_t)(copy.total / copy.count);
+
+        printf("%-16s %10lu %8lu %8lu %8lu\r\n", (copy.name != NULL) ? copy.name : "?",
+               (unsigned long)copy.count,
+               (unsigned long)SYS_TIME_CyclesToUS(copy.min),
+               (unsigned long)SYS_TIME_CyclesToUS(mean),
+               (unsigned long)SYS_TIME_CyclesToUS(copy.max));
+
+        for (index = 0U; index < SYS_PROF_BUCKET_COUNT; index++)
+        {
+            if (copy.buckets[index] == 0U)
+            {
+                continue;
+            }
+
+            if (index == (SYS_PROF_BUCKET_COUNT - 1U))
+            {
+                printf("  >= %8lu us %10lu\r\n",
+                       (unsigned long)SYS_TIME_CyclesToUS(1ULL << (SYS_PROF_BUCKET_SHIFT + index - 1U)),
+                       (unsigned long)copy.buckets[index]);
+            }
+            else
+            {
+                printf("  <  %8lu us %10lu\r\n",
+                       (unsigned long)SYS_TIME_CyclesToUS(1ULL << (SYS_PROF_BUCKET_SHIFT + index)),
+                       (unsigned long)copy.buckets[index]);
+            }
+        }
+    }
+}
@@ -0,0 +1,313 @@
+/*******************************************************************************
+  Profiling System Service Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_prof.h
+
+  Summary
+    Run-time statistics of tasks and code sections.
+
+  Description
+    This file defines the interface to the profiling system service. A
+    profile object collects the durations of one piece of code, measured in
+    SYS_TIME cycles: count, minimum, mean, maximum and a histogram with one
+    bucket per power of two. SYS_SCHED profiles every task it dispatches and
+    SYS_Tasks profiles the polled services and its own passes.
+
+  Remarks:
+    Compiled in when SYS_PROF_ENABLE is defined; otherwise the macros of
+    this file only run the code they measure.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_PROF_H    // Guards against multiple inclusion
+#define SYS_PROF_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+#ifndef SYS_PROF_BUCKET_COUNT
+#define SYS_PROF_BUCKET_COUNT       (16U)
+#endif
+
+#ifndef SYS_PROF_BUCKET_SHIFT
+#define SYS_PROF_BUCKET_SHIFT       (6U)
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Profile Object
+
+   Summary:
+    Statistics of one measured piece of code.
+
+   Description:
+    The caller provides the object, usually through SYS_PROF_DECLARE, and
+    keeps it allocated. It is added to the list SYS_PROF_Print walks when
+    its first duration is recorded. Bucket 0 counts the durations below
+    2^SYS_PROF_BUCKET_SHIFT cycles, bucket n those from
+    2^(SYS_PROF_BUCKET_SHIFT + n - 1) up to twice that, and the last bucket
+    everything longer.
+
+   Remarks:
+    The object must be zeroed before its first use, apart from the name.
+*/
+
+typedef struct SYS_PROF_OBJECT
+{
+    struct SYS_PROF_OBJECT  *next;
+
+    const char              *name;
+
+    bool                    isRegistered;
+
+    uint32_t                count;
+    uint32_t                min;
+    uint32_t                max;
+    uint64_t                total;
+
+    uint32_t                buckets[SYS_PROF_BUCKET_COUNT];
+
+} SYS_PROF_OBJECT;
+
+/* Static initializer of a profile object */
+#define SYS_PROF_OBJECT_INIT(profileName)       { .name = (profileName) }
+
+// *****************************************************************************
+/* Macros:
+    SYS_PROF_DECLARE(profile, name)
+    SYS_PROF_MEASURE(profile, code)
+
+   Summary:
+    Define a static profile object and measure a statement with it.
+
+   Description:
+    SYS_PROF_MEASURE runs the code and records its duration in the profile.
+    Without SYS_PROF_ENABLE, SYS_PROF_DECLARE defines nothing and
+    SYS_PROF_MEASURE only runs the code.
+
+  Example:
+    <code>
+    SYS_PROF_DECLARE(sysLogProfile, "SYS_LOG");
+
+    SYS_PROF_MEASURE(&sysLogProfile, SYS_LOG_Tasks());
+    </code>
+*/
+
+#if defined(SYS_PROF_ENABLE)
+#define SYS_PROF_DECLARE(profile, name)                                 \
+    static SYS_PROF_OBJECT profile = SYS_PROF_OBJECT_INIT(name)
+
+#define SYS_PROF_MEASURE(profile, code)                                 \
+    do                                                                  \
+    {                                                                   \
+        uint32_t sysProfStart = SYS_PROF_TimestampGet();                \
+        code;                                                           \
+        SYS_PROF_Record((profile), sysProfStart);                       \
+    } while (false)
+#else
+#define SYS_PROF_DECLARE(profile, name)
+#define SYS_PROF_MEASURE(profile, code)                                 \
+    do                                                                  \
+    {                                                                   \
+        code;                                                           \
+    } while (false)
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_PROF_TimestampGet( void )
+
+   Summary:
+    Returns the start timestamp of a measurement.
+
+   Description:
+    This function returns the low 32 bits of SYS_TIME_Now, which count the
+    SysTick cycles. Durations up to 2^32 cycles are measured correctly.
+
+   Precondition:
+    SYS_TIME_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    Timestamp to pass to SYS_PROF_Record.
+
+  Example:
+    <code>
+    uint32_t start = SYS_PROF_TimestampGet();
+
+    APP_Step();
+    SYS_PROF_Record(&appStepProfile, start);
+    </code>
+
+  Remarks:
+    None.
+*/
+
+uint32_t SYS_PROF_TimestampGet( void );
+
+// *****************************************************************************
+/* Function:
+    void SYS_PROF_Record( SYS_PROF_OBJECT *profile, uint32_t start )
+
+   Summary:
+    Records the time since start in a profile.
+
+   Description:
+    This function adds the duration from start to now to the statistics of
+    the profile, and adds the profile to the printed list the first time.
+
+   Precondition:
+    start must come from SYS_PROF_TimestampGet.
+
+   Parameters:
+    profile - Profile object.
+    start   - Timestamp taken when the measured code started.
+
+   Returns:
+    None.
+
+  Example:
+    See SYS_PROF_TimestampGet.
+
+  Remarks:
+    A profile must only be recorded from one context. Different profiles
+    may be recorded from different tasks or interrupts.
+*/
+
+void SYS_PROF_Record( SYS_PROF_OBJECT *profile, uint32_t start );
+
+// *****************************************************************************
+/* Function:
+    void SYS_PROF_Reset( void )
+
+   Summary:
+    Clears the statistics of all profiles.
+
+   Description:
+    This function starts a new measurement period, for example after the
+    start-up, whose long first passes would hide the spikes of interest.
+
+   Precondition:
+    None.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    SYS_PROF_Reset();
+    </code>
+
+  Remarks:
+    None.
+*/
+
+void SYS_PROF_Reset( void );
+
+// *****************************************************************************
+/* Function:
+    void SYS_PROF_Print( void )
+
+   Summary:
+    Prints the statistics of all profiles on the console.
+
+   Description:
+    For every profile this function prints the count and the minimum, mean
+    and maximum durations in microseconds, followed by the non-empty
+    histogram buckets, each labeled with its upper bound in microseconds.
+
+   Precondition:
+    The console must have been initialized.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    if (command == 'p')
+    {
+        SYS_PROF_Print();
+    }
+    </code>
+
+  Remarks:
+    Prints through stdio, so it must not be called from an interrupt. Each
+    profile is copied with interrupts masked, so its numbers are consistent.
+*/
+
+void SYS_PROF_Print( void );
+
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_PROF_H
@@ -0,0 +1,234 @@
+/*******************************************************************************
+  Queue System Service Implementation File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_queue.c
+
+  Summary
+    Single- and multi-producer ring queue implementation.
+
+  Description
+    The indexes are 32-bit words, which the Cortex-M0+ reads and writes
+    atomically. A data memory barrier orders the element copy against the
+    index or flag update that hands the slot to the other side, so the
+    other side never sees a slot before its contents.
+
+    The Cortex-M0+ has no exclusive load/store, so the MPSC reservation is
+    the one step done with interrupts masked.
+
+  Remarks:
+    None.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <string.h>
+#include "device.h"
+#include "system/queue/sys_queue.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static bool SYS_QUEUE_CapacityIsValid( uint32_t capacity )
+{
+    return ((capacity != 0U) && ((capacity & (capacity - 1U)) == 0U));
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+bool SYS_QUEUE_SPSC_Initialize( SYS_QUEUE_SPSC *queue, void *buffer,
+                                size_t elementSize, uint32_t capacity )
+{
+    if ((queue == NULL) || (buffer == NULL) || (elementSize == 0U) ||
+        (SYS_QUEUE_CapacityIsValid(capacity) == false))
+    {
+        return false;
+    }
+
+    queue->buffer = (uint8_t *)buffer;
+    queue->elementSize = elementSize;
+    queue->mask = capacity - 1U;
+    queue->head = 0U;
+    queue->tail = 0U;
+
+    return true;
+}
+
+bool SYS_QUEUE_SPSC_Put( SYS_QUEUE_SPSC *queue, const void *element )
+{
+    uint32_t head = queue->head;
+
+    if ((head - queue->tail) > queue->mask)
+    {
+        return false;
+    }
+
+    (void)memcpy(&queue->buffer[(head & queue->mask) * queue->elementSize],
+                 element, queue->elementSize);
+
+    /* The element before the index that publishes it */
+    __DMB();
+    queue->head = head + 1U;
+
+    return true;
+}
+
+bool SYS_QUEUE_SPSC_Get( SYS_QUEUE_SPSC *queue, void *element )
+{
+    uint32_t tail = queue->tail;
+
+    if (queue->head == tail)
+    {
+        return false;
+    }
+
+    /* The index before the element it published */
+    __DMB();
+    (void)memcpy(element, &queue->buffer[(tail & queue->mask) * queue->elementSize],
+                 queue->elementSize);
+
+    /* The copy before the slot is handed back */
+    __DMB();
+    queue->tail = tail + 1U;
+
+    return true;
+}
+
+uint32_t SYS_QUEUE_SPSC_CountGet( const SYS_QUEUE_SPSC *queue )
+{
+    uint32_t tail = queue->tail;
+
+    return (queue->head - tail);
+}
+
+bool SYS_QUEUE_MPSC_Initialize( SYS_QUEUE_MPSC *queue, void *buffer,
+                                volatile bool *isFull, size_t elementSize,
+                                uint32_t capacity )
+{
+    uint32_t index;
+
+    if ((queue == NULL) || (buffer == NULL) || (isFull == NULL) ||
+        (elementSize == 0U) || (SYS_QUEUE_CapacityIsValid(capacity) == false))
+    {
+        return false;
+    }
+
+    queue->buffer = (uint8_t *)buffer;
+    queue->isFull = isFull;
+    queue->elementSize = elementSize;
+    queue->mask = capacity - 1U;
+    queue->head = 0U;
+    queue->tail = 0U;
+
+    for (index = 0U; index < capacity; index++)
+    {
+        isFull[index] = false;
+    }
+
+    return true;
+}
+
+bool SYS_QUEUE_MPSC_Put( SYS_QUEUE_MPSC *queue, const void *element )
+{
+    uint32_t processorStatus;
+    uint32_t slot;
+    bool isReserved = false;
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    slot = queue->head;
+    if ((slot - queue->tail) <= queue->mask)
+    {
+        queue->head = slot + 1U;
+        isReserved = true;
+    }
+
+    __set_PRIMASK(processorStatus);
+
+    if (isReserved)
+    {
+        slot &= queue->mask;
+
+        (void)memcpy(&queue->buffer[slot * queue->elementSize], element,
+                     queue->elementSize);
+
+        /* The element before the flag that publishes it */
+        __DMB();
+        queue->isFull[slot] = true;
+    }
+
+    return isReserved;
+}
+
+bool SYS_QUEUE_MPSC_Get( SYS_QUEUE_MPSC *queue, void *element )
+{
+    uint32_t tail = queue->tail;
+    uint32_t slot = tail & queue->mask;
+
+    /* Reserved slots are only full once their producer has finished */
+    if ((queue->head == tail) || (queue->isFull[slot] == false))
+    {
+        return false;
+    }
+
+    /* The flag before the element it published */
+    __DMB();
+    (void)memcpy(element, &queue->buffer[slot * queue->elementSize],
+                 queue->elementSize);
+
+    /* The slot is empty again before a producer can reserve it */
+    queue->isFull[slot] = false;
+    __DMB();
+    queue->tail = tail + 1U;
+
+    return true;
+}
+
+uint32_t SYS_QUEUE_MPSC_CountGet( const SYS_QUEUE_MPSC *queue )
+{
+    uint32_t tail = queue->tail;
+
+    return (queue->head - tail);
+}
@@ -0,0 +1,453 @@
+/*******************************************************************************
+  Queue System Service Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_queue.h
+
+  Summary
+    Ring queues for passing messages from interrupts to tasks.
+
+  Description
+    This file defines two bounded ring queues of fixed-size elements. The
+    single-producer queue (SPSC) never masks interrupts: the producer only
+    writes the head index and the consumer only the tail index. The
+    multi-producer queue (MPSC) lets several interrupts and tasks put
+    elements; each producer masks interrupts only to reserve a slot, and
+    copies its element with interrupts enabled.
+
+  Remarks:
+    Both queues have a single consumer, usually a SYS_SCHED task that the
+    producer signals after a put.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_QUEUE_H    // Guards against multiple inclusion
+#define SYS_QUEUE_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Single-Producer Queue Object
+
+   Summary:
+    Storage for one single-producer, single-consumer queue.
+
+   Description:
+    The caller provides the object and the element buffer. The members are
+    private to the service.
+
+   Remarks:
+    The head and tail indexes run freely and are reduced to a slot with the
+    capacity mask, so a full queue uses every slot.
+*/
+
+typedef struct
+{
+    uint8_t             *buffer;
+    size_t              elementSize;
+    uint32_t            mask;
+
+    /* Elements put; written by the producer only */
+    volatile uint32_t   head;
+
+    /* Elements taken; written by the consumer only */
+    volatile uint32_t   tail;
+
+} SYS_QUEUE_SPSC;
+
+// *****************************************************************************
+/* Multi-Producer Queue Object
+
+   Summary:
+    Storage for one multi-producer, single-consumer queue.
+
+   Description:
+    The caller provides the object, the element buffer and one flag per
+    element. The members are private to the service.
+
+   Remarks:
+    A slot is reserved by advancing head, then filled, then marked full. The
+    consumer stops at the first slot that is not full yet, so elements come
+    out in the order their slots were reserved.
+*/
+
+typedef struct
+{
+    uint8_t             *buffer;
+
+    /* Set by the producer once the slot's element is written */
+    volatile bool       *isFull;
+
+    size_t              elementSize;
+    uint32_t            mask;
+
+    /* Slots reserved; advanced with interrupts masked */
+    volatile uint32_t   head;
+
+    /* Elements taken; written by the consumer only */
+    volatile uint32_t   tail;
+
+} SYS_QUEUE_MPSC;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    bool SYS_QUEUE_SPSC_Initialize( SYS_QUEUE_SPSC *queue, void *buffer,
+                                    size_t elementSize, uint32_t capacity )
+
+   Summary:
+    Prepares an empty single-producer queue.
+
+   Description:
+    This function attaches the element buffer, which holds capacity elements
+    of elementSize bytes, and empties the queue.
+
+   Precondition:
+    None.
+
+   Parameters:
+    queue       - Queue object.
+    buffer      - capacity * elementSize bytes.
+    elementSize - Size of one element in bytes.
+    capacity    - Number of elements, a power of two.
+
+   Returns:
+    true if the queue was prepared, false if an argument is invalid.
+
+  Example:
+    <code>
+    static SYS_QUEUE_SPSC rxQueue;
+    static uint16_t rxQueueBuffer[16];
+
+    SYS_QUEUE_SPSC_Initialize(&rxQueue, rxQueueBuffer, sizeof(uint16_t), 16U);
+    </code>
+
+  Remarks:
+    Must not run concurrently with a put or a get.
+*/
+
+bool SYS_QUEUE_SPSC_Initialize( SYS_QUEUE_SPSC *queue, void *buffer,
+                                size_t elementSize, uint32_t capacity );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_QUEUE_SPSC_Put( SYS_QUEUE_SPSC *queue, const void *element )
+
+   Summary:
+    Copies an element into the queue.
+
+   Description:
+    This function copies the element into the next free slot and then
+    publishes it to the consumer.
+
+   Precondition:
+    SYS_QUEUE_SPSC_Initialize must have been called.
+
+   Parameters:
+    queue   - Queue object.
+    element - elementSize bytes to copy.
+
+   Returns:
+    false if the queue is full; the element is dropped.
+
+  Example:
+    <code>
+    void APP_RxHandler( uintptr_t context )
+    {
+        uint16_t data = APP_RxRead();
+
+        if (SYS_QUEUE_SPSC_Put(&rxQueue, &data))
+        {
+            SYS_SCHED_EventSignal(&appTask, APP_EVENT_RX);
+        }
+    }
+    </code>
+
+  Remarks:
+    Only one context may put into a given queue, typically one interrupt.
+    Interrupts are not masked.
+*/
+
+bool SYS_QUEUE_SPSC_Put( SYS_QUEUE_SPSC *queue, const void *element );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_QUEUE_SPSC_Get( SYS_QUEUE_SPSC *queue, void *element )
+
+   Summary:
+    Takes the oldest element from the queue.
+
+   Description:
+    This function copies the oldest element out and frees its slot.
+
+   Precondition:
+    SYS_QUEUE_SPSC_Initialize must have been called.
+
+   Parameters:
+    queue   - Queue object.
+    element - Receives elementSize bytes.
+
+   Returns:
+    false if the queue is empty.
+
+  Example:
+    <code>
+    uint16_t data;
+
+    while (SYS_QUEUE_SPSC_Get(&rxQueue, &data))
+    {
+    }
+    </code>
+
+  Remarks:
+    Only one context may take from a given queue. Interrupts are not masked.
+*/
+
+bool SYS_QUEUE_SPSC_Get( SYS_QUEUE_SPSC *queue, void *element );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_QUEUE_SPSC_CountGet( const SYS_QUEUE_SPSC *queue )
+
+   Summary:
+    Returns the number of elements in the queue.
+
+   Description:
+    This function returns the number of elements put and not yet taken.
+
+   Precondition:
+    SYS_QUEUE_SPSC_Initialize must have been called.
+
+   Parameters:
+    queue - Queue object.
+
+   Returns:
+    Number of elements, a snapshot when other contexts use the queue.
+
+  Example:
+    <code>
+    if (SYS_QUEUE_SPSC_CountGet(&rxQueue) != 0U)
+    {
+    }
+    </code>
+
+  Remarks:
+    None.
+*/
+
+uint32_t SYS_QUEUE_SPSC_CountGet( const SYS_QUEUE_SPSC *queue );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_QUEUE_MPSC_Initialize( SYS_QUEUE_MPSC *queue, void *buffer,
+                                    volatile bool *isFull, size_t elementSize,
+                                    uint32_t capacity )
+
+   Summary:
+    Prepares an empty multi-producer queue.
+
+   Description:
+    This function attaches the element buffer and the slot flags, and
+    empties the queue.
+
+   Precondition:
+    None.
+
+   Parameters:
+    queue       - Queue object.
+    buffer      - capacity * elementSize bytes.
+    isFull      - capacity flags.
+    elementSize - Size of one element in bytes.
+    capacity    - Number of elements, a power of two.
+
+   Returns:
+    true if the queue was prepared, false if an argument is invalid.
+
+  Example:
+    <code>
+    static SYS_QUEUE_MPSC eventQueue;
+    static APP_EVENT eventQueueBuffer[8];
+    static volatile bool eventQueueFull[8];
+
+    SYS_QUEUE_MPSC_Initialize(&eventQueue, eventQueueBuffer, eventQueueFull,
+                              sizeof(APP_EVENT), 8U);
+    </code>
+
+  Remarks:
+    Must not run concurrently with a put or a get.
+*/
+
+bool SYS_QUEUE_MPSC_Initialize( SYS_QUEUE_MPSC *queue, void *buffer,
+                                volatile bool *isFull, size_t elementSize,
+                                uint32_t capacity );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_QUEUE_MPSC_Put( SYS_QUEUE_MPSC *queue, const void *element )
+
+   Summary:
+    Copies an element into the queue from any context.
+
+   Description:
+    This function reserves a slot with interrupts masked for a few
+    instructions, copies the element with interrupts enabled and then marks
+    the slot full.
+
+   Precondition:
+    SYS_QUEUE_MPSC_Initialize must have been called.
+
+   Parameters:
+    queue   - Queue object.
+    element - elementSize bytes to copy.
+
+   Returns:
+    false if the queue is full; the element is dropped.
+
+  Example:
+    <code>
+    APP_EVENT event = { .source = APP_SOURCE_BUTTON, .data = 1U };
+
+    (void)SYS_QUEUE_MPSC_Put(&eventQueue, &event);
+    </code>
+
+  Remarks:
+    Can be called from any number of interrupts and tasks. A put that is
+    interrupted between reservation and completion holds back the elements
+    reserved after it until it completes.
+*/
+
+bool SYS_QUEUE_MPSC_Put( SYS_QUEUE_MPSC *queue, const void *element );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_QUEUE_MPSC_Get( SYS_QUEUE_MPSC *queue, void *element )
+
+   Summary:
+    Takes the oldest element from the queue.
+
+   Description:
+    This function copies the oldest element out and frees its slot.
+
+   Precondition:
+    SYS_QUEUE_MPSC_Initialize must have been called.
+
+   Parameters:
+    queue   - Queue object.
+    element - Receives elementSize bytes.
+
+   Returns:
+    false if the queue is empty or its oldest slot is still being written.
+
+  Example:
+    <code>
+    APP_EVENT event;
+
+    while (SYS_QUEUE_MPSC_Get(&eventQueue, &event))
+    {
+    }
+    </code>
+
+  Remarks:
+    Only one context may take from a given queue. Interrupts are not masked.
+*/
+
+bool SYS_QUEUE_MPSC_Get( SYS_QUEUE_MPSC *queue, void *element );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_QUEUE_MPSC_CountGet( const SYS_QUEUE_MPSC *queue )
+
+   Summary:
+    Returns the number of reserved slots.
+
+   Description:
+    This function returns the number of slots reserved and not yet taken,
+    including those still being written.
+
+   Precondition:
+    SYS_QUEUE_MPSC_Initialize must have been called.
+
+   Parameters:
+    queue - Queue object.
+
+   Returns:
+    Number of slots, a snapshot when other contexts use the queue.
+
+  Example:
+    <code>
+    if (SYS_QUEUE_MPSC_CountGet(&eventQueue) != 0U)
+    {
+    }
+    </code>
+
+  Remarks:
+    None.
+*/
+
+uint32_t SYS_QUEUE_MPSC_CountGet( const SYS_QUEUE_MPSC *queue );
+
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_QUEUE_H
@@ -0,0 +1,338 @@
+/*******************************************************************************
+  Scheduler System Service Implementation File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_sched.c
+
+  Summary
+    Cooperative priority scheduler implementation.
+
+  Description
+    Every priority level has a FIFO of ready tasks and one bit in the ready
+    mask. The highest priority ready level is the lowest set bit of the
+    mask. The Cortex-M0+ has no count-leading-zeros instruction, so the bit
+    is isolated and its index looked up through a de Bruijn sequence, which
+    takes constant time whatever the number of tasks.
+
+  Remarks:
+    None.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "device.h"
+#include "system/sched/sys_sched.h"
+
+#ifndef SYS_SCHED_DISPATCH_MAX
+#define SYS_SCHED_DISPATCH_MAX      (8U)
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    SYS_SCHED_TASK      *head;
+    SYS_SCHED_TASK      *tail;
+
+} SYS_SCHED_QUEUE;
+
+typedef struct
+{
+    SYS_SCHED_QUEUE     ready[SYS_SCHED_PRIORITY_LEVELS];
+
+    /* Bit n is set while ready[n] is not empty */
+    volatile uint32_t   readyMask;
+
+    /* Task whose function SYS_SCHED_Tasks is running */
+    SYS_SCHED_TASK      *running;
+
+} SYS_SCHED_OBJECT;
+
+static SYS_SCHED_OBJECT sysSchedObj;
+
+/* Bit index of a power of two, indexed by (bit * 0x077CB531) >> 27 */
+static const uint8_t sysSchedBitIndex[32] =
+{
+     0U,  1U, 28U,  2U, 29U, 14U, 24U,  3U, 30U, 22U, 20U, 15U, 25U, 17U,  4U,  8U,
+    31U, 27U, 13U, 23U, 21U, 19U, 16U,  7U, 26U, 12U, 18U,  6U, 11U,  5U, 10U,  9U
+};
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Priority of the highest priority ready task; mask must not be 0 */
+static uint32_t SYS_SCHED_HighestReadyGet( uint32_t mask )
+{
+    return sysSchedBitIndex[((mask & (0U - mask)) * 0x077CB531U) >> 27];
+}
+
+/* Called with interrupts masked */
+static void SYS_SCHED_WaitUnlink( SYS_SCHED_TASK *task )
+{
+    SYS_SCHED_TASK **link = &task->waitQueue->head;
+
+    while (*link != task)
+    {
+        link = &(*link)->waitNext;
+    }
+    *link = task->waitNext;
+
+    task->waitQueue = NULL;
+    task->waitNext = NULL;
+}
+
+/* Called with interrupts masked */
+static void SYS_SCHED_Enqueue( SYS_SCHED_TASK *task )
+{
+    SYS_SCHED_QUEUE *queue = &sysSchedObj.ready[task->priority];
+
+    task->next = NULL;
+    if (queue->head == NULL)
+    {
+        queue->head = task;
+        sysSchedObj.readyMask |= (1UL << task->priority);
+    }
+    else
+    {
+        queue->tail->next = task;
+    }
+    queue->tail = task;
+    task->isReady = true;
+}
+
+static void SYS_SCHED_TimerHandler( uintptr_t context )
+{
+    SYS_SCHED_EventSignal((SYS_SCHED_TASK *)context, SYS_SCHED_EVENT_TIMER);
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_SCHED_Initialize( void )
+{
+    uint32_t priority;
+
+    for (priority = 0U; priority < SYS_SCHED_PRIORITY_LEVELS; priority++)
+    {
+        sysSchedObj.ready[priority].head = NULL;
+        sysSchedObj.ready[priority].tail = NULL;
+    }
+
+    sysSchedObj.readyMask = 0U;
+    sysSchedObj.running = NULL;
+}
+
+void SYS_SCHED_Tasks( void )
+{
+    uint32_t processorStatus;
+    uint32_t dispatched;
+    uint32_t priority;
+    uint32_t events;
+    SYS_SCHED_QUEUE *queue;
+    SYS_SCHED_TASK *task;
+
+    for (dispatched = 0U; dispatched < SYS_SCHED_DISPATCH_MAX; dispatched++)
+    {
+        processorStatus = __get_PRIMASK();
+        __disable_irq();
+
+        if (sysSchedObj.readyMask == 0U)
+        {
+            __set_PRIMASK(processorStatus);
+            break;
+        }
+
+        priority = SYS_SCHED_HighestReadyGet(sysSchedObj.readyMask);
+        queue = &sysSchedObj.ready[priority];
+
+        task = queue->head;
+        queue->head = task->next;
+        if (queue->head == NULL)
+        {
+            sysSchedObj.readyMask &= ~(1UL << priority);
+        }
+
+        /* Events signaled from here on queue the task again */
+        events = task->events;
+        task->events = 0U;
+        task->isReady = false;
+
+        __set_PRIMASK(processorStatus);
+
+        sysSchedObj.running = task;
+        SYS_PROF_MEASURE(&task->profile, task->function(events, task->context));
+        sysSchedObj.running = NULL;
+    }
+}
+
+bool SYS_SCHED_TaskCreate( SYS_SCHED_TASK *task, const char *name,
+                           uint8_t priority, SYS_SCHED_TASK_FUNCTION function,
+                           uintptr_t context )
+{
+    if ((task == NULL) || (function == NULL) || (priority >= SYS_SCHED_PRIORITY_LEVELS))
+    {
+        return false;
+    }
+
+    task->next = NULL;
+    task->function = function;
+    task->context = context;
+    task->events = 0U;
+    task->priority = priority;
+    task->isReady = false;
+    task->waitQueue = NULL;
+    task->waitNext = NULL;
+
+#if defined(SYS_PROF_ENABLE)
+    task->profile = (SYS_PROF_OBJECT)SYS_PROF_OBJECT_INIT(name);
+#else
+    (void)name;
+#endif
+
+    return true;
+}
+
+void SYS_SCHED_EventSignal( SYS_SCHED_TASK *task, uint32_t events )
+{
+    uint32_t processorStatus;
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    task->events |= events;
+    if (task->isReady == false)
+    {
+        SYS_SCHED_Enqueue(task);
+    }
+
+    __set_PRIMASK(processorStatus);
+}
+
+bool SYS_SCHED_TimerStart( SYS_SCHED_TASK *task, uint32_t delayMs,
+                           uint32_t periodMs )
+{
+    return SYS_TMR_Start(&task->timer, delayMs, periodMs,
+                         SYS_SCHED_TimerHandler, (uintptr_t)task);
+}
+
+bool SYS_SCHED_TimerStop( SYS_SCHED_TASK *task )
+{
+    return SYS_TMR_Stop(&task->timer);
+}
+
+void SYS_SCHED_WaitQueueInitialize( SYS_SCHED_WAIT_QUEUE *queue )
+{
+    queue->head = NULL;
+}
+
+void SYS_SCHED_WaitQueueAdd( SYS_SCHED_WAIT_QUEUE *queue, SYS_SCHED_TASK *task )
+{
+    uint32_t processorStatus;
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    if (task->waitQueue != queue)
+    {
+        if (task->waitQueue != NULL)
+        {
+            SYS_SCHED_WaitUnlink(task);
+        }
+
+        task->waitNext = queue->head;
+        queue->head = task;
+        task->waitQueue = queue;
+    }
+
+    __set_PRIMASK(processorStatus);
+}
+
+void SYS_SCHED_WaitQueueRemove( SYS_SCHED_TASK *task )
+{
+    uint32_t processorStatus;
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    if (task->waitQueue != NULL)
+    {
+        SYS_SCHED_WaitUnlink(task);
+    }
+
+    __set_PRIMASK(processorStatus);
+}
+
+void SYS_SCHED_WaitQueueWake( SYS_SCHED_WAIT_QUEUE *queue )
+{
+    uint32_t processorStatus;
+    SYS_SCHED_TASK *task;
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    for (task = queue->head; task != NULL; task = task->waitNext)
+    {
+        task->events |= SYS_SCHED_EVENT_WAIT;
+        if (task->isReady == false)
+        {
+            SYS_SCHED_Enqueue(task);
+        }
+    }
+
+    __set_PRIMASK(processorStatus);
+}
+
+bool SYS_SCHED_IsIdle( void )
+{
+    return (sysSchedObj.readyMask == 0U);
+}
+
+SYS_SCHED_TASK *SYS_SCHED_TaskRunningGet( void )
+{
+    return sysSchedObj.running;
+}
@@ -0,0 +1,605 @@
+/*******************************************************************************
+  Scheduler System Service Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_sched.h
+
+  Summary
+    Cooperative priority scheduler with event-driven wake-up.
+
+  Description
+    This file defines the interface to the scheduler system service. Tasks
+    are registered once with a priority and a function. A task runs only
+    after it was signaled with events, from an interrupt, a SYS_TMR timer
+    or another task, and SYS_SCHED_Tasks always runs the highest priority
+    ready task first.
+
+  Remarks:
+    Tasks are cooperative: each call of the task function must return
+    without waiting.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_SCHED_H    // Guards against multiple inclusion
+#define SYS_SCHED_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+#include "system/tmr/sys_tmr.h"
+#include "system/prof/sys_prof.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* Priority levels; 0 is the highest priority */
+#define SYS_SCHED_PRIORITY_LEVELS   (32U)
+
+/* Event signaled by the task timer, see SYS_SCHED_TimerStart */
+#define SYS_SCHED_EVENT_TIMER       (0x80000000UL)
+
+/* Event signaled to the tasks of a wait queue, see SYS_SCHED_WaitQueueWake */
+#define SYS_SCHED_EVENT_WAIT        (0x40000000UL)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Task Function
+
+   Summary:
+    Runs one step of a task.
+
+   Description:
+    The function is called from SYS_SCHED_Tasks with the events signaled
+    since its previous call. It must return without waiting; further work
+    is requested by signaling the task again or by starting its timer.
+
+   Remarks:
+    None.
+*/
+
+typedef void (*SYS_SCHED_TASK_FUNCTION)( uint32_t events, uintptr_t context );
+
+// *****************************************************************************
+/* Wait Queue
+
+   Summary:
+    Tasks waiting for a resource.
+
+   Description:
+    Holds the tasks waiting for a resource such as a semaphore, so that the
+    owner of the resource can wake them when it becomes available. A task is
+    on at most one wait queue.
+
+   Remarks:
+    The object must be initialized with SYS_SCHED_WaitQueueInitialize or
+    zeroed before its first use.
+*/
+
+typedef struct SYS_SCHED_WAIT_QUEUE
+{
+    struct SYS_SCHED_TASK       *head;
+
+} SYS_SCHED_WAIT_QUEUE;
+
+// *****************************************************************************
+/* Task Object
+
+   Summary:
+    Storage for one task.
+
+   Description:
+    The caller provides the object and keeps it allocated for the lifetime
+    of the task. The members are private to the service.
+
+   Remarks:
+    None.
+*/
+
+typedef struct SYS_SCHED_TASK
+{
+    /* Next task of the same priority in the ready queue */
+    struct SYS_SCHED_TASK       *next;
+
+    SYS_SCHED_TASK_FUNCTION     function;
+    uintptr_t                   context;
+
+    /* Events signaled since the task last ran */
+    volatile uint32_t           events;
+
+    uint8_t                     priority;
+
+    /* Set while the task is in the ready queue */
+    volatile bool               isReady;
+
+    /* Wait queue the task is on, NULL if none, and the next task on it */
+    SYS_SCHED_WAIT_QUEUE        *waitQueue;
+    struct SYS_SCHED_TASK       *waitNext;
+
+    SYS_TMR_OBJECT              timer;
+
+#if defined(SYS_PROF_ENABLE)
+    /* Durations of the task function calls */
+    SYS_PROF_OBJECT             profile;
+#endif
+
+} SYS_SCHED_TASK;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_SCHED_Initialize( void )
+
+   Summary:
+    Empties the ready queues.
+
+   Description:
+    This function empties the ready queues. Tasks are created afterwards,
+    usually from the initialization of the module that owns them.
+
+   Precondition:
+    None.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    SYS_SCHED_Initialize();
+    </code>
+
+  Remarks:
+    Called from SYS_Initialize before the application initialization.
+*/
+
+void SYS_SCHED_Initialize( void );
+
+// *****************************************************************************
+/* Function:
+    void SYS_SCHED_Tasks( void )
+
+   Summary:
+    Runs the ready tasks in priority order.
+
+   Description:
+    This function repeatedly takes the highest priority ready task and calls
+    its function, until no task is ready or SYS_SCHED_DISPATCH_MAX tasks
+    have run. Tasks of equal priority run in the order they were signaled.
+
+   Precondition:
+    SYS_SCHED_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    while (true)
+    {
+        SYS_SCHED_Tasks();
+    }
+    </code>
+
+  Remarks:
+    Called from SYS_Tasks. The priority is checked again before every task,
+    so a high priority task signaled meanwhile waits for at most one task.
+    The dispatch limit lets the polled services in SYS_Tasks run even when
+    tasks keep signaling each other.
+*/
+
+void SYS_SCHED_Tasks( void );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_SCHED_TaskCreate( SYS_SCHED_TASK *task, const char *name,
+                               uint8_t priority,
+                               SYS_SCHED_TASK_FUNCTION function,
+                               uintptr_t context )
+
+   Summary:
+    Registers a task.
+
+   Description:
+    This function prepares the task object. The task does not run until it
+    is signaled.
+
+   Precondition:
+    SYS_SCHED_Initialize must have been called.
+
+   Parameters:
+    task     - Task object.
+    name     - Name of the task in the SYS_PROF statistics.
+    priority - 0 (highest) to SYS_SCHED_PRIORITY_LEVELS - 1.
+    function - Function called when the task runs.
+    context  - Value passed to the function.
+
+   Returns:
+    true if the task was registered, false if an argument is invalid.
+
+  Example:
+    <code>
+    static SYS_SCHED_TASK appTask;
+
+    SYS_SCHED_TaskCreate(&appTask, "APP", 4U, APP_Tasks, 0U);
+    SYS_SCHED_EventSignal(&appTask, APP_EVENT_START);
+    </code>
+
+  Remarks:
+    A task is never deleted.
+*/
+
+bool SYS_SCHED_TaskCreate( SYS_SCHED_TASK *task, const char *name,
+                           uint8_t priority, SYS_SCHED_TASK_FUNCTION function,
+                           uintptr_t context );
+
+// *****************************************************************************
+/* Function:
+    void SYS_SCHED_EventSignal( SYS_SCHED_TASK *task, uint32_t events )
+
+   Summary:
+    Signals events to a task and makes it ready.
+
+   Description:
+    This function adds events to the task's pending events and queues the
+    task if it is not ready already. The events are passed to the next call
+    of the task function, merged with any others signaled before it runs.
+
+   Precondition:
+    SYS_SCHED_TaskCreate must have been called for the task.
+
+   Parameters:
+    task   - Task to wake.
+    events - Event bits; SYS_SCHED_EVENT_TIMER and SYS_SCHED_EVENT_WAIT
+             are reserved. 0 wakes the task without an event.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    void APP_RxHandler( uintptr_t context )
+    {
+        SYS_SCHED_EventSignal(&appTask, APP_EVENT_RX);
+    }
+    </code>
+
+  Remarks:
+    Can be called from interrupts and from the task itself.
+*/
+
+void SYS_SCHED_EventSignal( SYS_SCHED_TASK *task, uint32_t events );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_SCHED_TimerStart( SYS_SCHED_TASK *task, uint32_t delayMs,
+                               uint32_t periodMs )
+
+   Summary:
+    Wakes a task after a delay.
+
+   Description:
+    This function starts the task's SYS_TMR timer, which signals
+    SYS_SCHED_EVENT_TIMER to the task delayMs from now, and then every
+    periodMs if periodMs is not zero. A running timer is restarted.
+
+   Precondition:
+    SYS_SCHED_TaskCreate must have been called for the task.
+
+   Parameters:
+    task     - Task to wake.
+    delayMs  - Time to the first event.
+    periodMs - Reload time, or 0 for a single event.
+
+   Returns:
+    true if the timer was started, false if an argument is invalid.
+
+  Example:
+    <code>
+    SYS_SCHED_TimerStart(&appTask, 100U, 100U);
+    </code>
+
+  Remarks:
+    The timing rules of SYS_TMR_Start apply.
+*/
+
+bool SYS_SCHED_TimerStart( SYS_SCHED_TASK *task, uint32_t delayMs,
+                           uint32_t periodMs );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_SCHED_TimerStop( SYS_SCHED_TASK *task )
+
+   Summary:
+    Stops the task timer.
+
+   Description:
+    This function stops the task's timer. A timer event already signaled
+    stays pending.
+
+   Precondition:
+    SYS_SCHED_TaskCreate must have been called for the task.
+
+   Parameters:
+    task - Task whose timer is stopped.
+
+   Returns:
+    true if the timer was running.
+
+  Example:
+    <code>
+    SYS_SCHED_TimerStop(&appTask);
+    </code>
+
+  Remarks:
+    None.
+*/
+
+bool SYS_SCHED_TimerStop( SYS_SCHED_TASK *task );
+
+// *****************************************************************************
+/* Function:
+    void SYS_SCHED_WaitQueueInitialize( SYS_SCHED_WAIT_QUEUE *queue )
+
+   Summary:
+    Empties a wait queue.
+
+   Description:
+    This function prepares an empty wait queue.
+
+   Precondition:
+    None.
+
+   Parameters:
+    queue - Wait queue.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    SYS_SCHED_WaitQueueInitialize(&appBuffer.waiters);
+    </code>
+
+  Remarks:
+    Tasks still on the queue are not removed from it.
+*/
+
+void SYS_SCHED_WaitQueueInitialize( SYS_SCHED_WAIT_QUEUE *queue );
+
+// *****************************************************************************
+/* Function:
+    void SYS_SCHED_WaitQueueAdd( SYS_SCHED_WAIT_QUEUE *queue,
+                                 SYS_SCHED_TASK *task )
+
+   Summary:
+    Puts a task on a wait queue.
+
+   Description:
+    This function adds the task to the queue, moving it from any other wait
+    queue. A task already on the queue stays where it is.
+
+   Precondition:
+    SYS_SCHED_TaskCreate must have been called for the task.
+
+   Parameters:
+    queue - Wait queue.
+    task  - Task that waits.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    if (appBuffer.isFree == false)
+    {
+        SYS_SCHED_WaitQueueAdd(&appBuffer.waiters, &appTask);
+    }
+    </code>
+
+  Remarks:
+    Can be called from interrupts.
+*/
+
+void SYS_SCHED_WaitQueueAdd( SYS_SCHED_WAIT_QUEUE *queue, SYS_SCHED_TASK *task );
+
+// *****************************************************************************
+/* Function:
+    void SYS_SCHED_WaitQueueRemove( SYS_SCHED_TASK *task )
+
+   Summary:
+    Takes a task off its wait queue.
+
+   Description:
+    This function removes the task from the wait queue it is on, if any.
+
+   Precondition:
+    SYS_SCHED_TaskCreate must have been called for the task.
+
+   Parameters:
+    task - Task that no longer waits.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    SYS_SCHED_WaitQueueRemove(&appTask);
+    </code>
+
+  Remarks:
+    Can be called from interrupts.
+*/
+
+void SYS_SCHED_WaitQueueRemove( SYS_SCHED_TASK *task );
+
+// *****************************************************************************
+/* Function:
+    void SYS_SCHED_WaitQueueWake( SYS_SCHED_WAIT_QUEUE *queue )
+
+   Summary:
+    Signals every task on a wait queue.
+
+   Description:
+    This function signals SYS_SCHED_EVENT_WAIT to every task on the queue.
+    The tasks stay on the queue: each retries when it runs, the highest
+    priority first, and the ones that find the resource taken keep waiting.
+
+   Precondition:
+    SYS_SCHED_WaitQueueInitialize must have been called.
+
+   Parameters:
+    queue - Wait queue.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    appBuffer.isFree = true;
+    SYS_SCHED_WaitQueueWake(&appBuffer.waiters);
+    </code>
+
+  Remarks:
+    Can be called from interrupts. Takes time in proportion to the number
+    of waiting tasks.
+*/
+
+void SYS_SCHED_WaitQueueWake( SYS_SCHED_WAIT_QUEUE *queue );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_SCHED_IsIdle( void )
+
+   Summary:
+    Reports whether no task is ready.
+
+   Description:
+    This function returns true when the ready queues are empty, so nothing
+    runs until an interrupt or a timer signals a task.
+
+   Precondition:
+    SYS_SCHED_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    true if no task is ready.
+
+  Example:
+    <code>
+    if (SYS_SCHED_IsIdle())
+    {
+    }
+    </code>
+
+  Remarks:
+    Used by the idle sleep of SYS_PM.
+*/
+
+bool SYS_SCHED_IsIdle( void );
+
+// *****************************************************************************
+/* Function:
+    SYS_SCHED_TASK *SYS_SCHED_TaskRunningGet( void )
+
+   Summary:
+    Returns the task whose function is running.
+
+   Description:
+    This function returns the task that SYS_SCHED_Tasks is currently running,
+    or NULL outside of a task function.
+
+   Precondition:
+    SYS_SCHED_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    The running task, or NULL.
+
+  Example:
+    <code>
+    if (SYS_SCHED_TaskRunningGet() != NULL)
+    {
+    }
+    </code>
+
+  Remarks:
+    Lets blocking calls refuse to wait from a task, since no other task runs
+    until it returns.
+*/
+
+SYS_SCHED_TASK *SYS_SCHED_TaskRunningGet( void );
+
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_SCHED_H
@@ -0,0 +1,352 @@
+/*******************************************************************************
+  Time System Service Implementation File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_time.c
+
+  Summary
+    64-bit monotonic timebase implementation.
+
+  Description
+    The SysTick interrupt adds one period to a 64-bit cycle count every time
+    the counter reloads. SYS_TIME_Now adds the cycles counted since then. The
+    reader checks the low word of the count before and after sampling the
+    counter and retries when the interrupt ran in between; a reload that is
+    still pending is detected through ICSR.PENDSTSET.
+
+    While SysTick is paused for sleep, the caller measures the time with
+    another clock. On resume the first reload is set for the rest of the tick
+    under way, so ticks stay aligned with the cycle count.
+
+    The count keeps the unit of the CPU clock at initialization when
+    CLOCK_FrequencySet divides GCLK0: every SysTick count then adds the
+    divider, and the reload shrinks so that a tick keeps its length.
+
+  Remarks:
+    None.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "device.h"
+#include "peripheral/clock/plib_clock.h"
+#include "peripheral/systick/plib_systick.h"
+#include "system/time/sys_time.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    /* Cycles up to the last reload, written only by the SysTick interrupt */
+    volatile uint32_t   cycleLow;
+
+    volatile uint32_t   cycleHigh;
+
+    /* Number of reloads */
+    volatile uint32_t   tickLow;
+
+    volatile uint32_t   tickHigh;
+
+    /* Counts per reload, SysTick LOAD + 1 */
+    uint32_t            period;
+
+    /* Length of the reload under way, shorter than period after a resume */
+    volatile uint32_t   segment;
+
+    /* Counts from the last tick to the pause */
+    uint32_t            phase;
+
+    /* Cycles per SysTick count, the GCLK0 divider */
+    uint32_t            scale;
+
+    /* Cycles per tick and per second, fixed at initialization */
+    uint32_t            tickCycles;
+
+    uint32_t            frequency;
+
+} SYS_TIME_OBJECT;
+
+static SYS_TIME_OBJECT sysTimeObj;
+
+/* Shortest reload programmed on resume. A shorter rest of the tick is joined
+ * with the following tick. */
+#define SYS_TIME_SEGMENT_MIN    (64U)
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Called from the SysTick interrupt or with interrupts masked */
+static void SYS_TIME_Advance( uint32_t cycles, uint32_t ticks )
+{
+    uint32_t cycleLow = sysTimeObj.cycleLow + cycles;
+    uint32_t tickLow = sysTimeObj.tickLow + ticks;
+
+    if (cycleLow < cycles)
+    {
+        sysTimeObj.cycleHigh++;
+    }
+    if (tickLow < ticks)
+    {
+        sysTimeObj.tickHigh++;
+    }
+
+    /* Readers compare the low words, so they are written last */
+    sysTimeObj.tickLow = tickLow;
+    sysTimeObj.cycleLow = cycleLow;
+}
+
+static void SYS_TIME_TickHandler( uintptr_t context )
+{
+    (void)context;
+
+    SYS_TIME_Advance(sysTimeObj.segment * sysTimeObj.scale, 1U);
+
+    /* The counter reloaded with the full period already */
+    sysTimeObj.segment = sysTimeObj.period;
+}
+
+/* Restarts the paused SysTick with a first reload of remaining counts */
+static void SYS_TIME_SegmentStart( uint32_t remaining )
+{
+    uint32_t period = sysTimeObj.period;
+
+    if (remaining < SYS_TIME_SEGMENT_MIN)
+    {
+        /* Count the tick now; the next reload covers it and a full period */
+        SYS_TIME_Advance(0U, 1U);
+        remaining += period;
+    }
+
+    sysTimeObj.segment = remaining;
+
+    SysTick->LOAD = remaining - 1U;
+    SysTick->VAL = 0U;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+    while (SysTick->VAL == 0U)
+    {
+        /* Wait until the shortened reload is in the counter */
+    }
+
+    SysTick->LOAD = period - 1U;
+}
+
+/* Called by CLOCK_FrequencySet with interrupts masked */
+static bool SYS_TIME_ClockHandler( CLOCK_EVENT event, uint32_t frequency, uintptr_t context )
+{
+    uint32_t scale = sysTimeObj.frequency / frequency;
+    uint32_t remaining;
+
+    (void)context;
+
+    if (event == CLOCK_EVENT_CHANGE_PENDING)
+    {
+        /* A tick must stay a whole number of counts of the new clock */
+        return (((sysTimeObj.frequency % frequency) == 0U) &&
+                ((sysTimeObj.tickCycles % scale) == 0U));
+    }
+
+    /* The counts since SysTick switched clocks are taken at the old scale,
+     * a few cycles per change */
+    remaining = SYS_TIME_Pause();
+    SYS_TIME_Advance(sysTimeObj.phase * sysTimeObj.scale, 0U);
+
+    sysTimeObj.scale = scale;
+    sysTimeObj.period = sysTimeObj.tickCycles / scale;
+
+    SYS_TIME_SegmentStart(remaining / scale);
+
+    return true;
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_TIME_Initialize( void )
+{
+    SYSTICK_TimerStop();
+
+    sysTimeObj.cycleLow = 0U;
+    sysTimeObj.cycleHigh = 0U;
+    sysTimeObj.tickLow = 0U;
+    sysTimeObj.tickHigh = 0U;
+    sysTimeObj.period = SYSTICK_TimerPeriodGet() + 1U;
+    sysTimeObj.segment = sysTimeObj.period;
+    sysTimeObj.scale = 1U;
+    sysTimeObj.tickCycles = sysTimeObj.period;
+    sysTimeObj.frequency = SYSTICK_TimerFrequencyGet();
+
+    SYSTICK_TimerCallbackSet(SYS_TIME_TickHandler, 0U);
+    (void)CLOCK_CallbackRegister(SYS_TIME_ClockHandler, 0U);
+
+    SYSTICK_TimerStart();
+}
+
+uint64_t SYS_TIME_Now( void )
+{
+    uint32_t cycleLow;
+    uint32_t cycleHigh;
+    uint32_t segment;
+    uint32_t count;
+    uint32_t elapsed;
+    bool isReloadPending;
+
+    do
+    {
+        cycleLow = sysTimeObj.cycleLow;
+        cycleHigh = sysTimeObj.cycleHigh;
+        segment = sysTimeObj.segment;
+        count = SysTick->VAL;
+
+        /* A reload the interrupt has not counted yet, because interrupts
+         * are masked or this is a handler of the same priority. The counter
+         * is sampled again in case it reloaded just after the first read. */
+        isReloadPending = ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0U);
+        if (isReloadPending)
+        {
+            count = SysTick->VAL;
+        }
+    } while (cycleLow != sysTimeObj.cycleLow);
+
+    /* The counter runs LOAD down to 0 and the reload is counted at 0. A
+     * pending reload ends the segment; the counter then runs a full period. */
+    if (isReloadPending)
+    {
+        elapsed = segment + ((count == 0U) ? 0U : (sysTimeObj.period - count));
+    }
+    else
+    {
+        elapsed = (count == 0U) ? 0U : (segment - count);
+    }
+
+    return ((((uint64_t)cycleHigh) << 32) | cycleLow) + ((uint64_t)elapsed * sysTimeObj.scale);
+}
+
+uint32_t SYS_TIME_Pause( void )
+{
+    uint32_t count;
+
+    SYSTICK_TimerStop();
+
+    count = SysTick->VAL;
+
+    if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0U)
+    {
+        /* Count the reload here; the interrupt must not run for it */
+        SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+        SYS_TIME_TickHandler(0U);
+    }
+
+    sysTimeObj.phase = (count == 0U) ? 0U : (sysTimeObj.segment - count);
+
+    return (sysTimeObj.segment - sysTimeObj.phase) * sysTimeObj.scale;
+}
+
+void SYS_TIME_Resume( uint32_t cycles )
+{
+    uint32_t period = sysTimeObj.period;
+    uint32_t scale = sysTimeObj.scale;
+    uint32_t position = sysTimeObj.phase + (cycles / scale);
+    uint32_t remaining;
+    uint32_t ticks;
+
+    /* Fold in the ticks that passed while paused */
+    if (position >= sysTimeObj.segment)
+    {
+        position -= sysTimeObj.segment;
+        ticks = position / period;
+        position -= ticks * period;
+
+        SYS_TIME_Advance((sysTimeObj.segment + (ticks * period)) * scale, ticks + 1U);
+
+        remaining = period - position;
+    }
+    else
+    {
+        remaining = sysTimeObj.segment - position;
+    }
+
+    /* The new segment starts here */
+    SYS_TIME_Advance(position * scale, 0U);
+
+    SYS_TIME_SegmentStart(remaining);
+}
+
+uint64_t SYS_TIME_TickGet( void )
+{
+    uint32_t tickLow;
+    uint32_t tickHigh;
+
+    do
+    {
+        tickLow = sysTimeObj.tickLow;
+        tickHigh = sysTimeObj.tickHigh;
+    } while (tickLow != sysTimeObj.tickLow);
+
+    return (((uint64_t)tickHigh) << 32) | tickLow;
+}
+
+uint32_t SYS_TIME_TickPeriodGet( void )
+{
+    return sysTimeObj.tickCycles;
+}
+
+uint32_t SYS_TIME_FrequencyGet( void )
+{
+    return sysTimeObj.frequency;
+}
+
+uint64_t SYS_TIME_CyclesToUS( uint64_t cycles )
+{
+    return cycles / (sysTimeObj.frequency / 1000000U);
+}
+
+uint64_t SYS_TIME_USToCycles( uint32_t us )
+{
+    return (uint64_t)us * (sysTimeObj.frequency / 1000000U);
+}
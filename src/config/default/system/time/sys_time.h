@@ -0,0 +1,391 @@
+/*******************************************************************************
+  Time System Service Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_time.h
+
+  Summary
+    64-bit monotonic timebase over the SysTick timer.
+
+  Description
+    This file defines the interface to the time system service. The SysTick
+    interrupt extends the 24-bit SysTick down counter to a 64-bit count of
+    CPU cycles that does not wrap in the life of the device. Reading it takes
+    no lock: the reader retries if a SysTick interrupt ran while it sampled
+    the counter.
+
+  Remarks:
+    The service owns SysTick. SYSTICK_DelayMs and SYSTICK_DelayUs keep
+    working since they only read the counter, but the period must not be
+    changed while the service runs, except through SYS_TIME_Pause and
+    SYS_TIME_Resume.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_TIME_H    // Guards against multiple inclusion
+#define SYS_TIME_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_TIME_Initialize( void )
+
+   Summary:
+    Clears the timebase and starts SysTick.
+
+   Description:
+    This function registers the service with the SysTick PLIB callback and
+    starts the counter with the period set by SYSTICK_TimerInitialize. The
+    time starts at zero.
+
+   Precondition:
+    SYSTICK_TimerInitialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    SYS_TIME_Initialize();
+    </code>
+
+  Remarks:
+    SysTick should have the highest interrupt priority (SYSTICK_INT_PRIORITY)
+    so that a reader can never preempt the tick update.
+
+    The service follows GCLK0 changes through CLOCK_CallbackRegister. It
+    refuses a divider that does not divide the tick into whole SysTick
+    counts; with the 1 ms tick that leaves 1, 2, 3, 4, 5, 6, 8, 10, 12, ...
+*/
+
+void SYS_TIME_Initialize( void );
+
+// *****************************************************************************
+/* Function:
+    uint64_t SYS_TIME_Now( void )
+
+   Summary:
+    Returns the time in CPU cycles since SYS_TIME_Initialize.
+
+   Description:
+    This function combines the count kept by the SysTick interrupt with the
+    current SysTick counter value. It can be called from any context,
+    including interrupts and critical sections.
+
+   Precondition:
+    SYS_TIME_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    Monotonic time in CPU cycles (SYS_TIME_FrequencyGet per second).
+
+  Example:
+    <code>
+    uint64_t start = SYS_TIME_Now();
+
+    APP_Work();
+
+    uint32_t cycles = (uint32_t)(SYS_TIME_Now() - start);
+    </code>
+
+  Remarks:
+    A pending SysTick interrupt is accounted for, so interrupts may be
+    disabled for up to one SysTick period. A longer critical section loses
+    whole periods. Differences below 2^32 cycles (~89 s) can be taken on the
+    low 32 bits alone.
+*/
+
+uint64_t SYS_TIME_Now( void );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_TIME_Pause( void )
+
+   Summary:
+    Stops SysTick before the CPU sleeps.
+
+   Description:
+    This function stops SysTick, accounts for a reload that is pending and
+    keeps the position within the current tick for SYS_TIME_Resume.
+
+   Precondition:
+    SYS_TIME_Initialize must have been called. Interrupts must be masked
+    until SYS_TIME_Resume returns.
+
+   Parameters:
+    None.
+
+   Returns:
+    Cycles left until the next tick.
+
+  Example:
+    <code>
+    uint32_t toNextTick = SYS_TIME_Pause();
+    </code>
+
+  Remarks:
+    SysTick does not count while the CPU clock domain is stopped, so the
+    sleeper has to measure the time spent with a peripheral timer and pass it
+    to SYS_TIME_Resume. SYS_TIME_Now must not be used in between.
+*/
+
+uint32_t SYS_TIME_Pause( void );
+
+// *****************************************************************************
+/* Function:
+    void SYS_TIME_Resume( uint32_t cycles )
+
+   Summary:
+    Restarts SysTick after a sleep.
+
+   Description:
+    This function adds the cycles spent paused to the time and the tick
+    count, and restarts SysTick with a first reload that ends on the next
+    tick boundary.
+
+   Precondition:
+    SYS_TIME_Pause must have been called. Interrupts must still be masked.
+
+   Parameters:
+    cycles - CPU cycles measured since SYS_TIME_Pause, below 2^31.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    SYS_TIME_Resume(slept);
+    </code>
+
+  Remarks:
+    The cycles between the last clock reads and the SysTick stop or start
+    are lost, a few tens per pause.
+*/
+
+void SYS_TIME_Resume( uint32_t cycles );
+
+// *****************************************************************************
+/* Function:
+    uint64_t SYS_TIME_TickGet( void )
+
+   Summary:
+    Returns the number of SysTick periods since SYS_TIME_Initialize.
+
+   Description:
+    This function returns the 64-bit count of SysTick interrupts. It is
+    cheaper than SYS_TIME_Now when the period resolution is enough.
+
+   Precondition:
+    SYS_TIME_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    Number of elapsed SysTick periods.
+
+  Example:
+    <code>
+    uint64_t ticks = SYS_TIME_TickGet();
+    </code>
+
+  Remarks:
+    The period is SYS_TIME_TickPeriodGet cycles, 1 ms with the default
+    SysTick configuration.
+*/
+
+uint64_t SYS_TIME_TickGet( void );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_TIME_TickPeriodGet( void )
+
+   Summary:
+    Returns the SysTick period in CPU cycles.
+
+   Description:
+    This function returns the number of cycles between two SysTick
+    interrupts.
+
+   Precondition:
+    SYS_TIME_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    Cycles per tick.
+
+  Example:
+    <code>
+    uint32_t period = SYS_TIME_TickPeriodGet();
+    </code>
+
+  Remarks:
+    None.
+*/
+
+uint32_t SYS_TIME_TickPeriodGet( void );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_TIME_FrequencyGet( void )
+
+   Summary:
+    Returns the frequency of the SYS_TIME_Now count.
+
+   Description:
+    This function returns the CPU clock frequency at SYS_TIME_Initialize in
+    Hz. The count keeps this unit when CLOCK_FrequencySet divides GCLK0
+    later.
+
+   Precondition:
+    SYS_TIME_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    Cycles per second.
+
+  Example:
+    <code>
+    uint32_t frequency = SYS_TIME_FrequencyGet();
+    </code>
+
+  Remarks:
+    None.
+*/
+
+uint32_t SYS_TIME_FrequencyGet( void );
+
+// *****************************************************************************
+/* Function:
+    uint64_t SYS_TIME_CyclesToUS( uint64_t cycles )
+
+   Summary:
+    Converts a cycle count to microseconds.
+
+   Description:
+    This function converts a cycle count or difference from SYS_TIME_Now to
+    microseconds, rounding down.
+
+   Precondition:
+    SYS_TIME_Initialize must have been called.
+
+   Parameters:
+    cycles - Cycle count.
+
+   Returns:
+    Microseconds.
+
+  Example:
+    <code>
+    uint64_t us = SYS_TIME_CyclesToUS(SYS_TIME_Now() - start);
+    </code>
+
+  Remarks:
+    Uses a 64-bit division. Keep it out of hot paths and convert only for
+    display or when comparing with external time.
+*/
+
+uint64_t SYS_TIME_CyclesToUS( uint64_t cycles );
+
+// *****************************************************************************
+/* Function:
+    uint64_t SYS_TIME_USToCycles( uint32_t us )
+
+   Summary:
+    Converts microseconds to a cycle count.
+
+   Description:
+    This function converts a duration in microseconds to the number of
+    SYS_TIME_Now cycles, for deadlines and timeouts.
+
+   Precondition:
+    SYS_TIME_Initialize must have been called.
+
+   Parameters:
+    us - Duration in microseconds.
+
+   Returns:
+    Cycles.
+
+  Example:
+    <code>
+    uint64_t deadline = SYS_TIME_Now() + SYS_TIME_USToCycles(500U);
+    </code>
+
+  Remarks:
+    None.
+*/
+
+uint64_t SYS_TIME_USToCycles( uint32_t us );
+
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_TIME_H
@@ -0,0 +1,464 @@
+/*******************************************************************************
+  Timer System Service Implementation File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_tmr.c
+
+  Summary
+    Hierarchical timer wheel implementation.
+
+  Description
+    Level 0 holds the timers due in the next 64 ticks, one slot per tick.
+    Each further level covers 64 times the range of the level below. When
+    the low bits of the wheel tick roll over, the slot of the next level is
+    emptied and its timers are inserted again closer to their expiry
+    ("cascade"). Slots are singly linked lists with a back link to the
+    pointer that holds each timer, so a timer is removed without a search.
+
+    Interrupts are only masked while a single timer is linked or unlinked.
+    Lists being cascaded or expired are first moved to a local head, which
+    SYS_TMR_Stop can still unlink from.
+
+  Remarks:
+    None.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "device.h"
+#include "system/time/sys_time.h"
+#include "system/tmr/sys_tmr.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_TMR_LEVEL_BITS      (6U)
+#define SYS_TMR_LEVEL_SLOTS     (1UL << SYS_TMR_LEVEL_BITS)
+#define SYS_TMR_LEVEL_MASK      (SYS_TMR_LEVEL_SLOTS - 1UL)
+#define SYS_TMR_LEVELS          (4U)
+
+/* Ticks from the wheel position that the top level can hold */
+#define SYS_TMR_WHEEL_RANGE     (1UL << (SYS_TMR_LEVEL_BITS * SYS_TMR_LEVELS))
+
+#define SYS_TMR_TICKS_MAX       (0x7FFFFFFFUL)
+
+typedef struct
+{
+    SYS_TMR_OBJECT      *slot[SYS_TMR_LEVELS][SYS_TMR_LEVEL_SLOTS];
+
+    /* Last tick processed by SYS_TMR_Tasks */
+    uint32_t            current;
+
+    /* Running timers, including those on a local list in SYS_TMR_Tasks */
+    uint32_t            count;
+
+    uint32_t            msPerTick;
+
+} SYS_TMR_WHEEL;
+
+static SYS_TMR_WHEEL sysTmrWheel;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void SYS_TMR_Link( SYS_TMR_OBJECT **head, SYS_TMR_OBJECT *timer )
+{
+    timer->next = *head;
+    if (timer->next != NULL)
+    {
+        timer->next->pprev = &timer->next;
+    }
+    *head = timer;
+    timer->pprev = head;
+}
+
+static void SYS_TMR_Unlink( SYS_TMR_OBJECT *timer )
+{
+    *timer->pprev = timer->next;
+    if (timer->next != NULL)
+    {
+        timer->next->pprev = timer->pprev;
+    }
+    timer->next = NULL;
+    timer->pprev = NULL;
+}
+
+/* Moves a slot list to a local head */
+static void SYS_TMR_Detach( SYS_TMR_OBJECT **slot, SYS_TMR_OBJECT **head )
+{
+    *head = *slot;
+    *slot = NULL;
+    if (*head != NULL)
+    {
+        (*head)->pprev = head;
+    }
+}
+
+/* Called with interrupts masked */
+static void SYS_TMR_Insert( SYS_TMR_OBJECT *timer )
+{
+    uint32_t delta = timer->expiry - sysTmrWheel.current;
+    uint32_t position = timer->expiry;
+    uint32_t level;
+
+    if (delta > SYS_TMR_TICKS_MAX)
+    {
+        /* Already due: the slot of the tick being processed */
+        delta = 0U;
+        position = sysTmrWheel.current;
+    }
+    else if (delta >= SYS_TMR_WHEEL_RANGE)
+    {
+        /* Parked in the top level; cascading will place it again */
+        delta = SYS_TMR_WHEEL_RANGE - 1U;
+        position = sysTmrWheel.current + delta;
+    }
+    else
+    {
+        /* Nothing to adjust */
+    }
+
+    for (level = 0U; level < (SYS_TMR_LEVELS - 1U); level++)
+    {
+        if (delta < (1UL << (SYS_TMR_LEVEL_BITS * (level + 1U))))
+        {
+            break;
+        }
+    }
+
+    SYS_TMR_Link(&sysTmrWheel.slot[level][(position >> (SYS_TMR_LEVEL_BITS * level)) & SYS_TMR_LEVEL_MASK], timer);
+}
+
+static uint32_t SYS_TMR_MSToTicks( uint32_t ms )
+{
+    if (sysTmrWheel.msPerTick == 1U)
+    {
+        return ms;
+    }
+
+    return (ms / sysTmrWheel.msPerTick) + (((ms % sysTmrWheel.msPerTick) != 0U) ? 1U : 0U);
+}
+
+/* Advances the wheel by one tick and returns the timers that expire on it */
+static SYS_TMR_OBJECT *SYS_TMR_Advance( SYS_TMR_OBJECT **expired )
+{
+    SYS_TMR_OBJECT *cascade[SYS_TMR_LEVELS];
+    SYS_TMR_OBJECT *timer;
+    uint32_t processorStatus;
+    uint32_t level;
+    uint32_t levels = 1U;
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    sysTmrWheel.current++;
+
+    for (level = 1U; level < SYS_TMR_LEVELS; level++)
+    {
+        uint32_t shift = SYS_TMR_LEVEL_BITS * level;
+
+        if ((sysTmrWheel.current & ((1UL << shift) - 1U)) != 0U)
+        {
+            break;
+        }
+        SYS_TMR_Detach(&sysTmrWheel.slot[level][(sysTmrWheel.current >> shift) & SYS_TMR_LEVEL_MASK], &cascade[level]);
+        levels++;
+    }
+
+    __set_PRIMASK(processorStatus);
+
+    for (level = 1U; level < levels; level++)
+    {
+        do
+        {
+            processorStatus = __get_PRIMASK();
+            __disable_irq();
+
+            timer = cascade[level];
+            if (timer != NULL)
+            {
+                SYS_TMR_Unlink(timer);
+                SYS_TMR_Insert(timer);
+            }
+
+            __set_PRIMASK(processorStatus);
+        } while (timer != NULL);
+    }
+
+    /* Cascading may have added timers due on this tick, so level 0 last */
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    SYS_TMR_Detach(&sysTmrWheel.slot[0][sysTmrWheel.current & SYS_TMR_LEVEL_MASK], expired);
+
+    __set_PRIMASK(processorStatus);
+
+    return *expired;
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_TMR_Initialize( void )
+{
+    uint32_t level;
+    uint32_t index;
+
+    for (level = 0U; level < SYS_TMR_LEVELS; level++)
+    {
+        for (index = 0U; index < SYS_TMR_LEVEL_SLOTS; index++)
+        {
+            sysTmrWheel.slot[level][index] = NULL;
+        }
+    }
+
+    sysTmrWheel.current = (uint32_t)SYS_TIME_TickGet();
+    sysTmrWheel.count = 0U;
+    sysTmrWheel.msPerTick = (uint32_t)(SYS_TIME_CyclesToUS(SYS_TIME_TickPeriodGet()) / 1000U);
+    if (sysTmrWheel.msPerTick == 0U)
+    {
+        sysTmrWheel.msPerTick = 1U;
+    }
+}
+
+void SYS_TMR_Tasks( void )
+{
+    uint32_t now = (uint32_t)SYS_TIME_TickGet();
+    SYS_TMR_OBJECT *expired;
+    SYS_TMR_OBJECT *timer;
+    SYS_TMR_CALLBACK callback;
+    uintptr_t context;
+    uint32_t processorStatus;
+    bool isPending = true;
+
+    while (isPending)
+    {
+        processorStatus = __get_PRIMASK();
+        __disable_irq();
+
+        /* Nothing to expire: jump instead of stepping through idle ticks */
+        if ((sysTmrWheel.count == 0U) && ((int32_t)(now - sysTmrWheel.current) > 0))
+        {
+            sysTmrWheel.current = now;
+        }
+        isPending = ((int32_t)(now - sysTmrWheel.current) > 0);
+
+        __set_PRIMASK(processorStatus);
+
+        if (isPending && (SYS_TMR_Advance(&expired) != NULL))
+        {
+            do
+            {
+                callback = NULL;
+                context = 0U;
+
+                processorStatus = __get_PRIMASK();
+                __disable_irq();
+
+                timer = expired;
+                if (timer != NULL)
+                {
+                    SYS_TMR_Unlink(timer);
+                    callback = timer->callback;
+                    context = timer->context;
+
+                    if (timer->period != 0U)
+                    {
+                        timer->expiry += timer->period;
+                        if ((int32_t)(timer->expiry - sysTmrWheel.current) <= 0)
+                        {
+                            timer->expiry = sysTmrWheel.current + 1U;
+                        }
+                        SYS_TMR_Insert(timer);
+                    }
+                    else
+                    {
+                        sysTmrWheel.count--;
+                    }
+                }
+
+                __set_PRIMASK(processorStatus);
+
+                if (callback != NULL)
+                {
+                    callback(context);
+                }
+            } while (timer != NULL);
+        }
+    }
+}
+
+bool SYS_TMR_Start( SYS_TMR_OBJECT *timer, uint32_t delayMs, uint32_t periodMs,
+                    SYS_TMR_CALLBACK callback, uintptr_t context )
+{
+    uint32_t delay = SYS_TMR_MSToTicks(delayMs);
+    uint32_t period = SYS_TMR_MSToTicks(periodMs);
+    uint32_t now;
+    uint32_t processorStatus;
+
+    if ((timer == NULL) || (callback == NULL) || (delay > SYS_TMR_TICKS_MAX) || (period > SYS_TMR_TICKS_MAX))
+    {
+        return false;
+    }
+
+    /* The tick under way has been processed already */
+    if (delay == 0U)
+    {
+        delay = 1U;
+    }
+
+    now = (uint32_t)SYS_TIME_TickGet();
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    if (timer->pprev != NULL)
+    {
+        SYS_TMR_Unlink(timer);
+        sysTmrWheel.count--;
+    }
+
+    /* An empty wheel may be behind; catch up so the timer is not placed
+     * relative to a stale position */
+    if ((sysTmrWheel.count == 0U) && ((int32_t)(now - sysTmrWheel.current) > 0))
+    {
+        sysTmrWheel.current = now;
+    }
+
+    timer->expiry = now + delay;
+    timer->period = period;
+    timer->callback = callback;
+    timer->context = context;
+
+    SYS_TMR_Insert(timer);
+    sysTmrWheel.count++;
+
+    __set_PRIMASK(processorStatus);
+
+    return true;
+}
+
+bool SYS_TMR_Stop( SYS_TMR_OBJECT *timer )
+{
+    uint32_t processorStatus;
+    bool isActive = false;
+
+    if (timer == NULL)
+    {
+        return false;
+    }
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    if (timer->pprev != NULL)
+    {
+        SYS_TMR_Unlink(timer);
+        sysTmrWheel.count--;
+        isActive = true;
+    }
+
+    __set_PRIMASK(processorStatus);
+
+    return isActive;
+}
+
+bool SYS_TMR_IsActive( const SYS_TMR_OBJECT *timer )
+{
+    return ((timer != NULL) && (timer->pprev != NULL));
+}
+
+bool SYS_TMR_NextExpiryGet( uint32_t *ticks )
+{
+    uint32_t processorStatus;
+    uint32_t level;
+    uint32_t shift;
+    uint32_t index;
+    uint32_t offset;
+    uint32_t delta;
+    uint32_t next = SYS_TMR_WHEEL_RANGE;
+    uint32_t now = (uint32_t)SYS_TIME_TickGet();
+    bool isRunning;
+
+    processorStatus = __get_PRIMASK();
+    __disable_irq();
+
+    isRunning = (sysTmrWheel.count != 0U);
+
+    /* The first non-empty slot of each level: an expiry on level 0, a
+     * cascade on the levels above */
+    for (level = 0U; isRunning && (level < SYS_TMR_LEVELS); level++)
+    {
+        shift = SYS_TMR_LEVEL_BITS * level;
+        index = sysTmrWheel.current >> shift;
+
+        for (offset = 1U; offset <= SYS_TMR_LEVEL_SLOTS; offset++)
+        {
+            if (sysTmrWheel.slot[level][(index + offset) & SYS_TMR_LEVEL_MASK] != NULL)
+            {
+                delta = ((index + offset) << shift) - sysTmrWheel.current;
+                if (delta < next)
+                {
+                    next = delta;
+                }
+                break;
+            }
+        }
+    }
+
+    if (isRunning)
+    {
+        /* Ticks the wheel is behind are due at once */
+        delta = (sysTmrWheel.current + next) - now;
+        *ticks = ((int32_t)delta > 0) ? delta : 0U;
+    }
+
+    __set_PRIMASK(processorStatus);
+
+    return isRunning;
+}
+
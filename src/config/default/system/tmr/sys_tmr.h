@@ -0,0 +1,354 @@
+/*******************************************************************************
+  Timer System Service Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    sys_tmr.h
+
+  Summary
+    Software timers on a hierarchical timer wheel.
+
+  Description
+    This file defines the interface to the timer system service. Timers are
+    kept on a four level wheel of 64 slots per level, indexed by expiry tick,
+    so starting and stopping a timer costs the same whatever the number of
+    running timers. SYS_TMR_Tasks advances the wheel to the SYS_TIME tick and
+    calls the expired timers' callbacks.
+
+  Remarks:
+    The timer objects are owned by the caller, so the number of timers is
+    only limited by memory.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef SYS_TMR_H    // Guards against multiple inclusion
+#define SYS_TMR_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Timer Callback
+
+   Summary:
+    Called when a timer expires.
+
+   Description:
+    The callback runs from SYS_TMR_Tasks, not from an interrupt. It may start
+    or stop any timer, including its own.
+
+   Remarks:
+    None.
+*/
+
+typedef void (*SYS_TMR_CALLBACK)( uintptr_t context );
+
+// *****************************************************************************
+/* Timer Object
+
+   Summary:
+    Storage for one timer.
+
+   Description:
+    The caller provides the object and keeps it allocated while the timer
+    runs. The members are private to the service.
+
+   Remarks:
+    The object must be zeroed before its first use, which static storage
+    already does.
+*/
+
+typedef struct SYS_TMR_OBJECT
+{
+    struct SYS_TMR_OBJECT   *next;
+
+    /* Link that points to this timer, NULL while the timer is stopped */
+    struct SYS_TMR_OBJECT   **pprev;
+
+    /* Tick at which the timer expires */
+    uint32_t                expiry;
+
+    /* Reload in ticks, 0 for a one-shot timer */
+    uint32_t                period;
+
+    SYS_TMR_CALLBACK        callback;
+
+    uintptr_t               context;
+
+} SYS_TMR_OBJECT;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_TMR_Initialize( void )
+
+   Summary:
+    Empties the timer wheel.
+
+   Description:
+    This function empties the timer wheel and synchronizes it with the
+    SYS_TIME tick.
+
+   Precondition:
+    SYS_TIME_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    SYS_TMR_Initialize();
+    </code>
+
+  Remarks:
+    The SysTick period is expected to be a whole number of milliseconds.
+*/
+
+void SYS_TMR_Initialize( void );
+
+// *****************************************************************************
+/* Function:
+    void SYS_TMR_Tasks( void )
+
+   Summary:
+    Advances the timer wheel and calls the callbacks of expired timers.
+
+   Description:
+    This function processes every tick elapsed since its last call, so timers
+    expire in order even when it is called late.
+
+   Precondition:
+    SYS_TMR_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+
+  Example:
+    <code>
+    while (true)
+    {
+        SYS_TMR_Tasks();
+    }
+    </code>
+
+  Remarks:
+    Called from SYS_Tasks.
+*/
+
+void SYS_TMR_Tasks( void );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_TMR_Start( SYS_TMR_OBJECT *timer, uint32_t delayMs,
+                        uint32_t periodMs, SYS_TMR_CALLBACK callback,
+                        uintptr_t context )
+
+   Summary:
+    Starts or restarts a timer.
+
+   Description:
+    This function schedules the timer to expire delayMs from now, and then
+    every periodMs if periodMs is not zero. A running timer is restarted.
+
+   Precondition:
+    SYS_TMR_Initialize must have been called.
+
+   Parameters:
+    timer    - Timer object.
+    delayMs  - Time to the first expiry, rounded up to whole ticks.
+    periodMs - Reload time, or 0 for a one-shot timer.
+    callback - Function called on every expiry.
+    context  - Value passed to the callback.
+
+   Returns:
+    true if the timer was started, false if an argument is invalid.
+
+  Example:
+    <code>
+    static SYS_TMR_OBJECT appTimeout;
+
+    SYS_TMR_Start(&appTimeout, 200U, 0U, APP_TimeoutHandler, 0U);
+    </code>
+
+  Remarks:
+    Can be called from interrupts. Tick resolution applies: the first expiry
+    comes up to one tick early since the current tick is already under way.
+    Delays and periods must be below 2^31 ticks. A periodic timer keeps its
+    phase, but periods missed while SYS_TMR_Tasks was not called are not
+    replayed.
+*/
+
+bool SYS_TMR_Start( SYS_TMR_OBJECT *timer, uint32_t delayMs, uint32_t periodMs,
+                    SYS_TMR_CALLBACK callback, uintptr_t context );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_TMR_Stop( SYS_TMR_OBJECT *timer )
+
+   Summary:
+    Stops a timer.
+
+   Description:
+    This function removes the timer from the wheel. Its callback is not
+    called again unless it is restarted.
+
+   Precondition:
+    SYS_TMR_Initialize must have been called.
+
+   Parameters:
+    timer - Timer object.
+
+   Returns:
+    true if the timer was running.
+
+  Example:
+    <code>
+    SYS_TMR_Stop(&appTimeout);
+    </code>
+
+  Remarks:
+    Can be called from interrupts.
+*/
+
+bool SYS_TMR_Stop( SYS_TMR_OBJECT *timer );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_TMR_IsActive( const SYS_TMR_OBJECT *timer )
+
+   Summary:
+    Returns true while a timer is running.
+
+   Description:
+    A one-shot timer stops when it expires, before its callback is called.
+    A periodic timer runs until it is stopped.
+
+   Precondition:
+    None.
+
+   Parameters:
+    timer - Timer object.
+
+   Returns:
+    true if the timer is running.
+
+  Example:
+    <code>
+    if (!SYS_TMR_IsActive(&appTimeout))
+    {
+    }
+    </code>
+
+  Remarks:
+    None.
+*/
+
+bool SYS_TMR_IsActive( const SYS_TMR_OBJECT *timer );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_TMR_NextExpiryGet( uint32_t *ticks )
+
+   Summary:
+    Returns the number of ticks until SYS_TMR_Tasks has work.
+
+   Description:
+    This function finds the next tick on which a timer expires or a slot of
+    the upper levels has to be cascaded. Nothing expires before it, so the
+    caller can sleep until then.
+
+   Precondition:
+    SYS_TMR_Initialize must have been called.
+
+   Parameters:
+    ticks - Receives the ticks from the current SYS_TIME tick, 0 if a timer
+            is due already.
+
+   Returns:
+    false if no timer is running; ticks is not written.
+
+  Example:
+    <code>
+    uint32_t ticks;
+
+    if (SYS_TMR_NextExpiryGet(&ticks) && (ticks == 0U))
+    {
+    }
+    </code>
+
+  Remarks:
+    Scans at most 64 slots per level. Used by the idle sleep of SYS_PM.
+*/
+
+bool SYS_TMR_NextExpiryGet( uint32_t *ticks );
+
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_TMR_H
@@ -55,6 +55,14 @@
 #include "sys_tasks.h"
 
 
+/* Durations of the polled services and of the busy part of every pass; the
+ * SYS_SCHED tasks are profiled by SYS_SCHED */
+SYS_PROF_DECLARE(sysTasksProfile, "SYS_Tasks");
+SYS_PROF_DECLARE(sysLogProfile, "SYS_LOG");
+SYS_PROF_DECLARE(sysKvProfile, "SYS_KV");
+SYS_PROF_DECLARE(sysTmrProfile, "SYS_TMR");
+
+
 
 
 // *****************************************************************************
@@ -72,8 +80,17 @@
 */
 void SYS_Tasks ( void )
 {
+#if defined(SYS_PROF_ENABLE)
+    uint32_t start = SYS_PROF_TimestampGet();
+#endif
+
     /* Maintain system services */
-    
+    SYS_PROF_MEASURE(&sysLogProfile, SYS_LOG_Tasks());
+
+    SYS_PROF_MEASURE(&sysKvProfile, SYS_KV_Tasks());
+
+    SYS_PROF_MEASURE(&sysTmrProfile, SYS_TMR_Tasks());
+
 
     /* Maintain Device Drivers */
     
@@ -81,13 +98,15 @@ void SYS_Tasks ( void )
     /* Maintain Middleware & Other Libraries */
     
 
-    /* Maintain the application's state machine. */
-        /* Call Application task CORE_APP. */
-    CORE_APP_Tasks();
-
-
+    /* Run the application tasks that were signaled. */
+    SYS_SCHED_Tasks();
 
+#if defined(SYS_PROF_ENABLE)
+    SYS_PROF_Record(&sysTasksProfile, start);
+#endif
 
+    /* Sleep until the next interrupt or timer expiry */
+    SYS_PM_Idle();
 }
 
 /*******************************************************************************
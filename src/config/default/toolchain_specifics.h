@@ -43,6 +43,20 @@ extern "C" {
 #define NO_INIT        __attribute__((section(".no_init")))
 #define SECTION(a)     __attribute__((__section__(a)))
 
+/* Executes the function from SRAM, where fetches have no flash wait states.
+ * XC32 places it in a .ramfunc section that the start-up code copies with the
+ * initialized data, so it costs both flash and RAM; tools/ramfunc_report.py
+ * lists the cost. It is never inlined into flash code and is reached with a
+ * long call. Whatever it calls in flash is fetched with wait states again, so
+ * its callees should be __STATIC_FORCEINLINE or RAMFUNC too; the report
+ * warns about every call that leaves SRAM. Build with RAMFUNC_DISABLE
+ * defined to keep everything in flash. */
+#if defined(__XC32) && !defined(RAMFUNC_DISABLE)
+#define RAMFUNC        __attribute__((ramfunc, long_call, noinline))
+#else
+#define RAMFUNC        __attribute__((noinline))
+#endif
+
 #define CACHE_LINE_SIZE    (4u)
 #define CACHE_ALIGN
 
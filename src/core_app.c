@@ -28,6 +28,7 @@
 // *****************************************************************************
 
 #include "core_app.h"
+#include "benchmark.h"
 
 // *****************************************************************************
 // *****************************************************************************
@@ -68,6 +69,24 @@ CORE_APP_DATA core_appData;
 // *****************************************************************************
 
 
+/* The application as a coroutine: each wait returns to the scheduler and the
+ * next signal of the task resumes it after the wait.
+ */
+static SYS_CORO_STATUS CORE_APP_Run ( SYS_CORO *coro )
+{
+    SYS_CORO_BEGIN(coro);
+
+#ifdef APP_BENCHMARK_ENABLE
+    BENCHMARK_Run();
+#endif
+
+    /* TODO: implement your application as a sequence of waits, e.g.
+     * SYS_CORO_WAIT_UNTIL(coro, (core_appData.events & APP_EVENT_RX) != 0U);
+     */
+
+    SYS_CORO_END(coro);
+}
+
 /* TODO:  Add any necessary local functions.
 */
 
@@ -88,12 +107,17 @@ CORE_APP_DATA core_appData;
 
 void CORE_APP_Initialize ( void )
 {
-    /* Place the App state machine in its initial state. */
-    core_appData.state = CORE_APP_STATE_INIT;
+    /* Place the App coroutine at its start. */
+    SYS_CORO_INIT(&core_appData.coro);
+    core_appData.events = 0U;
 
+    /* Run once to reach the first wait */
+    (void)SYS_SCHED_TaskCreate(&core_appData.task, "CORE_APP", CORE_APP_TASK_PRIORITY,
+                               CORE_APP_Tasks, 0U);
+    SYS_SCHED_EventSignal(&core_appData.task, 0U);
 
 
-    /* TODO: Initialize your application's state machine and other
+    /* TODO: Initialize your application's coroutine and other
      * parameters.
      */
 }
@@ -101,48 +125,18 @@ void CORE_APP_Initialize ( void )
 
 /******************************************************************************
   Function:
-    void CORE_APP_Tasks ( void )
+    void CORE_APP_Tasks ( uint32_t events, uintptr_t context )
 
   Remarks:
     See prototype in core_app.h.
  */
 
-void CORE_APP_Tasks ( void )
+void CORE_APP_Tasks ( uint32_t events, uintptr_t context )
 {
+    /* Keep the events for the coroutine's wait conditions */
+    core_appData.events |= events;
 
-    /* Check the application's current state. */
-    switch ( core_appData.state )
-    {
-        /* Application's initial state. */
-        case CORE_APP_STATE_INIT:
-        {
-            bool appInitialized = true;
-
-
-            if (appInitialized)
-            {
-
-                core_appData.state = CORE_APP_STATE_SERVICE_TASKS;
-            }
-            break;
-        }
-
-        case CORE_APP_STATE_SERVICE_TASKS:
-        {
-
-            break;
-        }
-
-        /* TODO: implement your application state machine.*/
-
-
-        /* The default state should never be executed. */
-        default:
-        {
-            /* TODO: Handle error in application's state machine. */
-            break;
-        }
-    }
+    (void)SYS_CORO_TaskRun(&core_appData.task, CORE_APP_Run(&core_appData.coro));
 }
 
 
@@ -14,7 +14,7 @@
     This header file provides function prototypes and data type definitions for
     the application.  Some of these are required by the system (such as the
     "CORE_APP_Initialize" and "CORE_APP_Tasks" prototypes) and some of them are only used
-    internally by the application (such as the "CORE_APP_STATES" definition).  Both
+    internally by the application (such as the "CORE_APP_DATA" definition).  Both
     are defined here for convenience.
 *******************************************************************************/
 
@@ -32,6 +32,7 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include "configuration.h"
+#include "system/coro/sys_coro.h"
 
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus  // Provide C++ Compatibility
@@ -47,27 +48,6 @@ extern "C" {
 // *****************************************************************************
 // *****************************************************************************
 
-// *****************************************************************************
-/* Application states
-
-  Summary:
-    Application states enumeration
-
-  Description:
-    This enumeration defines the valid application states.  These states
-    determine the behavior of the application at various times.
-*/
-
-typedef enum
-{
-    /* Application's state machine's initial state. */
-    CORE_APP_STATE_INIT=0,
-    CORE_APP_STATE_SERVICE_TASKS,
-    /* TODO: Define states used by the application state machine. */
-
-} CORE_APP_STATES;
-
-
 // *****************************************************************************
 /* Application Data
 
@@ -83,8 +63,15 @@ typedef enum
 
 typedef struct
 {
-    /* The application's current state */
-    CORE_APP_STATES state;
+    /* Where the application coroutine resumes */
+    SYS_CORO coro;
+
+    /* Events signaled to the task, cleared by the coroutine as it handles
+     * them */
+    uint32_t events;
+
+    /* Scheduler task that runs CORE_APP_Tasks */
+    SYS_SCHED_TASK task;
 
     /* TODO: Define any additional data used by the application. */
 
@@ -113,12 +100,12 @@ typedef struct
 
   Description:
     This function initializes the Harmony application.  It places the
-    application in its initial state and prepares it to run so that its
-    CORE_APP_Tasks function can be called.
+    application coroutine at its start and registers CORE_APP_Tasks with the
+    scheduler, signaled once so that the initial state runs.
 
   Precondition:
-    All other system initialization routines should be called before calling
-    this routine (in "SYS_Initialize").
+    All other system initialization routines, SYS_SCHED_Initialize included,
+    should be called before calling this routine (in "SYS_Initialize").
 
   Parameters:
     None.
@@ -140,35 +127,37 @@ void CORE_APP_Initialize ( void );
 
 /*******************************************************************************
   Function:
-    void CORE_APP_Tasks ( void )
+    void CORE_APP_Tasks ( uint32_t events, uintptr_t context )
 
   Summary:
     MPLAB Harmony Demo application tasks function
 
   Description:
     This routine is the Harmony Demo application's tasks function.  It
-    defines the application's state machine and core logic.
+    resumes the application coroutine, which defines the core logic.
 
   Precondition:
     The system and application initialization ("SYS_Initialize") should be
     called before calling this.
 
   Parameters:
-    None.
+    events  - Events signaled to the task since it last ran.
+    context - Unused.
 
   Returns:
     None.
 
   Example:
     <code>
-    CORE_APP_Tasks();
+    SYS_SCHED_EventSignal(&core_appData.task, 0U);
     </code>
 
   Remarks:
-    This routine must be called from SYS_Tasks() routine.
+    This routine is run by SYS_SCHED_Tasks when the task was signaled; it is
+    not polled.
  */
 
-void CORE_APP_Tasks( void );
+void CORE_APP_Tasks( uint32_t events, uintptr_t context );
 
 //DOM-IGNORE-BEGIN
 #ifdef __cplusplus
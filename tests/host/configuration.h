@@ -0,0 +1,28 @@
+/*******************************************************************************
+  Host Test Configuration Header
+
+  File Name:
+    configuration.h
+
+  Summary:
+    Configuration of the modules built for the host tests.
+
+  Description:
+    Replaces the project configuration.h. Only the options of the modules
+    under test are set; small buffers make wrap-around and full rings quick
+    to reach.
+*******************************************************************************/
+
+#ifndef CONFIGURATION_H
+#define CONFIGURATION_H
+
+#include "device.h"
+
+#define SYS_BOOT_NO_INIT
+
+/* SERCOM0 USART ring buffer mode, interrupt driven receive */
+#define SERCOM0_USART_RING_BUFFER_ENABLE
+#define SERCOM0_USART_READ_BUFFER_SIZE          (8U)
+#define SERCOM0_USART_WRITE_BUFFER_SIZE         (8U)
+
+#endif // CONFIGURATION_H
@@ -0,0 +1,115 @@
+/*******************************************************************************
+  Host Device Header File
+
+  File Name:
+    device.h
+
+  Summary:
+    Stands in for the project device.h when a module is built for the host.
+
+  Description:
+    The register types and bit fields come from the SAMD21J18A DFP as on the
+    target. The CMSIS intrinsics are replaced by C: PRIMASK is a variable
+    and WFI does nothing. DMB and unmasking interrupts are preemption points:
+    with interrupts unmasked they call hostPreempt, through which a test can
+    run an interrupt in the middle of the code under test. Peripheral
+    instances that a test drives are redirected to RAM blocks of the same
+    layout, which the test reads and writes in place of the hardware.
+*******************************************************************************/
+
+#ifndef DEVICE_H
+#define DEVICE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Keeps cmsis_gcc.h and its Arm assembly out of the build */
+#define __CMSIS_GCC_H
+
+#define __ASM                   __asm
+#define __INLINE                inline
+#define __STATIC_INLINE         static inline
+#define __STATIC_FORCEINLINE    __attribute__((always_inline)) static inline
+#define __NO_RETURN             __attribute__((__noreturn__))
+#define __USED                  __attribute__((used))
+#define __WEAK                  __attribute__((weak))
+#define __PACKED                __attribute__((packed, aligned(1)))
+#define __PACKED_STRUCT         struct __attribute__((packed, aligned(1)))
+#define __PACKED_UNION          union __attribute__((packed, aligned(1)))
+#define __ALIGNED(x)            __attribute__((aligned(x)))
+#define __RESTRICT              __restrict
+#define __COMPILER_BARRIER()    __asm volatile("" ::: "memory")
+
+extern volatile uint32_t hostPrimask;
+
+extern void (*hostPreempt)( void );
+
+/* A place where an interrupt may run, if PRIMASK allows it */
+__STATIC_INLINE void HOST_PreemptPoint( void )
+{
+    __COMPILER_BARRIER();
+
+    if ((hostPreempt != NULL) && (hostPrimask == 0U))
+    {
+        hostPreempt();
+    }
+
+    __COMPILER_BARRIER();
+}
+
+__STATIC_INLINE uint32_t __get_PRIMASK( void )
+{
+    return hostPrimask;
+}
+
+__STATIC_INLINE void __set_PRIMASK( uint32_t priMask )
+{
+    __COMPILER_BARRIER();
+    hostPrimask = priMask & 1U;
+    HOST_PreemptPoint();
+}
+
+__STATIC_INLINE void __disable_irq( void )
+{
+    hostPrimask = 1U;
+    __COMPILER_BARRIER();
+}
+
+__STATIC_INLINE void __enable_irq( void )
+{
+    __COMPILER_BARRIER();
+    hostPrimask = 0U;
+    HOST_PreemptPoint();
+}
+
+#define __NOP()                 __COMPILER_BARRIER()
+#define __WFI()                 __COMPILER_BARRIER()
+#define __WFE()                 __COMPILER_BARRIER()
+#define __SEV()                 __COMPILER_BARRIER()
+#define __ISB()                 __COMPILER_BARRIER()
+#define __DSB()                 __COMPILER_BARRIER()
+#define __DMB()                 HOST_PreemptPoint()
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#pragma GCC diagnostic ignored "-Wattributes"
+#pragma GCC diagnostic ignored "-Wundef"
+#ifndef DONT_USE_PREDEFINED_CORE_HANDLERS
+    #define DONT_USE_PREDEFINED_CORE_HANDLERS
+#endif
+#ifndef DONT_USE_PREDEFINED_PERIPHERALS_HANDLERS
+    #define DONT_USE_PREDEFINED_PERIPHERALS_HANDLERS
+#endif
+#include "samd21j18a.h"
+#pragma GCC diagnostic pop
+#include "device_cache.h"
+#include "toolchain_specifics.h"
+
+/* RAM blocks standing in for the peripherals under test */
+extern sercom_registers_t hostSercom0Regs;
+
+#undef SERCOM0_REGS
+#define SERCOM0_REGS            (&hostSercom0Regs)
+
+#endif //DEVICE_H
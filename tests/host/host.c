@@ -0,0 +1,20 @@
+/*******************************************************************************
+  Host Test Support
+
+  File Name:
+    host.c
+
+  Summary:
+    State behind the host device.h and test.h.
+*******************************************************************************/
+
+#include "device.h"
+#include "test.h"
+
+volatile uint32_t hostPrimask;
+
+void (*hostPreempt)( void );
+
+sercom_registers_t hostSercom0Regs;
+
+unsigned int testFailures;
@@ -0,0 +1,43 @@
+/*******************************************************************************
+  Host Test Support Header File
+
+  File Name:
+    test.h
+
+  Summary:
+    Assertions and the test runner of the host tests.
+
+  Description:
+    A failed TEST_ASSERT prints its location and condition and lets the test
+    go on. TEST_RUN runs one test function and prints its result; main returns
+    TEST_Result() so that make stops on a failure.
+*******************************************************************************/
+
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+
+extern unsigned int testFailures;
+
+#define TEST_ASSERT(condition)                                              \
+    do                                                                      \
+    {                                                                       \
+        if (!(condition))                                                   \
+        {                                                                   \
+            testFailures++;                                                 \
+            printf("%s:%d: failed: %s\n", __FILE__, __LINE__, #condition);  \
+        }                                                                   \
+    } while (0)
+
+#define TEST_RUN(test)                                                      \
+    do                                                                      \
+    {                                                                       \
+        unsigned int failuresBefore = testFailures;                         \
+        test();                                                             \
+        printf("%s %s\n", (testFailures == failuresBefore) ? "PASS" : "FAIL", #test); \
+    } while (0)
+
+#define TEST_Result()           ((testFailures == 0U) ? 0 : 1)
+
+#endif // TEST_H
@@ -0,0 +1,390 @@
+/*******************************************************************************
+  OSAL Basic Implementation Host Test
+
+  File Name:
+    test_osal_basic.c
+
+  Summary:
+    Runs the semaphore and mutex waits of osal_impl_basic.c on SYS_SCHED.
+
+  Description:
+    SYS_SCHED and SYS_TMR are the real ones. SYS_TIME is replaced by a 1 ms
+    tick that the test steps, and SYS_FAULT_Raise by a jump back into the
+    test. A waiter task pends or locks once per run: the asynchronous calls
+    must time out on the task timer and wake on a post or an unlock, and the
+    blocking calls must raise a fault when a task passes a wait.
+*******************************************************************************/
+
+#include <setjmp.h>
+#include <string.h>
+#include "device.h"
+#include "test.h"
+#include "osal/osal.h"
+#include "system/fault/sys_fault.h"
+#include "system/time/sys_time.h"
+
+#define TEST_CYCLES_PER_MS      (48000U)
+
+typedef enum
+{
+    TEST_OP_PEND_ASYNC,
+    TEST_OP_LOCK_ASYNC,
+    TEST_OP_PEND,
+    TEST_OP_LOCK,
+
+} TEST_OP;
+
+typedef struct
+{
+    SYS_SCHED_TASK      task;
+    TEST_OP             op;
+    uint16_t            waitMS;
+    uint32_t            runs;
+    bool                isDone;
+    OSAL_RESULT         result;
+
+} TEST_WAITER;
+
+static uint64_t testCycles;
+static uint64_t testTicks;
+
+/* Cycles that every SYS_TIME_Now call moves time on, for the blocking waits */
+static uint32_t testNowStep;
+
+static jmp_buf testFaultJump;
+static SYS_FAULT_REASON testFaultReason;
+
+static uint32_t testPreemptCount;
+static uint32_t testPreemptPostAt;
+
+static OSAL_SEM_HANDLE_TYPE testSem;
+static OSAL_MUTEX_HANDLE_TYPE testMutex;
+
+static TEST_WAITER testWaiter;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Stand-ins
+// *****************************************************************************
+// *****************************************************************************
+
+uint64_t SYS_TIME_Now( void )
+{
+    testCycles += testNowStep;
+    return testCycles;
+}
+
+uint64_t SYS_TIME_TickGet( void )
+{
+    return testTicks;
+}
+
+uint32_t SYS_TIME_TickPeriodGet( void )
+{
+    return TEST_CYCLES_PER_MS;
+}
+
+uint64_t SYS_TIME_CyclesToUS( uint64_t cycles )
+{
+    return cycles / (TEST_CYCLES_PER_MS / 1000U);
+}
+
+uint64_t SYS_TIME_USToCycles( uint32_t us )
+{
+    return (uint64_t)us * (TEST_CYCLES_PER_MS / 1000U);
+}
+
+void SYS_FAULT_Raise( SYS_FAULT_REASON reason )
+{
+    testFaultReason = reason;
+    longjmp(testFaultJump, 1);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Helpers
+// *****************************************************************************
+// *****************************************************************************
+
+static void TEST_WaiterTask( uint32_t events, uintptr_t context )
+{
+    TEST_WAITER *waiter = (TEST_WAITER *)context;
+
+    waiter->runs++;
+
+    switch (waiter->op)
+    {
+        case TEST_OP_PEND_ASYNC:
+            waiter->isDone = OSAL_SEM_PendAsync(&testSem, &waiter->task, waiter->waitMS, &waiter->result);
+            break;
+
+        case TEST_OP_LOCK_ASYNC:
+            waiter->isDone = OSAL_MUTEX_LockAsync(&testMutex, &waiter->task, waiter->waitMS, &waiter->result);
+            break;
+
+        case TEST_OP_PEND:
+            waiter->result = OSAL_SEM_Pend(&testSem, waiter->waitMS);
+            waiter->isDone = true;
+            break;
+
+        default:
+            waiter->result = OSAL_MUTEX_Lock(&testMutex, waiter->waitMS);
+            waiter->isDone = true;
+            break;
+    }
+}
+
+/* Fresh services and objects, and the waiter signaled to run once */
+static void TEST_Setup( TEST_OP op, uint16_t waitMS )
+{
+    hostPrimask = 0U;
+    hostPreempt = NULL;
+    testCycles = 0U;
+    testTicks = 0U;
+    testNowStep = 0U;
+    testFaultReason = SYS_FAULT_REASON_NONE;
+
+    SYS_TMR_Initialize();
+    SYS_SCHED_Initialize();
+    (void)OSAL_SEM_Create(&testSem, OSAL_SEM_TYPE_BINARY, 1U, 0U);
+    (void)OSAL_MUTEX_Create(&testMutex);
+
+    memset(&testWaiter, 0, sizeof(testWaiter));
+    testWaiter.op = op;
+    testWaiter.waitMS = waitMS;
+    testWaiter.result = OSAL_RESULT_NOT_IMPLEMENTED;
+    (void)SYS_SCHED_TaskCreate(&testWaiter.task, "waiter", 1U, TEST_WaiterTask, (uintptr_t)&testWaiter);
+    SYS_SCHED_EventSignal(&testWaiter.task, 1U);
+}
+
+/* One millisecond: the tick, the timers it expires, then the ready tasks */
+static void TEST_TickAdvance( void )
+{
+    testTicks++;
+    SYS_TMR_Tasks();
+    SYS_SCHED_Tasks();
+}
+
+/* Posts the semaphore from the interrupt taken at the testPreemptPostAt-th
+ * unmask */
+static void TEST_PostPreempt( void )
+{
+    testPreemptCount++;
+    if (testPreemptCount == testPreemptPostAt)
+    {
+        hostPreempt = NULL;
+        (void)OSAL_SEM_PostISR(&testSem);
+    }
+}
+
+/* Runs the waiter; returns the fault it raised */
+static SYS_FAULT_REASON TEST_RunForFault( void )
+{
+    if (setjmp(testFaultJump) == 0)
+    {
+        SYS_SCHED_Tasks();
+    }
+
+    return testFaultReason;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Tests
+// *****************************************************************************
+// *****************************************************************************
+
+static void TEST_PendAsyncTimeout( void )
+{
+    uint32_t i;
+
+    TEST_Setup(TEST_OP_PEND_ASYNC, 5U);
+
+    SYS_SCHED_Tasks();
+    TEST_ASSERT(testWaiter.isDone == false);
+    TEST_ASSERT(testWaiter.task.waitQueue == &testSem.waiters);
+    TEST_ASSERT(SYS_TMR_IsActive(&testWaiter.task.timer));
+    TEST_ASSERT(SYS_SCHED_IsIdle());
+
+    for (i = 1U; i < 5U; i++)
+    {
+        TEST_TickAdvance();
+        TEST_ASSERT(testWaiter.isDone == false);
+    }
+
+    TEST_TickAdvance();
+    TEST_ASSERT(testWaiter.isDone == true);
+    TEST_ASSERT(testWaiter.result == OSAL_RESULT_FAIL);
+    TEST_ASSERT(testWaiter.runs == 2U);
+    TEST_ASSERT(testWaiter.task.waitQueue == NULL);
+    TEST_ASSERT(testSem.waiters.head == NULL);
+
+    /* Nothing left to wake: a late post only counts */
+    TEST_ASSERT(OSAL_SEM_Post(&testSem) == OSAL_RESULT_SUCCESS);
+    TEST_ASSERT(SYS_SCHED_IsIdle());
+    TEST_ASSERT(OSAL_SEM_GetCount(&testSem) == 1U);
+}
+
+static void TEST_PendAsyncWakeOnPost( void )
+{
+    uint32_t i;
+
+    TEST_Setup(TEST_OP_PEND_ASYNC, OSAL_WAIT_FOREVER);
+
+    SYS_SCHED_Tasks();
+    TEST_ASSERT(testWaiter.isDone == false);
+    TEST_ASSERT(SYS_TMR_IsActive(&testWaiter.task.timer) == false);
+
+    /* Forever: no tick ends the wait, and the task is not run meanwhile */
+    for (i = 0U; i < 100U; i++)
+    {
+        TEST_TickAdvance();
+    }
+    TEST_ASSERT(testWaiter.isDone == false);
+    TEST_ASSERT(testWaiter.runs == 1U);
+
+    TEST_ASSERT(OSAL_SEM_PostISR(&testSem) == OSAL_RESULT_SUCCESS);
+    TEST_ASSERT(SYS_SCHED_IsIdle() == false);
+
+    SYS_SCHED_Tasks();
+    TEST_ASSERT(testWaiter.isDone == true);
+    TEST_ASSERT(testWaiter.result == OSAL_RESULT_SUCCESS);
+    TEST_ASSERT(OSAL_SEM_GetCount(&testSem) == 0U);
+    TEST_ASSERT(testWaiter.task.waitQueue == NULL);
+
+    /* A timed wait that a post ends stops its timer */
+    TEST_Setup(TEST_OP_PEND_ASYNC, 50U);
+
+    SYS_SCHED_Tasks();
+    TEST_TickAdvance();
+    TEST_TickAdvance();
+    TEST_ASSERT(testWaiter.isDone == false);
+
+    (void)OSAL_SEM_Post(&testSem);
+    SYS_SCHED_Tasks();
+    TEST_ASSERT(testWaiter.isDone == true);
+    TEST_ASSERT(testWaiter.result == OSAL_RESULT_SUCCESS);
+    TEST_ASSERT(SYS_TMR_IsActive(&testWaiter.task.timer) == false);
+}
+
+static void TEST_LockAsync( void )
+{
+    uint32_t i;
+
+    /* Unlock wakes the waiter, which then holds the mutex */
+    TEST_Setup(TEST_OP_LOCK_ASYNC, 10U);
+    TEST_ASSERT(OSAL_MUTEX_Lock(&testMutex, 0U) == OSAL_RESULT_SUCCESS);
+
+    SYS_SCHED_Tasks();
+    TEST_ASSERT(testWaiter.isDone == false);
+    TEST_ASSERT(testWaiter.task.waitQueue == &testMutex.waiters);
+
+    TEST_TickAdvance();
+    TEST_TickAdvance();
+    TEST_ASSERT(OSAL_MUTEX_Unlock(&testMutex) == OSAL_RESULT_SUCCESS);
+    SYS_SCHED_Tasks();
+    TEST_ASSERT(testWaiter.isDone == true);
+    TEST_ASSERT(testWaiter.result == OSAL_RESULT_SUCCESS);
+    TEST_ASSERT(testMutex.isLocked == true);
+    TEST_ASSERT(SYS_TMR_IsActive(&testWaiter.task.timer) == false);
+
+    /* Held throughout: the wait times out and the owner keeps it */
+    TEST_Setup(TEST_OP_LOCK_ASYNC, 3U);
+    (void)OSAL_MUTEX_Lock(&testMutex, 0U);
+
+    SYS_SCHED_Tasks();
+    for (i = 0U; (i < 10U) && (testWaiter.isDone == false); i++)
+    {
+        TEST_TickAdvance();
+    }
+    TEST_ASSERT(testWaiter.isDone == true);
+    TEST_ASSERT(testWaiter.result == OSAL_RESULT_FAIL);
+    TEST_ASSERT(testTicks == 3U);
+    TEST_ASSERT(testMutex.isLocked == true);
+    TEST_ASSERT(testMutex.waiters.head == NULL);
+
+    /* No wait: one try */
+    TEST_Setup(TEST_OP_LOCK_ASYNC, 0U);
+    (void)OSAL_MUTEX_Lock(&testMutex, 0U);
+
+    SYS_SCHED_Tasks();
+    TEST_ASSERT(testWaiter.isDone == true);
+    TEST_ASSERT(testWaiter.result == OSAL_RESULT_FAIL);
+    TEST_ASSERT(testWaiter.task.waitQueue == NULL);
+}
+
+static void TEST_BlockingInTask( void )
+{
+    static const TEST_OP ops[] = { TEST_OP_PEND, TEST_OP_LOCK };
+    static const uint16_t waits[] = { OSAL_WAIT_FOREVER, 10U };
+    uint32_t op;
+    uint32_t wait;
+
+    /* A wait faults even when the object is free, and takes nothing */
+    for (op = 0U; op < (sizeof(ops) / sizeof(ops[0])); op++)
+    {
+        for (wait = 0U; wait < (sizeof(waits) / sizeof(waits[0])); wait++)
+        {
+            TEST_Setup(ops[op], waits[wait]);
+            (void)OSAL_SEM_Post(&testSem);
+
+            TEST_ASSERT(TEST_RunForFault() == SYS_FAULT_REASON_TASK_BLOCK);
+            TEST_ASSERT(testWaiter.isDone == false);
+            TEST_ASSERT(OSAL_SEM_GetCount(&testSem) == 1U);
+            TEST_ASSERT(testMutex.isLocked == false);
+        }
+    }
+
+    /* Without a wait a task may try */
+    TEST_Setup(TEST_OP_PEND, 0U);
+    TEST_ASSERT(TEST_RunForFault() == SYS_FAULT_REASON_NONE);
+    TEST_ASSERT(testWaiter.result == OSAL_RESULT_FAIL);
+
+    (void)OSAL_SEM_Post(&testSem);
+    SYS_SCHED_EventSignal(&testWaiter.task, 1U);
+    TEST_ASSERT(TEST_RunForFault() == SYS_FAULT_REASON_NONE);
+    TEST_ASSERT(testWaiter.result == OSAL_RESULT_SUCCESS);
+
+    TEST_Setup(TEST_OP_LOCK, 0U);
+    TEST_ASSERT(TEST_RunForFault() == SYS_FAULT_REASON_NONE);
+    TEST_ASSERT(testWaiter.result == OSAL_RESULT_SUCCESS);
+    TEST_ASSERT(testMutex.isLocked == true);
+}
+
+static void TEST_BlockingOutsideTask( void )
+{
+    /* Times out on SYS_TIME */
+    TEST_Setup(TEST_OP_PEND, 0U);
+    testNowStep = TEST_CYCLES_PER_MS;
+
+    TEST_ASSERT(OSAL_SEM_Pend(&testSem, 3U) == OSAL_RESULT_FAIL);
+    TEST_ASSERT(testCycles >= (3U * TEST_CYCLES_PER_MS));
+    TEST_ASSERT(testCycles <= (5U * TEST_CYCLES_PER_MS));
+
+    TEST_ASSERT(OSAL_MUTEX_Lock(&testMutex, 0U) == OSAL_RESULT_SUCCESS);
+    testCycles = 0U;
+    TEST_ASSERT(OSAL_MUTEX_Lock(&testMutex, 2U) == OSAL_RESULT_FAIL);
+    TEST_ASSERT(testCycles >= (2U * TEST_CYCLES_PER_MS));
+
+    /* Ends on the interrupt that posts */
+    testPreemptCount = 0U;
+    testPreemptPostAt = 3U;
+    hostPreempt = TEST_PostPreempt;
+
+    TEST_ASSERT(OSAL_SEM_Pend(&testSem, OSAL_WAIT_FOREVER) == OSAL_RESULT_SUCCESS);
+    TEST_ASSERT(testPreemptCount == 3U);
+    TEST_ASSERT(OSAL_SEM_GetCount(&testSem) == 0U);
+    TEST_ASSERT(hostPrimask == 0U);
+    TEST_ASSERT(testFaultReason == SYS_FAULT_REASON_NONE);
+}
+
+int main( void )
+{
+    TEST_RUN(TEST_PendAsyncTimeout);
+    TEST_RUN(TEST_PendAsyncWakeOnPost);
+    TEST_RUN(TEST_LockAsync);
+    TEST_RUN(TEST_BlockingInTask);
+    TEST_RUN(TEST_BlockingOutsideTask);
+
+    return TEST_Result();
+}
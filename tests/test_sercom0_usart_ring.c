@@ -0,0 +1,359 @@
+/*******************************************************************************
+  SERCOM0 USART Ring Buffer Host Test
+
+  File Name:
+    test_sercom0_usart_ring.c
+
+  Summary:
+    Runs the SERCOM0 USART ring buffer mode against a RAM register block.
+
+  Description:
+    SERCOM0_REGS points at hostSercom0Regs (host/device.h). The test plays the
+    hardware between calls: it raises RXC with a character in DATA, keeps DRE
+    set and folds the INTENSET and INTENCLR writes into one enable mask, as
+    the peripheral does.
+
+    RAM has no read side effects, so reading DATA does not clear RXC. The
+    read callback stands in for the receiver running dry: it clears RXC, and
+    the receive tests enable persistent read notifications with a threshold
+    of 1 so that every interrupt takes exactly one character. Likewise the
+    write callback records DATA, which shows every character that leaves.
+*******************************************************************************/
+
+#include <string.h>
+#include "test.h"
+#include "peripheral/clock/plib_clock.h"
+#include "peripheral/sercom/usart/plib_sercom0_usart.h"
+
+#define TEST_RING_SIZE          (SERCOM0_USART_WRITE_BUFFER_SIZE)
+#define TEST_EVENTS_MAX         (64U)
+
+typedef struct
+{
+    SERCOM_USART_EVENT  event;
+    uint16_t            data;
+
+} TEST_EVENT;
+
+static uint8_t hostIntEnable;
+
+static TEST_EVENT testReadEvents[TEST_EVENTS_MAX];
+static uint32_t testReadEventCount;
+
+static TEST_EVENT testWriteEvents[TEST_EVENTS_MAX];
+static uint32_t testWriteEventCount;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Stubs and Hardware Model
+// *****************************************************************************
+// *****************************************************************************
+
+uint32_t CLOCK_FrequencyGet( void )
+{
+    return CLOCK_DFLL_FREQUENCY;
+}
+
+bool CLOCK_CallbackRegister( CLOCK_CALLBACK callback, uintptr_t context )
+{
+    return true;
+}
+
+/* INTENSET and INTENCLR are set and clear strobes of one enable register */
+static void HOST_SercomSync( void )
+{
+    hostIntEnable = (uint8_t)((hostIntEnable | hostSercom0Regs.USART_INT.SERCOM_INTENSET) & ~hostSercom0Regs.USART_INT.SERCOM_INTENCLR);
+
+    hostSercom0Regs.USART_INT.SERCOM_INTENSET = hostIntEnable;
+    hostSercom0Regs.USART_INT.SERCOM_INTENCLR = 0U;
+}
+
+static void HOST_Interrupt( void )
+{
+    HOST_SercomSync();
+    SERCOM0_USART_InterruptHandler();
+    HOST_SercomSync();
+}
+
+static void HOST_Receive( uint8_t data )
+{
+    hostSercom0Regs.USART_INT.SERCOM_DATA = data;
+    hostSercom0Regs.USART_INT.SERCOM_INTFLAG |= (uint8_t)SERCOM_USART_INT_INTFLAG_RXC_Msk;
+
+    HOST_Interrupt();
+}
+
+static bool HOST_DreIsEnabled( void )
+{
+    HOST_SercomSync();
+
+    return ((hostIntEnable & SERCOM_USART_INT_INTENSET_DRE_Msk) != 0U);
+}
+
+static void TEST_ReadCallback( SERCOM_USART_EVENT event, uintptr_t context )
+{
+    if (testReadEventCount < TEST_EVENTS_MAX)
+    {
+        testReadEvents[testReadEventCount].event = event;
+        testReadEvents[testReadEventCount].data = (uint16_t)SERCOM0_USART_ReadCountGet();
+        testReadEventCount++;
+    }
+
+    hostSercom0Regs.USART_INT.SERCOM_INTFLAG &= (uint8_t)~SERCOM_USART_INT_INTFLAG_RXC_Msk;
+}
+
+static void TEST_WriteCallback( SERCOM_USART_EVENT event, uintptr_t context )
+{
+    if (testWriteEventCount < TEST_EVENTS_MAX)
+    {
+        testWriteEvents[testWriteEventCount].event = event;
+        testWriteEvents[testWriteEventCount].data = hostSercom0Regs.USART_INT.SERCOM_DATA;
+        testWriteEventCount++;
+    }
+}
+
+static void TEST_Setup( void )
+{
+    (void)memset(&hostSercom0Regs, 0, sizeof(hostSercom0Regs));
+    hostSercom0Regs.USART_INT.SERCOM_INTFLAG = (uint8_t)SERCOM_USART_INT_INTFLAG_DRE_Msk;
+    hostIntEnable = 0U;
+
+    testReadEventCount = 0U;
+    testWriteEventCount = 0U;
+
+    SERCOM0_USART_Initialize();
+    HOST_SercomSync();
+}
+
+/* Every character received raises one read notification */
+static void TEST_ReceiveSetup( void )
+{
+    TEST_Setup();
+
+    SERCOM0_USART_ReadCallbackRegister(TEST_ReadCallback, 0U);
+    SERCOM0_USART_ReadThresholdSet(1U);
+    (void)SERCOM0_USART_ReadNotificationEnable(true, true);
+}
+
+/* Every character sent raises one write notification */
+static void TEST_TransmitSetup( void )
+{
+    TEST_Setup();
+
+    SERCOM0_USART_WriteCallbackRegister(TEST_WriteCallback, 0U);
+    SERCOM0_USART_WriteThresholdSet(1U);
+    (void)SERCOM0_USART_WriteNotificationEnable(true, true);
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Tests
+// *****************************************************************************
+// *****************************************************************************
+
+static void TEST_InitializeEnablesReceive( void )
+{
+    TEST_Setup();
+
+    TEST_ASSERT((hostIntEnable & SERCOM_USART_INT_INTENSET_RXC_Msk) != 0U);
+    TEST_ASSERT((hostIntEnable & SERCOM_USART_INT_INTENSET_ERROR_Msk) != 0U);
+    TEST_ASSERT(HOST_DreIsEnabled() == false);
+    TEST_ASSERT(SERCOM0_USART_WriteBufferSizeGet() == (TEST_RING_SIZE - 1U));
+    TEST_ASSERT(SERCOM0_USART_ReadBufferSizeGet() == (SERCOM0_USART_READ_BUFFER_SIZE - 1U));
+}
+
+static void TEST_WriteAsyncQueues( void )
+{
+    TEST_Setup();
+
+    TEST_ASSERT(SERCOM0_USART_WriteAsync("abc", 3U) == 3U);
+    TEST_ASSERT(SERCOM0_USART_WriteCountGet() == 3U);
+    TEST_ASSERT(SERCOM0_USART_WriteFreeBufferCountGet() == (TEST_RING_SIZE - 4U));
+    TEST_ASSERT(HOST_DreIsEnabled() == true);
+
+    TEST_ASSERT(SERCOM0_USART_WriteAsync(NULL, 3U) == 0U);
+    TEST_ASSERT(SERCOM0_USART_WriteAsync("abc", 0U) == 0U);
+}
+
+static void TEST_TransmitInOrder( void )
+{
+    uint32_t i;
+
+    TEST_TransmitSetup();
+
+    (void)SERCOM0_USART_WriteAsync("hello", 5U);
+    HOST_Interrupt();
+
+    TEST_ASSERT(testWriteEventCount == 5U);
+    for (i = 0U; i < testWriteEventCount; i++)
+    {
+        TEST_ASSERT(testWriteEvents[i].event == SERCOM_USART_EVENT_WRITE_THRESHOLD_REACHED);
+        TEST_ASSERT(testWriteEvents[i].data == (uint16_t)"hello"[i]);
+    }
+
+    /* Empty ring: the handler turns DRE off */
+    TEST_ASSERT(SERCOM0_USART_WriteCountGet() == 0U);
+    TEST_ASSERT(HOST_DreIsEnabled() == false);
+}
+
+static void TEST_WriteFullRing( void )
+{
+    TEST_TransmitSetup();
+
+    /* One slot stays empty */
+    TEST_ASSERT(SERCOM0_USART_WriteAsync("0123456789", 10U) == (TEST_RING_SIZE - 1U));
+    TEST_ASSERT(SERCOM0_USART_WriteFreeBufferCountGet() == 0U);
+    TEST_ASSERT(SERCOM0_USART_WriteAsync("x", 1U) == 0U);
+
+    HOST_Interrupt();
+
+    TEST_ASSERT(testWriteEventCount == (TEST_RING_SIZE - 1U));
+    TEST_ASSERT(testWriteEvents[TEST_RING_SIZE - 2U].data == (uint16_t)'6');
+    TEST_ASSERT(SERCOM0_USART_WriteAsync("x", 1U) == 1U);
+}
+
+static void TEST_WriteWrap( void )
+{
+    static const char text[] = "abcdefghijklmnopqrstuvwxyz";
+    uint32_t offset;
+    uint32_t i;
+
+    TEST_TransmitSetup();
+
+    /* 26 characters in chunks of 5 go around the 8 slot ring three times */
+    for (offset = 0U; offset < 26U; offset += 5U)
+    {
+        uint32_t size = ((26U - offset) < 5U) ? (26U - offset) : 5U;
+
+        TEST_ASSERT(SERCOM0_USART_WriteAsync(&text[offset], size) == size);
+        HOST_Interrupt();
+    }
+
+    TEST_ASSERT(testWriteEventCount == 26U);
+    for (i = 0U; i < testWriteEventCount; i++)
+    {
+        TEST_ASSERT(testWriteEvents[i].data == (uint16_t)text[i]);
+    }
+}
+
+static void TEST_WriteThresholdOnce( void )
+{
+    TEST_Setup();
+
+    SERCOM0_USART_WriteCallbackRegister(TEST_WriteCallback, 0U);
+    SERCOM0_USART_WriteThresholdSet(4U);
+    (void)SERCOM0_USART_WriteNotificationEnable(true, false);
+
+    /* Seven queued leave no free slot; four free slots after '3' is sent */
+    (void)SERCOM0_USART_WriteAsync("0123456", 7U);
+    HOST_Interrupt();
+
+    TEST_ASSERT(testWriteEventCount == 1U);
+    TEST_ASSERT(testWriteEvents[0].event == SERCOM_USART_EVENT_WRITE_THRESHOLD_REACHED);
+    TEST_ASSERT(testWriteEvents[0].data == (uint16_t)'3');
+}
+
+static void TEST_ReceiveAndReadAvailable( void )
+{
+    uint8_t buffer[4] = { 0U };
+
+    TEST_ReceiveSetup();
+
+    HOST_Receive('x');
+    HOST_Receive('y');
+    HOST_Receive('z');
+
+    TEST_ASSERT(SERCOM0_USART_ReadCountGet() == 3U);
+    TEST_ASSERT(testReadEventCount == 3U);
+    TEST_ASSERT(testReadEvents[2].event == SERCOM_USART_EVENT_READ_THRESHOLD_REACHED);
+    TEST_ASSERT(testReadEvents[2].data == 3U);
+
+    TEST_ASSERT(SERCOM0_USART_ReadAvailable(buffer, 2U) == 2U);
+    TEST_ASSERT(memcmp(buffer, "xy", 2U) == 0);
+    TEST_ASSERT(SERCOM0_USART_ReadAvailable(buffer, sizeof(buffer)) == 1U);
+    TEST_ASSERT(buffer[0] == (uint8_t)'z');
+    TEST_ASSERT(SERCOM0_USART_ReadAvailable(buffer, sizeof(buffer)) == 0U);
+    TEST_ASSERT(SERCOM0_USART_ReadAvailable(NULL, sizeof(buffer)) == 0U);
+}
+
+static void TEST_ReceiveWrap( void )
+{
+    uint8_t buffer[5];
+    uint32_t round;
+    uint32_t i;
+
+    TEST_ReceiveSetup();
+
+    for (round = 0U; round < 5U; round++)
+    {
+        for (i = 0U; i < sizeof(buffer); i++)
+        {
+            HOST_Receive((uint8_t)((round * 16U) + i));
+        }
+
+        TEST_ASSERT(SERCOM0_USART_ReadAvailable(buffer, sizeof(buffer)) == sizeof(buffer));
+        for (i = 0U; i < sizeof(buffer); i++)
+        {
+            TEST_ASSERT(buffer[i] == (uint8_t)((round * 16U) + i));
+        }
+    }
+}
+
+static void TEST_ReceiveFullRing( void )
+{
+    uint8_t buffer[SERCOM0_USART_READ_BUFFER_SIZE];
+    uint32_t i;
+
+    TEST_ReceiveSetup();
+
+    for (i = 0U; i < SERCOM0_USART_READ_BUFFER_SIZE; i++)
+    {
+        HOST_Receive((uint8_t)('a' + i));
+    }
+
+    /* The last character finds the ring full and is dropped */
+    TEST_ASSERT(SERCOM0_USART_ReadFreeBufferCountGet() == 0U);
+    TEST_ASSERT(testReadEvents[testReadEventCount - 1U].event == SERCOM_USART_EVENT_READ_BUFFER_FULL);
+
+    TEST_ASSERT(SERCOM0_USART_ReadAvailable(buffer, sizeof(buffer)) == (SERCOM0_USART_READ_BUFFER_SIZE - 1U));
+    for (i = 0U; i < (SERCOM0_USART_READ_BUFFER_SIZE - 1U); i++)
+    {
+        TEST_ASSERT(buffer[i] == (uint8_t)('a' + i));
+    }
+
+    HOST_Receive('!');
+    TEST_ASSERT(SERCOM0_USART_ReadAvailable(buffer, sizeof(buffer)) == 1U);
+    TEST_ASSERT(buffer[0] == (uint8_t)'!');
+}
+
+static void TEST_ReceiveError( void )
+{
+    TEST_ReceiveSetup();
+
+    hostSercom0Regs.USART_INT.SERCOM_STATUS = (uint16_t)SERCOM_USART_INT_STATUS_FERR_Msk;
+    hostSercom0Regs.USART_INT.SERCOM_INTFLAG |= (uint8_t)SERCOM_USART_INT_INTFLAG_ERROR_Msk;
+    HOST_Interrupt();
+
+    TEST_ASSERT(testReadEventCount == 1U);
+    TEST_ASSERT(testReadEvents[0].event == SERCOM_USART_EVENT_READ_ERROR);
+    TEST_ASSERT(SERCOM0_USART_ErrorGet() == USART_ERROR_FRAMING);
+    TEST_ASSERT(SERCOM0_USART_ErrorGet() == USART_ERROR_NONE);
+}
+
+int main( void )
+{
+    TEST_RUN(TEST_InitializeEnablesReceive);
+    TEST_RUN(TEST_WriteAsyncQueues);
+    TEST_RUN(TEST_TransmitInOrder);
+    TEST_RUN(TEST_WriteFullRing);
+    TEST_RUN(TEST_WriteWrap);
+    TEST_RUN(TEST_WriteThresholdOnce);
+    TEST_RUN(TEST_ReceiveAndReadAvailable);
+    TEST_RUN(TEST_ReceiveWrap);
+    TEST_RUN(TEST_ReceiveFullRing);
+    TEST_RUN(TEST_ReceiveError);
+
+    return TEST_Result();
+}
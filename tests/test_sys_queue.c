@@ -0,0 +1,506 @@
+/*******************************************************************************
+  SYS_QUEUE Preemption Host Test
+
+  File Name:
+    test_sys_queue.c
+
+  Summary:
+    Runs the SPSC and MPSC queues with an interrupt at every preemption point.
+
+  Description:
+    Every DMB, every interrupt unmask and every byte of an element copy is a
+    preemption point (host/device.h; memcpy is replaced below). A scenario
+    runs its thread-side operations once per point, with the interrupt
+    operations injected at that point, until a run passes no further point.
+    Scenarios with two interrupt levels also try every point of the first
+    interrupt for the second one.
+
+    After each run the queue is drained, and every element that a put
+    accepted must come out exactly once, intact and in the order of its
+    producer.
+
+    The MPSC slot reservation has no point between reading and advancing the
+    head, so the test relies on, rather than shows, the masking around it.
+*******************************************************************************/
+
+#include <string.h>
+#include "device.h"
+#include "test.h"
+
+static void *HOST_Memcpy( void *destination, const void *source, size_t size );
+
+/* Builds the queue with its copies preemptible at every byte */
+#define memcpy(destination, source, size)   HOST_Memcpy((destination), (source), (size))
+#include "system/queue/src/sys_queue.c"
+#undef memcpy
+
+#define TEST_CAPACITY           (4U)
+#define TEST_LEVELS             (2U)
+#define TEST_LOG_SIZE           (64U)
+#define TEST_SOURCES            (3U)
+
+typedef struct
+{
+    uint8_t     source;
+    uint8_t     pad[6];
+    uint8_t     sequence;
+    uint32_t    check;
+
+} TEST_ELEMENT;
+
+typedef struct
+{
+    /* Interrupt per level, NULL when the level is not used */
+    void        (*isr[TEST_LEVELS])( void );
+
+    /* Point at which each level fires, 0 for never */
+    uint32_t    preemptAt[TEST_LEVELS];
+
+    uint32_t    point[TEST_LEVELS];
+    bool        isFired[TEST_LEVELS];
+    uint32_t    level;
+
+} TEST_PREEMPTION;
+
+static TEST_PREEMPTION testPreemption;
+
+static SYS_QUEUE_SPSC testSpsc;
+static SYS_QUEUE_MPSC testMpsc;
+static TEST_ELEMENT testBuffer[TEST_CAPACITY];
+static volatile bool testIsFull[TEST_CAPACITY];
+
+/* Next sequence number per producer, and what the queue accepted */
+static uint8_t testNextSequence[TEST_SOURCES];
+static uint8_t testAccepted[TEST_SOURCES][TEST_LOG_SIZE];
+static uint32_t testAcceptedCount[TEST_SOURCES];
+
+static uint8_t testReceived[TEST_SOURCES][TEST_LOG_SIZE];
+static uint32_t testReceivedCount[TEST_SOURCES];
+
+static uint32_t testRuns;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Preemption
+// *****************************************************************************
+// *****************************************************************************
+
+static void *HOST_Memcpy( void *destination, const void *source, size_t size )
+{
+    uint8_t *to = (uint8_t *)destination;
+    const uint8_t *from = (const uint8_t *)source;
+    size_t i;
+
+    for (i = 0U; i < size; i++)
+    {
+        HOST_PreemptPoint();
+        to[i] = from[i];
+    }
+
+    return destination;
+}
+
+/* The interrupt of the current level runs at its chosen point; while it
+ * runs, the points count for the next level */
+static void TEST_Preempt( void )
+{
+    uint32_t level = testPreemption.level;
+
+    if ((level >= TEST_LEVELS) || (testPreemption.isr[level] == NULL))
+    {
+        return;
+    }
+
+    testPreemption.point[level]++;
+
+    if (testPreemption.point[level] == testPreemption.preemptAt[level])
+    {
+        testPreemption.isFired[level] = true;
+        testPreemption.level++;
+        testPreemption.isr[level]();
+        testPreemption.level--;
+    }
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Producers, Consumers and Checks
+// *****************************************************************************
+// *****************************************************************************
+
+static void TEST_ElementMake( TEST_ELEMENT *element, uint8_t source )
+{
+    uint8_t sequence = testNextSequence[source]++;
+
+    element->source = source;
+    (void)memset(element->pad, sequence, sizeof(element->pad));
+    element->sequence = sequence;
+    element->check = ((uint32_t)source << 16) ^ ((uint32_t)sequence * 0x01010101U) ^ 0xA5A5A5A5U;
+}
+
+static bool TEST_ElementIsIntact( const TEST_ELEMENT *element )
+{
+    uint32_t i;
+
+    if ((element->source >= TEST_SOURCES) ||
+        (element->check != (((uint32_t)element->source << 16) ^ ((uint32_t)element->sequence * 0x01010101U) ^ 0xA5A5A5A5U)))
+    {
+        return false;
+    }
+
+    for (i = 0U; i < sizeof(element->pad); i++)
+    {
+        if (element->pad[i] != element->sequence)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void TEST_Accepted( const TEST_ELEMENT *element, bool isAccepted )
+{
+    if (isAccepted && (testAcceptedCount[element->source] < TEST_LOG_SIZE))
+    {
+        testAccepted[element->source][testAcceptedCount[element->source]++] = element->sequence;
+    }
+}
+
+static void TEST_Received( const TEST_ELEMENT *element )
+{
+    TEST_ASSERT(TEST_ElementIsIntact(element));
+
+    if (TEST_ElementIsIntact(element) && (testReceivedCount[element->source] < TEST_LOG_SIZE))
+    {
+        testReceived[element->source][testReceivedCount[element->source]++] = element->sequence;
+    }
+}
+
+static void TEST_SpscPut( uint8_t source )
+{
+    TEST_ELEMENT element;
+
+    TEST_ElementMake(&element, source);
+    TEST_Accepted(&element, SYS_QUEUE_SPSC_Put(&testSpsc, &element));
+}
+
+static bool TEST_SpscGet( void )
+{
+    TEST_ELEMENT element;
+    bool isTaken = SYS_QUEUE_SPSC_Get(&testSpsc, &element);
+
+    if (isTaken)
+    {
+        TEST_Received(&element);
+    }
+
+    return isTaken;
+}
+
+static void TEST_MpscPut( uint8_t source )
+{
+    TEST_ELEMENT element;
+
+    TEST_ElementMake(&element, source);
+    TEST_Accepted(&element, SYS_QUEUE_MPSC_Put(&testMpsc, &element));
+}
+
+static bool TEST_MpscGet( void )
+{
+    TEST_ELEMENT element;
+    bool isTaken = SYS_QUEUE_MPSC_Get(&testMpsc, &element);
+
+    if (isTaken)
+    {
+        TEST_Received(&element);
+    }
+
+    return isTaken;
+}
+
+static void TEST_Reset( void )
+{
+    (void)memset(&testPreemption, 0, sizeof(testPreemption));
+    (void)memset(testBuffer, 0, sizeof(testBuffer));
+    (void)memset(testNextSequence, 0, sizeof(testNextSequence));
+    (void)memset(testAcceptedCount, 0, sizeof(testAcceptedCount));
+    (void)memset(testReceivedCount, 0, sizeof(testReceivedCount));
+
+    (void)SYS_QUEUE_SPSC_Initialize(&testSpsc, testBuffer, sizeof(TEST_ELEMENT), TEST_CAPACITY);
+    (void)SYS_QUEUE_MPSC_Initialize(&testMpsc, testBuffer, testIsFull, sizeof(TEST_ELEMENT), TEST_CAPACITY);
+}
+
+/* Drains the queue and compares what came out with what went in */
+static void TEST_Check( bool (*get)( void ), uint32_t (*countGet)( void ) )
+{
+    uint32_t source;
+
+    while (get())
+    {
+    }
+
+    TEST_ASSERT(countGet() == 0U);
+
+    for (source = 0U; source < TEST_SOURCES; source++)
+    {
+        TEST_ASSERT(testReceivedCount[source] == testAcceptedCount[source]);
+        TEST_ASSERT(memcmp(testReceived[source], testAccepted[source], testAcceptedCount[source]) == 0);
+    }
+}
+
+static uint32_t TEST_SpscCountGet( void )
+{
+    return SYS_QUEUE_SPSC_CountGet(&testSpsc);
+}
+
+static uint32_t TEST_MpscCountGet( void )
+{
+    return SYS_QUEUE_MPSC_CountGet(&testMpsc);
+}
+
+typedef struct
+{
+    void        (*setup)( void );
+    void        (*thread)( void );
+    void        (*isr[TEST_LEVELS])( void );
+    bool        (*get)( void );
+    uint32_t    (*countGet)( void );
+
+} TEST_SCENARIO;
+
+static void TEST_ScenarioRun( const TEST_SCENARIO *scenario, uint32_t preemptAt0, uint32_t preemptAt1 )
+{
+    TEST_Reset();
+    scenario->setup();
+
+    testPreemption.isr[0] = scenario->isr[0];
+    testPreemption.isr[1] = scenario->isr[1];
+    testPreemption.preemptAt[0] = preemptAt0;
+    testPreemption.preemptAt[1] = preemptAt1;
+
+    hostPreempt = TEST_Preempt;
+    scenario->thread();
+    hostPreempt = NULL;
+
+    TEST_Check(scenario->get, scenario->countGet);
+    testRuns++;
+}
+
+/* Every point of the thread for level 0, and for each of those every point
+ * of the level 0 interrupt for level 1 */
+static void TEST_ScenarioExplore( const TEST_SCENARIO *scenario )
+{
+    uint32_t preemptAt0;
+    uint32_t preemptAt1;
+
+    for (preemptAt0 = 1U; ; preemptAt0++)
+    {
+        TEST_ScenarioRun(scenario, preemptAt0, 0U);
+
+        if (testPreemption.isFired[0] == false)
+        {
+            break;
+        }
+
+        for (preemptAt1 = 1U; scenario->isr[1] != NULL; preemptAt1++)
+        {
+            TEST_ScenarioRun(scenario, preemptAt0, preemptAt1);
+
+            if (testPreemption.isFired[1] == false)
+            {
+                break;
+            }
+        }
+    }
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Scenarios
+// *****************************************************************************
+// *****************************************************************************
+
+static void TEST_SetupNone( void )
+{
+}
+
+static void TEST_SpscSetupTwo( void )
+{
+    TEST_SpscPut(0U);
+    TEST_SpscPut(0U);
+}
+
+static void TEST_SpscSetupThree( void )
+{
+    TEST_SpscSetupTwo();
+    TEST_SpscPut(0U);
+}
+
+static void TEST_SpscThreadDrain( void )
+{
+    while (TEST_SpscGet())
+    {
+    }
+}
+
+static void TEST_SpscThreadPutTwo( void )
+{
+    TEST_SpscPut(0U);
+    TEST_SpscPut(0U);
+}
+
+static void TEST_SpscIsrPutTwo( void )
+{
+    TEST_SpscPut(0U);
+    TEST_SpscPut(0U);
+}
+
+static void TEST_SpscIsrGet( void )
+{
+    (void)TEST_SpscGet();
+}
+
+static void TEST_SpscIsrDrain( void )
+{
+    while (TEST_SpscGet())
+    {
+    }
+}
+
+static void TEST_MpscSetupTwo( void )
+{
+    TEST_MpscPut(0U);
+    TEST_MpscPut(0U);
+}
+
+static void TEST_MpscThreadPutTwo( void )
+{
+    TEST_MpscPut(0U);
+    TEST_MpscPut(0U);
+}
+
+static void TEST_MpscThreadDrain( void )
+{
+    while (TEST_MpscGet())
+    {
+    }
+}
+
+static void TEST_MpscIsrPut1( void )
+{
+    TEST_MpscPut(1U);
+}
+
+static void TEST_MpscIsrPutTwo1( void )
+{
+    TEST_MpscPut(1U);
+    TEST_MpscPut(1U);
+}
+
+static void TEST_MpscIsrPut2( void )
+{
+    TEST_MpscPut(2U);
+}
+
+static void TEST_MpscIsrDrain( void )
+{
+    while (TEST_MpscGet())
+    {
+    }
+}
+
+/* The thread consumes while an interrupt produces, through the wrap */
+static void TEST_SpscConsumerPreempted( void )
+{
+    static const TEST_SCENARIO scenario =
+    {
+        TEST_SpscSetupTwo, TEST_SpscThreadDrain, { TEST_SpscIsrPutTwo, NULL },
+        TEST_SpscGet, TEST_SpscCountGet
+    };
+
+    TEST_ScenarioExplore(&scenario);
+}
+
+/* The thread produces into a nearly full queue while an interrupt consumes */
+static void TEST_SpscProducerPreempted( void )
+{
+    static const TEST_SCENARIO scenario =
+    {
+        TEST_SpscSetupThree, TEST_SpscThreadPutTwo, { TEST_SpscIsrGet, NULL },
+        TEST_SpscGet, TEST_SpscCountGet
+    };
+
+    TEST_ScenarioExplore(&scenario);
+}
+
+/* The consumer runs in the middle of a put into an empty queue */
+static void TEST_SpscConsumerInPut( void )
+{
+    static const TEST_SCENARIO scenario =
+    {
+        TEST_SetupNone, TEST_SpscThreadPutTwo, { TEST_SpscIsrDrain, NULL },
+        TEST_SpscGet, TEST_SpscCountGet
+    };
+
+    TEST_ScenarioExplore(&scenario);
+}
+
+/* Two producers, the second one nested in the first one's put */
+static void TEST_MpscProducersPreempted( void )
+{
+    static const TEST_SCENARIO scenario =
+    {
+        TEST_SetupNone, TEST_MpscThreadPutTwo, { TEST_MpscIsrPut1, TEST_MpscIsrPut2 },
+        TEST_MpscGet, TEST_MpscCountGet
+    };
+
+    TEST_ScenarioExplore(&scenario);
+}
+
+/* The consumer runs while a put has reserved a slot but not filled it */
+static void TEST_MpscConsumerInReservation( void )
+{
+    static const TEST_SCENARIO scenario =
+    {
+        TEST_SetupNone, TEST_MpscThreadPutTwo, { TEST_MpscIsrDrain, NULL },
+        TEST_MpscGet, TEST_MpscCountGet
+    };
+
+    TEST_ScenarioExplore(&scenario);
+}
+
+/* The thread consumes while two nested interrupts produce */
+static void TEST_MpscConsumerPreempted( void )
+{
+    static const TEST_SCENARIO scenario =
+    {
+        TEST_MpscSetupTwo, TEST_MpscThreadDrain, { TEST_MpscIsrPutTwo1, TEST_MpscIsrPut2 },
+        TEST_MpscGet, TEST_MpscCountGet
+    };
+
+    TEST_ScenarioExplore(&scenario);
+}
+
+/* The exploration must have found points to preempt at */
+static void TEST_RunsExplored( void )
+{
+    TEST_ASSERT(testRuns > 1000U);
+    printf("%u runs\n", (unsigned int)testRuns);
+}
+
+int main( void )
+{
+    TEST_RUN(TEST_SpscConsumerPreempted);
+    TEST_RUN(TEST_SpscProducerPreempted);
+    TEST_RUN(TEST_SpscConsumerInPut);
+    TEST_RUN(TEST_MpscProducersPreempted);
+    TEST_RUN(TEST_MpscConsumerInReservation);
+    TEST_RUN(TEST_MpscConsumerPreempted);
+    TEST_RUN(TEST_RunsExplored);
+
+    return TEST_Result();
+}
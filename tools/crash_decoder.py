@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+"""Decoder for the fault records of the fault capture service
+(src/config/default/system/fault).
+
+After a HardFault, an NMI or SYS_FAULT_Raise the firmware resets and prints
+the captured state on the console during the next boot:
+
+    FAULT reason 1 hardfault rcause 0x40
+    FAULT r0 00000000 r1 20000a10 r2 00000001 r3 00000000
+    FAULT r12 00000000 lr 00001a2b pc 00001a30 xpsr 61000000
+    FAULT sp 20007f88 exc_return fffffff9
+    FAULT stack 20007fa8: 00000000 00001c45 ...
+    FAULT end
+
+This tool reads such a console capture, takes the last complete record and
+symbolizes pc, lr and every stack word that looks like a return address
+against the ELF file that was programmed. Source lines are added when an
+addr2line of the toolchain (xc32-addr2line or arm-none-eabi-addr2line) is
+found.
+
+Usage:
+    python3 tools/crash_decoder.py cicd_project.X/dist/default/production/cicd_project.X.production.elf console.txt
+
+The capture defaults to stdin, so the port can be read directly:
+    stty -F /dev/ttyACM0 115200 raw -echo
+    python3 tools/crash_decoder.py firmware.elf < /dev/ttyACM0
+"""
+
+import argparse
+import re
+import shutil
+import struct
+import subprocess
+import sys
+
+REASONS = ("none", "hardfault", "nmi", "assert", "stack overflow", "malloc failed",
+           "task block")
+
+# PM->RCAUSE of the SAM D21
+RESET_CAUSES = ((0, "POR"), (1, "BOD12"), (2, "BOD33"), (4, "EXT"), (5, "WDT"), (6, "SYST"))
+
+RAM_START = 0x20000000
+RAM_END = 0x20008000
+
+SHT_SYMTAB = 2
+SHF_EXECINSTR = 0x4
+STT_FUNC = 2
+
+FIELD = re.compile(r"([a-z_0-9]+) ([0-9a-fA-F]+)")
+
+
+class Elf:
+    """Just enough of an ELF reader for the code sections and functions."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1:
+            raise ValueError("%s is not a 32-bit ELF file" % path)
+        end = "<" if self.data[5] == 1 else ">"
+        shoff, = struct.unpack_from(end + "I", self.data, 0x20)
+        shentsize, shnum, _ = struct.unpack_from(end + "HHH", self.data, 0x2E)
+        raw = [struct.unpack_from(end + "IIIIIIIIII", self.data, shoff + i * shentsize)
+               for i in range(shnum)]
+
+        self.code = [(addr, addr + size) for _, _, flags, addr, _, size, _, _, _, _ in raw
+                     if (flags & SHF_EXECINSTR) and size > 0]
+        self.functions = []
+        for _, stype, _, _, offset, size, link, _, _, entsize in raw:
+            if stype != SHT_SYMTAB:
+                continue
+            strtab = raw[link][4]
+            for pos in range(offset, offset + size, entsize):
+                name, value, symsize, info, _, _ = struct.unpack_from(end + "IIIBBH", self.data, pos)
+                if (info & 0xF) == STT_FUNC and name != 0:
+                    start = strtab + name
+                    label = self.data[start:self.data.index(b"\0", start)].decode()
+                    self.functions.append((value & ~1, max(symsize, 2), label))
+        self.functions.sort()
+
+    def is_code(self, address):
+        return any(start <= address < stop for start, stop in self.code)
+
+    def symbol(self, address):
+        """Returns "function+offset" for a code address, or None."""
+        for start, size, label in self.functions:
+            if start <= address < start + size:
+                return "%s+0x%x" % (label, address - start)
+        return None
+
+
+def read_record(lines):
+    """Returns the fields of the last complete record in the capture."""
+    record = None
+    last = None
+    for line in lines:
+        at = line.find("FAULT ")
+        if at < 0:
+            continue
+        text = line[at + 6:].strip()
+        if text.startswith("reason "):
+            parts = text.split()
+            record = {"reason": int(parts[1]), "stack": [], "stack_at": None}
+            match = re.search(r"rcause 0x([0-9a-fA-F]+)", text)
+            record["rcause"] = int(match.group(1), 16) if match else None
+        elif record is None:
+            continue
+        elif text.startswith("stack "):
+            address, _, words = text[6:].partition(":")
+            if record["stack_at"] is None:
+                record["stack_at"] = int(address, 16)
+            record["stack"].extend(int(word, 16) for word in words.split())
+        elif text == "end":
+            last = record
+            record = None
+        else:
+            for name, value in FIELD.findall(text):
+                record[name] = int(value, 16)
+    return last
+
+
+class Symbolizer:
+    """Symbols from the ELF file plus source lines from addr2line."""
+
+    def __init__(self, elf, elf_path, addr2line):
+        self.elf = elf
+        self.elf_path = elf_path
+        self.addr2line = addr2line
+        self.lines = {}
+
+    def resolve(self, addresses):
+        if self.addr2line is None or not addresses:
+            return
+        try:
+            output = subprocess.run([self.addr2line, "-e", self.elf_path] + ["0x%x" % a for a in addresses],
+                                    capture_output=True, text=True, check=True).stdout.splitlines()
+        except (OSError, subprocess.CalledProcessError):
+            return
+        for address, line in zip(addresses, output):
+            if not line.startswith("??"):
+                self.lines[address] = line
+
+    def describe(self, address):
+        name = self.elf.symbol(address)
+        if name is None:
+            return "?"
+        line = self.lines.get(address)
+        return name if line is None else "%s (%s)" % (name, line)
+
+
+def find_addr2line(explicit):
+    if explicit:
+        return explicit
+    for name in ("xc32-addr2line", "arm-none-eabi-addr2line"):
+        path = shutil.which(name)
+        if path:
+            return path
+    return None
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Symbolizes a fault record against the ELF file.")
+    parser.add_argument("elf", help="ELF file that was programmed")
+    parser.add_argument("capture", nargs="?", help="console capture (default: stdin)")
+    parser.add_argument("--addr2line", help="addr2line of the toolchain (default: search PATH)")
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    if args.capture:
+        with open(args.capture, errors="replace") as f:
+            record = read_record(f)
+    else:
+        record = read_record(sys.stdin)
+    if record is None:
+        print("no complete FAULT record found", file=sys.stderr)
+        return 1
+
+    pc = record.get("pc", 0)
+    lr = record.get("lr", 0)
+    xpsr = record.get("xpsr", 0)
+    sp = record.get("sp", 0)
+    exc_return = record.get("exc_return", 0)
+    stack_at = record["stack_at"]
+
+    # Return addresses are odd (Thumb); their call instruction ends 2 bytes earlier
+    calls = []
+    for index, word in enumerate(record["stack"]):
+        if (word & 1) and elf.is_code(word & ~1):
+            calls.append((stack_at + 4 * index, word))
+
+    symbolizer = Symbolizer(elf, args.elf, find_addr2line(args.addr2line))
+    symbolizer.resolve([pc & ~1, (lr & ~1) - 2] + [(word & ~1) - 2 for _, word in calls])
+
+    reason = record["reason"]
+    print("reason:      %s" % (REASONS[reason] if reason < len(REASONS) else "unknown (%d)" % reason))
+    if record["rcause"] is not None:
+        causes = [name for bit, name in RESET_CAUSES if record["rcause"] & (1 << bit)]
+        print("reset cause: 0x%02x %s" % (record["rcause"], " ".join(causes)))
+
+    if not RAM_START <= sp < RAM_END:
+        print("sp:          0x%08x is outside SRAM: stack overflow or a corrupted stack pointer" % sp)
+        print("             no registers were captured")
+        return 0
+
+    print("pc:          0x%08x %s" % (pc, symbolizer.describe(pc & ~1)))
+    print("lr:          0x%08x %s" % (lr, symbolizer.describe((lr & ~1) - 2) if elf.is_code(lr & ~1) else ""))
+    print("r0-r3:       %08x %08x %08x %08x" % tuple(record.get(r, 0) for r in ("r0", "r1", "r2", "r3")))
+    print("r12:         %08x" % record.get("r12", 0))
+    print("xpsr:        0x%08x, exception %d" % (xpsr, xpsr & 0x3F))
+
+    # The frame is 8 words, plus one of padding when the core had to align sp
+    original_sp = sp + 32 + (4 if xpsr & (1 << 9) else 0)
+    print("sp:          0x%08x on the %s stack, 0x%08x before the fault"
+          % (sp, "process" if exc_return & 0x4 else "main", original_sp))
+
+    if not xpsr & (1 << 24):
+        print("hint:        Thumb bit clear: branch to an even address, e.g. a bad function pointer")
+    if not elf.is_code(pc & ~1):
+        print("hint:        pc is not in code: bad function pointer or corrupted return address")
+    if pc & 1:
+        print("hint:        odd pc: the stacked pc is corrupted")
+
+    print("\nreturn addresses on the stack (innermost first):")
+    if not calls:
+        print("  none found")
+    for address, word in calls:
+        print("  [0x%08x] 0x%08x %s" % (address, word, symbolizer.describe((word & ~1) - 2)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""Decoder for the deferred binary log (src/config/default/system/log).
+
+The firmware sends records of little-endian 32-bit words:
+
+    header      bits 0-7 sync (0xA5), 8-15 argument count, 16-23 level,
+                24-31 records dropped before this one
+    format ID   address of the format string in the .logstr section
+    timestamp   low 32 bits of SYS_TIME_Now() (CPU cycles), or a sequence
+                number when the firmware has no timebase
+    arguments
+
+The format strings are read from the .logstr section of the ELF file that was
+programmed. Bytes that do not form a valid record (plain stdio output on the
+same port) are passed through unchanged.
+
+Usage:
+    stty -F /dev/ttyACM0 115200 raw -echo
+    python3 tools/log_decoder.py cicd_project.X/dist/default/production/cicd_project.X.production.elf /dev/ttyACM0
+
+The input defaults to stdin, so a captured stream can also be piped in. With
+--clock the cycle timestamps are extended past their 32-bit wrap and printed
+in seconds; records must then arrive more often than once per wrap (~89 s at
+48 MHz).
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SYNC = 0xA5
+HEADER_WORDS = 3
+MAX_ARGS = 8
+LEVELS = ("FATAL", "ERROR", "WARN", "INFO", "DEBUG")
+
+SHT_PROGBITS = 1
+SHF_ALLOC = 0x2
+
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|j|z|t|L)?([diouxXcspn%])")
+
+
+class Elf:
+    """Just enough of an ELF reader to find sections by name and address."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError("%s is not an ELF file" % path)
+        is64 = self.data[4] == 2
+        end = "<" if self.data[5] == 1 else ">"
+        if is64:
+            shoff, = struct.unpack_from(end + "Q", self.data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from(end + "HHH", self.data, 0x3A)
+            fmt = end + "IIQQQQIIQQ"
+        else:
+            shoff, = struct.unpack_from(end + "I", self.data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from(end + "HHH", self.data, 0x2E)
+            fmt = end + "IIIIIIIIII"
+        raw = [struct.unpack_from(fmt, self.data, shoff + i * shentsize) for i in range(shnum)]
+        names = raw[shstrndx]
+        self.sections = []
+        for name, stype, flags, addr, offset, size, _, _, _, _ in raw:
+            start = names[4] + name
+            label = self.data[start:self.data.index(b"\0", start)].decode()
+            self.sections.append((label, stype, flags, addr, self.data[offset:offset + size]))
+
+    def section(self, name):
+        for label, _, _, addr, body in self.sections:
+            if label == name:
+                return addr, body
+        raise KeyError("section %s not found" % name)
+
+    def string_at(self, address):
+        """Returns the C string at a loaded address, or None."""
+        for _, stype, flags, addr, body in self.sections:
+            if stype == SHT_PROGBITS and (flags & SHF_ALLOC) and addr <= address < addr + len(body):
+                start = address - addr
+                stop = body.find(b"\0", start)
+                if stop >= 0:
+                    return body[start:stop].decode("latin-1")
+        return None
+
+
+class Decoder:
+    def __init__(self, elf, clock=None):
+        self.elf = elf
+        self.base, self.strings = elf.section(".logstr")
+        self.pending = bytearray()
+        self.clock = clock
+        self.last = None
+        self.wraps = 0
+
+    def stamp(self, timestamp):
+        if not self.clock:
+            return "%10u" % timestamp
+        if self.last is not None and timestamp < self.last:
+            self.wraps += 1
+        self.last = timestamp
+        return "%12.6f" % (((self.wraps << 32) + timestamp) / self.clock)
+
+    def format_id_valid(self, fmt_id):
+        offset = fmt_id - self.base
+        return (0 <= offset < len(self.strings)) and (offset == 0 or self.strings[offset - 1] == 0)
+
+    def render(self, fmt_id, args):
+        offset = fmt_id - self.base
+        text = self.strings[offset:self.strings.index(b"\0", offset)].decode("latin-1")
+        words = iter(args)
+
+        def next_word():
+            return next(words, 0)
+
+        def convert(match):
+            flags, width, precision, _, kind = match.groups()
+            if kind == "%":
+                return "%"
+            if kind == "n":
+                return ""
+            if width == "*":
+                width = str(to_signed(next_word()))
+            if precision == "*":
+                precision = str(to_signed(next_word()))
+            spec = "%" + flags + (width or "") + ("." + precision if precision is not None else "")
+            value = next_word()
+            if kind in "di":
+                return (spec + "d") % to_signed(value)
+            if kind in "uoxX":
+                return (spec + kind.replace("u", "d")) % value
+            if kind == "c":
+                return (spec + "c") % chr(value & 0xFF)
+            if kind == "p":
+                return (spec + "s") % ("0x%08x" % value)
+            string = self.elf.string_at(value)
+            return (spec + "s") % (string if string is not None else "<0x%08x>" % value)
+
+        return CONVERSION.sub(convert, text)
+
+    def feed(self, data, out):
+        self.pending += data
+        buf = self.pending
+        passthrough = bytearray()
+        while buf:
+            if buf[0] != SYNC:
+                passthrough.append(buf.pop(0))
+                continue
+            if len(buf) < HEADER_WORDS * 4:
+                break
+            header, fmt_id, timestamp = struct.unpack_from("<III", buf)
+            nargs = (header >> 8) & 0xFF
+            level = (header >> 16) & 0xFF
+            dropped = header >> 24
+            if nargs > MAX_ARGS or level >= len(LEVELS) or not self.format_id_valid(fmt_id):
+                passthrough.append(buf.pop(0))
+                continue
+            size = (HEADER_WORDS + nargs) * 4
+            if len(buf) < size:
+                break
+            args = struct.unpack_from("<%dI" % nargs, buf, HEADER_WORDS * 4)
+            del buf[:size]
+            out.write(passthrough.decode("latin-1"))
+            passthrough.clear()
+            if dropped:
+                out.write("[log] %d record(s) dropped\n" % dropped)
+            text = self.render(fmt_id, args).rstrip("\r\n")
+            out.write("[%s] %-5s %s\n" % (self.stamp(timestamp), LEVELS[level], text))
+        out.write(passthrough.decode("latin-1"))
+        out.flush()
+
+
+def to_signed(value):
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="ELF file of the running firmware")
+    parser.add_argument("input", nargs="?", help="serial device or capture file (default: stdin)")
+    parser.add_argument("--clock", type=int, metavar="HZ", help="timestamp clock, e.g. 48000000, to print seconds")
+    options = parser.parse_args()
+
+    decoder = Decoder(Elf(options.elf), options.clock)
+    stream = open(options.input, "rb", buffering=0) if options.input else sys.stdin.buffer
+    try:
+        while True:
+            data = stream.read1(256) if hasattr(stream, "read1") else stream.read(256)
+            if not data:
+                break
+            decoder.feed(data, sys.stdout)
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
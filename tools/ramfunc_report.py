@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""RAM cost of the RAMFUNC functions (toolchain_specifics.h).
+
+A RAMFUNC function is linked to run from SRAM and copied there from flash by
+the start-up code, so its size is paid twice. This lists every function symbol
+of the ELF file that lies in SRAM, with its size, and the total of the
+.ramfunc sections including alignment padding.
+
+A RAMFUNC function that calls back into flash pays the flash wait states for
+the callee, so the report also decodes each SRAM function and warns about
+every Thumb BL that lands in flash or on a linker veneer to flash, and every
+literal pool word holding the address of a flash function (the long_call
+form, LDR then BLX). Helpers meant to run in SRAM should then be
+__STATIC_FORCEINLINE or RAMFUNC.
+
+Usage:
+    python3 tools/ramfunc_report.py cicd_project.X/dist/default/production/cicd_project.X.production.elf
+
+It runs as the post-build step of the MPLAB X project. A .hex path is replaced
+by the .elf file next to it. With --budget the exit status is 1 when the
+sections take more bytes than that, and with --strict when SRAM code calls
+into flash.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+RAM_START = 0x20000000
+RAM_END = 0x20008000
+
+SHT_PROGBITS = 1
+SHT_SYMTAB = 2
+STT_FUNC = 2
+
+VENEER = re.compile(r"^__(.+)_veneer$")
+
+
+class Elf:
+    """Just enough of an ELF reader for the section headers and symbols."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1:
+            raise ValueError("%s is not a 32-bit ELF file" % path)
+        self.end = "<" if self.data[5] == 1 else ">"
+        shoff, = struct.unpack_from(self.end + "I", self.data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(self.end + "HHH", self.data, 0x2E)
+        raw = [struct.unpack_from(self.end + "IIIIIIIIII", self.data, shoff + i * shentsize)
+               for i in range(shnum)]
+        names = raw[shstrndx]
+        self.sections = []
+        for name, stype, flags, addr, offset, size, link, _, _, entsize in raw:
+            label = self.string(names[4], name)
+            self.sections.append((label, stype, addr, offset, size, link, entsize))
+
+    def string(self, table_offset, index):
+        start = table_offset + index
+        return self.data[start:self.data.index(b"\0", start)].decode()
+
+    def symbols(self):
+        """Yields (name, value, size, type) of every symbol."""
+        for _, stype, _, offset, size, link, entsize in self.sections:
+            if stype != SHT_SYMTAB:
+                continue
+            strtab = self.sections[link][3]
+            for pos in range(offset, offset + size, entsize):
+                name, value, symsize, info, _, _ = struct.unpack_from(self.end + "IIIBBH", self.data, pos)
+                yield self.string(strtab, name), value, symsize, info & 0xF
+
+    def functions(self):
+        """Yields (name, address, size) of every function symbol."""
+        for name, value, size, stype in self.symbols():
+            if stype == STT_FUNC:
+                yield name, value & ~1, size
+
+    def read(self, addr, size):
+        """Contents of the loaded bytes at addr, or None outside PROGBITS."""
+        for _, stype, start, offset, length, _, _ in self.sections:
+            if stype == SHT_PROGBITS and start <= addr and addr + size <= start + length:
+                return self.data[offset + addr - start:offset + addr - start + size]
+        return None
+
+
+def bl_target(pc, hw1, hw2):
+    """Destination of the Thumb BL made of hw1 and hw2 at pc, or None."""
+    if (hw1 & 0xF800) != 0xF000 or (hw2 & 0xD000) != 0xD000:
+        return None
+    s = (hw1 >> 10) & 1
+    i1 = 1 - (((hw2 >> 13) & 1) ^ s)
+    i2 = 1 - (((hw2 >> 11) & 1) ^ s)
+    offset = (s << 24) | (i1 << 23) | (i2 << 22) | ((hw1 & 0x3FF) << 12) | ((hw2 & 0x7FF) << 1)
+    if s:
+        offset -= 1 << 25
+    return (pc + 4 + offset) & 0xFFFFFFFF
+
+
+def flash_calls(elf, functions):
+    """Yields (caller, callee) for every reference from SRAM code to flash code."""
+    names = {}
+    for name, value, _, _ in elf.symbols():
+        if name and not name.startswith("$"):
+            names.setdefault(value & ~1, name)
+    flash = dict((addr, name) for name, addr, _ in elf.functions()
+                 if not RAM_START <= addr < RAM_END)
+
+    for size, caller, addr in functions:
+        body = elf.read(addr, size)
+        if body is None:
+            continue
+        found = []
+        half = [struct.unpack_from(elf.end + "H", body, i)[0] for i in range(0, size - 1, 2)]
+        i = 0
+        while i < len(half) - 1:
+            target = bl_target(addr + 2 * i, half[i], half[i + 1])
+            i += 1
+            if target is None:
+                continue
+            i += 1
+            veneer = VENEER.match(names.get(target, ""))
+            if veneer:
+                found.append(veneer.group(1))
+            elif not RAM_START <= target < RAM_END:
+                found.append(flash.get(target, "0x%08X" % target))
+        for i in range(0, size - 3, 4):
+            word, = struct.unpack_from(elf.end + "I", body, i)
+            if (word & 1) and (word & ~1) in flash:
+                found.append(flash[word & ~1])
+        for callee in sorted(set(found)):
+            yield caller, callee
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("elf", help="linked image (.elf, or the .hex next to it)")
+    parser.add_argument("--budget", type=int, help="maximum bytes of SRAM code")
+    parser.add_argument("--strict", action="store_true", help="fail when SRAM code calls into flash")
+    args = parser.parse_args()
+
+    path = args.elf
+    if path.endswith(".hex"):
+        path = os.path.splitext(path)[0] + ".elf"
+    elf = Elf(path)
+
+    functions = sorted((size, name, addr) for name, addr, size in elf.functions()
+                       if RAM_START <= addr < RAM_END)
+    sections = sum(size for label, _, addr, _, size, _, _ in elf.sections
+                   if label.startswith(".ramfunc") and RAM_START <= addr < RAM_END)
+
+    print("RAMFUNC code in SRAM:")
+    for size, name, addr in reversed(functions):
+        print("  0x%08X %6d  %s" % (addr, size, name))
+    print("  %d functions, %d bytes; .ramfunc sections %d bytes of SRAM and flash"
+          % (len(functions), sum(f[0] for f in functions), sections))
+
+    calls = list(flash_calls(elf, functions))
+    for caller, callee in calls:
+        print("warning: %s in SRAM calls %s in flash" % (caller, callee), file=sys.stderr)
+
+    status = 0
+    if args.budget is not None and sections > args.budget:
+        print("error: SRAM code exceeds the budget of %d bytes" % args.budget, file=sys.stderr)
+        status = 1
+    if args.strict and calls:
+        status = 1
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())